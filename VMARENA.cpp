@@ -0,0 +1,406 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMA  VMARENA Frame arena
+//
+//Generated file:        VMARENA.CPP
+//
+//Module identification letters: VMA
+//Module identification number:  456
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMARENA.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+   #include  <stdint.h>
+   #include  <unistd.h>
+   #include  <sys/mman.h>
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMARENA.hpp"
+
+   #include "global.hpp"
+
+   #include "str_vmc.inc"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VMA Overflow control size
+
+   static const int PROTECTION_SIZE = 4 ;
+
+// VMA Page value buffer underflow protection constant
+
+   static const char BEFORE[ ] = "\0\xF6\x3F\xF3" ;
+
+// VMA Page value buffer overflow protection constant
+
+   static const char AFTER[ ] = "\xF6\x3F\xF3\0" ;
+
+// VMA Alignment of page value buffers
+//    Suits direct I/O and is a multiple of the cache line size.
+
+   static const size_t ARENA_ALIGNMENT = 4096 ;
+
+// VMA Huge page size
+
+   static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024 ;
+
+// VMA Names of the kinds of arena pages, indexed by VMC_tpArenaPages
+
+   static const char * const ARENA_PAGE_NAMES[ ] =
+             { "base" , "transparent huge" , "huge" } ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMA  Frame arena
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMA  Frame arena
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Frame arena constructor
+
+   VMC_FrameArena ::
+             VMC_FrameArena( )
+   {
+
+      pMapping     = NULL ;
+      sizeMapping  = 0 ;
+      pFirstBuffer   = NULL ;
+      bufferStride   = 0 ;
+      sizeBuffer     = 0 ;
+      numFrames      = 0 ;
+      sizeSystemPage = ARENA_ALIGNMENT ;
+      arenaPages     = VMC_ARENA_BASE_PAGES ;
+      isGuarded      = false ;
+      hasFrameControls = false ;
+
+   } // End of function: VMA $Frame arena constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Frame arena destructor
+
+   VMC_FrameArena ::
+             ~VMC_FrameArena( )
+   {
+
+      Unmap( ) ;
+
+   } // End of function: VMA $Frame arena destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Map arena
+//    The guard areas span at least one page of the system, hence they
+//    may later be protected without touching the buffers.
+
+   bool VMC_FrameArena ::
+             Map( int numFramesParm , int sizeBufferParm ,
+                  VMC_tpArenaPages arenaPagesParm )
+   {
+
+      Unmap( ) ;
+
+      if ( numFramesParm <= 0 )
+      {
+         return false ;
+      } /* if */
+
+      // Compute the arena layout
+
+         long sizePage = sysconf( _SC_PAGESIZE ) ;
+         sizeSystemPage = ( sizePage > 0 ) ? ( size_t ) sizePage : ARENA_ALIGNMENT ;
+
+         size_t sizeGuard = ARENA_ALIGNMENT ;
+         if ( sizeSystemPage > sizeGuard )
+         {
+            sizeGuard = sizeSystemPage ;
+         } /* if */
+
+      // Leave room for the controls
+      //    Buffers are contiguous when their size is a multiple of
+      //    ARENA_ALIGNMENT. Otherwise the room left after each buffer
+      //    holds its overflow control and the underflow control of the
+      //    next one, if it is large enough. The first buffer is preceded
+      //    and the last one followed by room for the arena controls.
+
+         size_t sizeControl = 0 ;
+      #ifndef VMC_RELEASE
+         sizeControl = ARENA_ALIGNMENT ;
+      #endif
+
+         sizeBuffer   = sizeBufferParm ;
+         bufferStride = (( size_t ) sizeBuffer + ARENA_ALIGNMENT - 1 )
+                        & ~( ARENA_ALIGNMENT - 1 ) ;
+
+         hasFrameControls = false ;
+      #ifndef VMC_RELEASE
+         hasFrameControls = ( bufferStride - sizeBuffer >= 2 * PROTECTION_SIZE ) ;
+      #endif
+
+         size_t sizeArena = 2 * sizeGuard + 2 * sizeControl +
+                            bufferStride * ( size_t ) numFramesParm ;
+         size_t sizeHuge  = ( sizeArena + HUGE_PAGE_SIZE - 1 ) & ~( HUGE_PAGE_SIZE - 1 ) ;
+
+      // Map explicit huge pages
+
+         if ( arenaPagesParm == VMC_ARENA_HUGE_PAGES )
+         {
+         #ifdef MAP_HUGETLB
+            void * pMap = mmap( NULL , sizeHuge , PROT_READ | PROT_WRITE ,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB , -1 , 0 ) ;
+            if ( pMap != MAP_FAILED )
+            {
+               pMapping    = static_cast< char * >( pMap ) ;
+               sizeMapping = sizeHuge ;
+               arenaPages  = VMC_ARENA_HUGE_PAGES ;
+            } /* if */
+         #endif
+
+            if ( pMapping == NULL )
+            {
+               arenaPagesParm = VMC_ARENA_TRANSPARENT_HUGE_PAGES ;
+            } /* if */
+         } // end selection: Map explicit huge pages
+
+      // Map transparent huge pages
+      //    One huge page more is mapped, the unaligned ends are released.
+
+         if ( arenaPagesParm == VMC_ARENA_TRANSPARENT_HUGE_PAGES )
+         {
+            void * pMap = mmap( NULL , sizeHuge + HUGE_PAGE_SIZE , PROT_READ | PROT_WRITE ,
+                                MAP_PRIVATE | MAP_ANONYMOUS , -1 , 0 ) ;
+            if ( pMap == MAP_FAILED )
+            {
+               return false ;
+            } /* if */
+
+            char * pStart   = static_cast< char * >( pMap ) ;
+            char * pAligned = reinterpret_cast< char * >(
+                      ( reinterpret_cast< uintptr_t >( pStart ) + HUGE_PAGE_SIZE - 1 )
+                      & ~( uintptr_t )( HUGE_PAGE_SIZE - 1 )) ;
+
+            if ( pAligned > pStart )
+            {
+               munmap( pStart , pAligned - pStart ) ;
+            } /* if */
+
+            size_t sizeTail = ( pStart + HUGE_PAGE_SIZE ) - pAligned ;
+            if ( sizeTail > 0 )
+            {
+               munmap( pAligned + sizeHuge , sizeTail ) ;
+            } /* if */
+
+            pMapping    = pAligned ;
+            sizeMapping = sizeHuge ;
+            arenaPages  = VMC_ARENA_BASE_PAGES ;
+
+         #ifdef MADV_HUGEPAGE
+            if ( madvise( pMapping , sizeMapping , MADV_HUGEPAGE ) == 0 )
+            {
+               arenaPages = VMC_ARENA_TRANSPARENT_HUGE_PAGES ;
+            } /* if */
+         #endif
+         } // end selection: Map transparent huge pages
+
+      // Map base pages
+
+         if ( pMapping == NULL )
+         {
+            void * pMap = mmap( NULL , sizeArena , PROT_READ | PROT_WRITE ,
+                                MAP_PRIVATE | MAP_ANONYMOUS , -1 , 0 ) ;
+            if ( pMap == MAP_FAILED )
+            {
+               return false ;
+            } /* if */
+
+            pMapping    = static_cast< char * >( pMap ) ;
+            sizeMapping = sizeArena ;
+            arenaPages  = VMC_ARENA_BASE_PAGES ;
+         } // end selection: Map base pages
+
+         numFrames    = numFramesParm ;
+         pFirstBuffer = pMapping + sizeGuard + sizeControl ;
+
+      // Protect the guard areas
+      //    The guard after the buffers starts at the first system page
+      //    boundary past the room for the arena control.
+
+      #ifdef VMC_HARDENED
+         {
+            char * pGuardAfter = reinterpret_cast< char * >(
+                      ( reinterpret_cast< uintptr_t >( pFirstBuffer +
+                                bufferStride * ( size_t ) numFrames + sizeControl )
+                        + sizeSystemPage - 1 ) & ~( uintptr_t )( sizeSystemPage - 1 )) ;
+
+            isGuarded = ( pGuardAfter + sizeSystemPage <= pMapping + sizeMapping )
+                     && ( mprotect( pMapping , sizeGuard , PROT_NONE ) == 0 )
+                     && ( mprotect( pGuardAfter , sizeSystemPage , PROT_NONE ) == 0 ) ;
+         }
+      #endif
+
+      // Set the arena controls
+      //    Only the pages around the ends of the arena are touched, the
+      //    controls of each buffer are set when its frame is constructed.
+
+      #ifndef VMC_RELEASE
+         memcpy( pFirstBuffer - PROTECTION_SIZE , BEFORE , PROTECTION_SIZE ) ;
+         memcpy( GetPageBuffer( numFrames - 1 ) + sizeBuffer , AFTER , PROTECTION_SIZE ) ;
+      #endif
+
+      return true ;
+
+   } // End of function: VMA $Map arena
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Get page value buffer of a frame
+
+   char * VMC_FrameArena ::
+             GetPageBuffer( int inxFrame )
+   {
+
+      return pFirstBuffer + bufferStride * ( size_t ) inxFrame ;
+
+   } // End of function: VMA $Get page value buffer of a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Set buffer controls
+
+   void VMC_FrameArena ::
+             SetBufferControls( int inxFrame )
+   {
+
+      if ( hasFrameControls )
+      {
+         char * pBuffer = GetPageBuffer( inxFrame ) ;
+         memcpy( pBuffer - PROTECTION_SIZE , BEFORE , PROTECTION_SIZE ) ;
+         memcpy( pBuffer + sizeBuffer , AFTER , PROTECTION_SIZE ) ;
+      } /* if */
+
+   } // End of function: VMA $Set buffer controls
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Verify underflow control
+
+   bool VMC_FrameArena ::
+             IsUnderflowControlIntact( int inxFrame )
+   {
+
+   #ifndef VMC_RELEASE
+      if ( hasFrameControls
+        || ( inxFrame == 0 ))
+      {
+         return memcmp( GetPageBuffer( inxFrame ) - PROTECTION_SIZE ,
+                        BEFORE , PROTECTION_SIZE ) == 0 ;
+      } /* if */
+   #endif
+
+      return true ;
+
+   } // End of function: VMA $Verify underflow control
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Verify overflow control
+
+   bool VMC_FrameArena ::
+             IsOverflowControlIntact( int inxFrame )
+   {
+
+   #ifndef VMC_RELEASE
+      if ( hasFrameControls
+        || ( inxFrame == numFrames - 1 ))
+      {
+         return memcmp( GetPageBuffer( inxFrame ) + sizeBuffer ,
+                        AFTER , PROTECTION_SIZE ) == 0 ;
+      } /* if */
+   #endif
+
+      return true ;
+
+   } // End of function: VMA $Verify overflow control
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Release page value buffer
+//    Only whole system pages within the sizeBuffer bytes of the buffer
+//    are released, hence the overflow control is never touched.
+//    Explicit huge pages cannot be released piecewise, the advice is
+//    then refused and the memory stays in use.
+
+   void VMC_FrameArena ::
+             ReleaseBuffer( int inxFrame )
+   {
+
+      uintptr_t inxFirst = reinterpret_cast< uintptr_t >( GetPageBuffer( inxFrame )) ;
+      uintptr_t inxLimit = inxFirst + sizeBuffer ;
+
+      inxFirst = ( inxFirst + sizeSystemPage - 1 ) & ~( uintptr_t )( sizeSystemPage - 1 ) ;
+      inxLimit = inxLimit & ~( uintptr_t )( sizeSystemPage - 1 ) ;
+
+      if ( inxLimit > inxFirst )
+      {
+         madvise( reinterpret_cast< void * >( inxFirst ) , inxLimit - inxFirst ,
+                  MADV_DONTNEED ) ;
+      } /* if */
+
+   } // End of function: VMA $Release page value buffer
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Display arena statistics
+
+   void VMC_FrameArena ::
+             DisplayStatistics( LOG_Logger * pLogger )
+   {
+
+      char msg[ DIM_STAT_LINE ] ;
+      snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatArena ) ,
+              numFrames , ( int ) bufferStride , ( int )( sizeMapping / 1024 ) ,
+              ARENA_PAGE_NAMES[ arenaPages ] , isGuarded ? ", guarded" : "" ) ;
+      pLogger->Log( msg ) ;
+
+   } // End of function: VMA $Display arena statistics
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMA $Release the mapping
+
+   void VMC_FrameArena ::
+             Unmap( )
+   {
+
+      if ( pMapping != NULL )
+      {
+         munmap( pMapping , sizeMapping ) ;
+      } /* if */
+
+      pMapping     = NULL ;
+      sizeMapping  = 0 ;
+      pFirstBuffer = NULL ;
+      numFrames    = 0 ;
+      isGuarded    = false ;
+
+   } // End of function: VMA $Release the mapping
+
+//--- End of class: VMA  Frame arena
+
+////// End of implementation module: VMA  VMARENA Frame arena ////
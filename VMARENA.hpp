@@ -0,0 +1,158 @@
+#ifndef _VMARENA_
+   #define _VMARENA_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMA  VMARENA Frame arena
+//
+// Generated file:    VMARENA.HPP
+//
+// Module identification letters: VMA
+// Module identification number:  456
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMARENA.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Maps the page values of all frames in one anonymous mapping, on base
+//    or huge pages, and returns the memory of released frames to the
+//    system. Unless built with VMC_RELEASE every page value is surrounded
+//    by control patterns, which the page frames verify.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <stddef.h>
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMA  Frame arena
+//    Single anonymous mapping containing the page values of all frames.
+//    Page value buffers follow each other, each one starts at a multiple
+//    of ARENA_ALIGNMENT. If huge pages are used the mapping is aligned to
+//    HUGE_PAGE_SIZE.
+//    The first buffer is preceded and the last one followed by a guard
+//    area. Unless built with VMC_RELEASE the first buffer is preceded by
+//    an underflow control pattern and the last one followed by an
+//    overflow control pattern. Buffers whose size leaves room up to the
+//    next multiple of ARENA_ALIGNMENT are each surrounded by controls,
+//    set when the frame is constructed. VMF verifies the controls.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_FrameArena
+   {
+
+   //  Method: VMA $Frame arena constructor and destructor
+
+      public:
+         VMC_FrameArena( )  ;
+         ~VMC_FrameArena( )  ;
+
+   //  Method: VMA $Map arena
+   //    Maps the buffers of numFramesParm frames of sizeBufferParm bytes,
+   //    releasing the previous mapping if any. Explicit huge pages fall
+   //    back to transparent ones.
+   //    Returns false if the arena cannot be mapped.
+
+      public:
+         bool Map( int numFramesParm , int sizeBufferParm ,
+                   VMC_tpArenaPages arenaPagesParm )  ;
+
+   //  Method: VMA $Get page value buffer of a frame
+
+      public:
+         char * GetPageBuffer( int inxFrame )  ;
+
+   //  Method: VMA $Set buffer controls
+   //    Sets the controls surrounding the buffer of a frame being
+   //    constructed, if buffers have controls of their own.
+
+      public:
+         void SetBufferControls( int inxFrame )  ;
+
+   //  Method: VMA $Verify underflow control
+   //    Returns false if the control preceding the buffer has been
+   //    overwritten, true if it is intact or there is none.
+
+      public:
+         bool IsUnderflowControlIntact( int inxFrame )  ;
+
+   //  Method: VMA $Verify overflow control
+   //    Returns false if the control following the buffer has been
+   //    overwritten, true if it is intact or there is none.
+
+      public:
+         bool IsOverflowControlIntact( int inxFrame )  ;
+
+   //  Method: VMA $Release page value buffer
+   //    Returns the system pages contained in the buffer to the system.
+   //    Their contents are lost.
+
+      public:
+         void ReleaseBuffer( int inxFrame )  ;
+
+   //  Method: VMA $Display arena statistics
+
+      public:
+         void DisplayStatistics( LOG_Logger * pLogger )  ;
+
+   //  Method: VMA $Release the mapping
+
+      private:
+         void Unmap( )  ;
+
+   // VMA Mapping
+
+      private:
+         char * pMapping ;
+         size_t sizeMapping ;
+
+   // VMA Page value buffers
+
+      private:
+         char * pFirstBuffer ;
+         size_t bufferStride ;
+         int sizeBuffer ;
+         int numFrames ;
+
+   // VMA System page size
+
+      private:
+         size_t sizeSystemPage ;
+
+   // VMA Kind of pages actually backing the mapping
+
+      private:
+         VMC_tpArenaPages arenaPages ;
+
+   // VMA true if the guard areas are protected
+
+      private:
+         bool isGuarded ;
+
+   // VMA true if every buffer is surrounded by controls
+
+      private:
+         bool hasFrameControls ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMA  VMARENA Frame arena ////
@@ -0,0 +1,238 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMT  VMCLEAN Tail cleaner
+//
+//Generated file:        VMCLEAN.CPP
+//
+//Module identification letters: VMT
+//Module identification number:  461
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMCLEAN.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <limits.h>
+
+   #include  <chrono>
+
+   #include "VRTMEM.hpp"
+   #include "VMCLEAN.hpp"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VMT Tail cleaner period in milliseconds
+
+   static const int CLEANER_PERIOD_MS = 50 ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMT  Module lock while the tail cleaner runs
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMT  Module lock while the tail cleaner runs
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Cleaner lock constructor
+
+   VMC_CleanerLock ::
+             VMC_CleanerLock( )
+   {
+
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+
+      pLock = NULL ;
+      if ( pRoot != NULL )
+      {
+         pLock = pRoot->GetModuleLock( ) ;
+      } /* if */
+      if ( pLock != NULL )
+      {
+         pLock->lock( ) ;
+      } /* if */
+
+   } // End of function: VMT $Cleaner lock constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Cleaner lock destructor
+
+   VMC_CleanerLock ::
+             ~VMC_CleanerLock( )
+   {
+
+      Unlock( ) ;
+
+   } // End of function: VMT $Cleaner lock destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Release the lock before the end of the scope
+
+   void VMC_CleanerLock ::
+             Unlock( )
+   {
+
+      if ( pLock != NULL )
+      {
+         pLock->unlock( ) ;
+         pLock = NULL ;
+      } /* if */
+
+   } // End of function: VMT $Release the lock before the end of the scope
+
+//--- End of class: VMT  Module lock while the tail cleaner runs
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMT  Tail cleaner
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMT  Tail cleaner
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Tail cleaner constructor
+
+   VMC_TailCleaner ::
+             VMC_TailCleaner( int numScanFramesParm ,
+                              int lowWatermarkParm  ,
+                              int highWatermarkParm  )
+   {
+
+      numScanFrames   = numScanFramesParm ;
+      lowWatermark    = lowWatermarkParm ;
+      highWatermark   = highWatermarkParm ;
+
+      isWakeRequested = false ;
+      isStopping      = false ;
+
+      totalScans      = 0 ;
+      totalCleanings  = 0 ;
+      totalWrites     = 0 ;
+      totalFailures   = 0 ;
+
+      cleanerThread   = std::thread( &VMC_TailCleaner::CleanTail , this ) ;
+
+   } // End of function: VMT $Tail cleaner constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Tail cleaner destructor
+
+   VMC_TailCleaner ::
+             ~VMC_TailCleaner( )
+   {
+
+      {
+         std::lock_guard< std::mutex > wakeLock( wakeMutex ) ;
+         isStopping = true ;
+      }
+      wakeSignal.notify_all( ) ;
+
+      cleanerThread.join( ) ;
+
+   } // End of function: VMT $Tail cleaner destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Wake cleaner up
+
+   void VMC_TailCleaner ::
+             Wake( )
+   {
+
+      {
+         std::lock_guard< std::mutex > wakeLock( wakeMutex ) ;
+         isWakeRequested = true ;
+      }
+      wakeSignal.notify_one( ) ;
+
+   } // End of function: VMT $Wake cleaner up
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Get counters
+
+   void VMC_TailCleaner ::
+             GetCounters( int * pNumScans     ,
+                          int * pNumCleanings ,
+                          int * pNumWrites    ,
+                          int * pNumFailures   )
+   {
+
+      std::lock_guard< std::mutex > wakeLock( wakeMutex ) ;
+
+      *pNumScans     = totalScans ;
+      *pNumCleanings = totalCleanings ;
+      *pNumWrites    = totalWrites ;
+      *pNumFailures  = totalFailures ;
+
+   } // End of function: VMT $Get counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMT $Clean tail
+//    Sleeps one period or until woken up, then makes one pass.
+//    The wake up lock is not held during the pass, the root takes the
+//    module lock itself.
+
+   void VMC_TailCleaner ::
+             CleanTail( )
+   {
+
+      std::unique_lock< std::mutex > wakeLock( wakeMutex ) ;
+
+      for( ; ; )
+      {
+         if ( !isWakeRequested && !isStopping )
+         {
+            wakeSignal.wait_for( wakeLock ,
+                      std::chrono::milliseconds( CLEANER_PERIOD_MS )) ;
+         } /* if */
+
+         if ( isStopping )
+         {
+            break ;
+         } /* if */
+
+         isWakeRequested = false ;
+         wakeLock.unlock( ) ;
+
+         int numFailures = 0 ;
+         int numWritten  = VMC_VirtualMemoryRoot::GetRoot( )->CleanTailFrames(
+                   numScanFrames , lowWatermark , highWatermark , &numFailures ) ;
+
+         wakeLock.lock( ) ;
+
+         totalScans ++ ;
+         if ( ( numWritten > 0 )
+           || ( numFailures > 0 ))
+         {
+            totalCleanings ++ ;
+         } /* if */
+         totalWrites   += numWritten ;
+         totalFailures += numFailures ;
+      } /* for */
+
+   } // End of function: VMT $Clean tail
+
+//--- End of class: VMT  Tail cleaner
+
+////// End of implementation module: VMT  VMCLEAN Tail cleaner ////
@@ -0,0 +1,152 @@
+#ifndef _VMCLEAN_
+   #define _VMCLEAN_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMT  VMCLEAN Tail cleaner
+//
+// Generated file:    VMCLEAN.HPP
+//
+// Module identification letters: VMT
+// Module identification number:  461
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMCLEAN.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Writes the dirty frames near the tail of the replacement order from
+//    a cleaner thread, hence evictions find clean frames. The module lock
+//    guards the root and the frame states while the cleaner or the dirty
+//    flusher runs.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+   #include  <thread>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMT  Module lock while the tail cleaner runs
+//    Locks the module lock if the tail cleaner is running, otherwise
+//    does nothing. The lock is recursive, hence the operations guarded
+//    by it may call one another.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_CleanerLock
+   {
+
+   //  Method: VMT $Cleaner lock constructor and destructor
+
+      public:
+         VMC_CleanerLock( )  ;
+         ~VMC_CleanerLock( )  ;
+
+   //  Method: VMT $Release the lock before the end of the scope
+
+      public:
+         void Unlock( )  ;
+
+   // VMT Lock held, NULL if none
+
+      private:
+         std::recursive_mutex * pLock ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMT  Tail cleaner
+//    Owns the cleaner thread and its counters.
+//    The thread calls CleanTailFrames of the root, hence all frame
+//    handling is done by the root under the module lock.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_TailCleaner
+   {
+
+   //  Method: VMT $Tail cleaner constructor
+   //    Starts the cleaner thread
+
+      public:
+         VMC_TailCleaner( int numScanFramesParm ,
+                          int lowWatermarkParm  ,
+                          int highWatermarkParm  )  ;
+
+   //  Method: VMT $Tail cleaner destructor
+   //    Stops the cleaner thread
+
+      public:
+         ~VMC_TailCleaner( )  ;
+
+   //  Method: VMT $Wake cleaner up
+
+      public:
+         void Wake( )  ;
+
+   //  Method: VMT $Get counters
+
+      public:
+         void GetCounters( int * pNumScans     ,
+                           int * pNumCleanings ,
+                           int * pNumWrites    ,
+                           int * pNumFailures   )  ;
+
+   //  Method: VMT $Clean tail
+   //    Body of the cleaner thread
+
+      private:
+         void CleanTail( )  ;
+
+   // VMT Wake up lock and notification
+
+      private:
+         std::mutex wakeMutex ;
+         std::condition_variable wakeSignal ;
+         bool isWakeRequested ;
+         bool isStopping ;
+
+   // VMT Watermarks
+
+      private:
+         int numScanFrames ;
+         int lowWatermark ;
+         int highWatermark ;
+
+   // VMT Counters, guarded by wakeMutex
+
+      private:
+         int totalScans ;
+         int totalCleanings ;
+         int totalWrites ;
+         int totalFailures ;
+
+   // VMT Cleaner thread
+
+      private:
+         std::thread cleanerThread ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMT  VMCLEAN Tail cleaner ////
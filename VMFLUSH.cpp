@@ -0,0 +1,189 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMD  VMFLUSH Dirty flusher
+//
+//Generated file:        VMFLUSH.CPP
+//
+//Module identification letters: VMD
+//Module identification number:  462
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMFLUSH.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <limits.h>
+
+   #include  <chrono>
+
+   #include "VRTMEM.hpp"
+   #include "VMFLUSH.hpp"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VMD Dirty flusher period in milliseconds
+
+   static const int FLUSHER_PERIOD_MS = 100 ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMD  Dirty flusher
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMD  Dirty flusher
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMD $Dirty flusher constructor
+
+   VMC_DirtyFlusher ::
+             VMC_DirtyFlusher( int highWatermarkParm ,
+                               int lowWatermarkParm  ,
+                               int maxPagesPerSecondParm )
+   {
+
+      highWatermark     = highWatermarkParm ;
+      lowWatermark      = lowWatermarkParm ;
+      maxPagesPerSecond = maxPagesPerSecondParm ;
+      writeCredit       = 0 ;
+
+      isStopping        = false ;
+
+      totalPasses       = 0 ;
+      totalFlushes      = 0 ;
+      totalWrites       = 0 ;
+      totalFailures     = 0 ;
+
+      flusherThread     = std::thread( &VMC_DirtyFlusher::Flush , this ) ;
+
+   } // End of function: VMD $Dirty flusher constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMD $Dirty flusher destructor
+
+   VMC_DirtyFlusher ::
+             ~VMC_DirtyFlusher( )
+   {
+
+      {
+         std::lock_guard< std::mutex > stopLock( stopMutex ) ;
+         isStopping = true ;
+      }
+      stopSignal.notify_all( ) ;
+
+      flusherThread.join( ) ;
+
+   } // End of function: VMD $Dirty flusher destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMD $Get counters
+
+   void VMC_DirtyFlusher ::
+             GetCounters( int * pNumPasses   ,
+                          int * pNumFlushes  ,
+                          int * pNumWrites   ,
+                          int * pNumFailures  )
+   {
+
+      std::lock_guard< std::mutex > stopLock( stopMutex ) ;
+
+      *pNumPasses   = totalPasses ;
+      *pNumFlushes  = totalFlushes ;
+      *pNumWrites   = totalWrites ;
+      *pNumFailures = totalFailures ;
+
+   } // End of function: VMD $Get counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMD $Flush
+//    Sleeps one period, grants the write credit earned meanwhile and
+//    makes one pass. Once the high watermark has been passed, passes keep
+//    writing until the low watermark is reached, however many periods
+//    the rate limit requires.
+//    Failed writes spend credit as well, a failing segment is not retried
+//    faster than the rate limit.
+
+   void VMC_DirtyFlusher ::
+             Flush( )
+   {
+
+      std::unique_lock< std::mutex > stopLock( stopMutex ) ;
+
+      bool isFlushing = false ;
+
+      std::chrono::steady_clock::time_point lastPass =
+                std::chrono::steady_clock::now( ) ;
+
+      for( ; ; )
+      {
+         if ( !isStopping )
+         {
+            stopSignal.wait_for( stopLock ,
+                      std::chrono::milliseconds( FLUSHER_PERIOD_MS )) ;
+         } /* if */
+
+         if ( isStopping )
+         {
+            break ;
+         } /* if */
+
+         stopLock.unlock( ) ;
+
+         int maxPages = INT_MAX ;
+         if ( maxPagesPerSecond > 0 )
+         {
+            std::chrono::steady_clock::time_point now =
+                      std::chrono::steady_clock::now( ) ;
+            long long elapsedMs = std::chrono::duration_cast<
+                      std::chrono::milliseconds >( now - lastPass ).count( ) ;
+            lastPass = now ;
+
+            writeCredit += elapsedMs * maxPagesPerSecond ;
+            if ( writeCredit > 1000LL * maxPagesPerSecond )
+            {
+               writeCredit = 1000LL * maxPagesPerSecond ;
+            } /* if */
+            maxPages = static_cast< int >( writeCredit / 1000 ) ;
+         } /* if */
+
+         bool wasFlushing = isFlushing ;
+         int numFailures  = 0 ;
+         int numWritten   = VMC_VirtualMemoryRoot::GetRoot( )->FlushDirtyFrames(
+                   highWatermark , lowWatermark , maxPages ,
+                   &isFlushing , &numFailures ) ;
+
+         if ( maxPagesPerSecond > 0 )
+         {
+            writeCredit -= 1000LL * ( numWritten + numFailures ) ;
+         } /* if */
+
+         stopLock.lock( ) ;
+
+         totalPasses ++ ;
+         if ( !wasFlushing
+           && ( isFlushing || ( numWritten + numFailures > 0 )))
+         {
+            totalFlushes ++ ;
+         } /* if */
+         totalWrites   += numWritten ;
+         totalFailures += numFailures ;
+      } /* for */
+
+   } // End of function: VMD $Flush
+
+//--- End of class: VMD  Dirty flusher
+
+////// End of implementation module: VMD  VMFLUSH Dirty flusher ////
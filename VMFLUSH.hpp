@@ -0,0 +1,121 @@
+#ifndef _VMFLUSH_
+   #define _VMFLUSH_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMD  VMFLUSH Dirty flusher
+//
+// Generated file:    VMFLUSH.HPP
+//
+// Module identification letters: VMD
+// Module identification number:  462
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMFLUSH.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Writes the oldest dirty frames from a flusher thread once they exceed
+//    a high watermark, down to a low watermark, at a limited rate.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+   #include  <thread>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMD  Dirty flusher
+//    Owns the flusher thread, its rate limit and its counters.
+//    The thread calls FlushDirtyFrames of the root, hence all frame
+//    handling is done by the root under the module lock.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_DirtyFlusher
+   {
+
+   //  Method: VMD $Dirty flusher constructor
+   //    Starts the flusher thread
+
+      public:
+         VMC_DirtyFlusher( int highWatermarkParm ,
+                           int lowWatermarkParm  ,
+                           int maxPagesPerSecondParm )  ;
+
+   //  Method: VMD $Dirty flusher destructor
+   //    Stops the flusher thread
+
+      public:
+         ~VMC_DirtyFlusher( )  ;
+
+   //  Method: VMD $Get counters
+
+      public:
+         void GetCounters( int * pNumPasses   ,
+                           int * pNumFlushes  ,
+                           int * pNumWrites   ,
+                           int * pNumFailures  )  ;
+
+   //  Method: VMD $Flush
+   //    Body of the flusher thread
+
+      private:
+         void Flush( )  ;
+
+   // VMD Stop lock and notification
+
+      private:
+         std::mutex stopMutex ;
+         std::condition_variable stopSignal ;
+         bool isStopping ;
+
+   // VMD Watermarks, in percent of the frames
+
+      private:
+         int highWatermark ;
+         int lowWatermark ;
+
+   // VMD Rate limit
+   //    Pages that may be written per second, 0 if unlimited.
+   //    The credit grows by maxPagesPerSecond every millisecond, a page
+   //    costs 1000 units, at most one second of credit is kept.
+
+      private:
+         int maxPagesPerSecond ;
+         long long writeCredit ;
+
+   // VMD Counters, guarded by stopMutex
+
+      private:
+         int totalPasses ;
+         int totalFlushes ;
+         int totalWrites ;
+         int totalFailures ;
+
+   // VMD Flusher thread
+
+      private:
+         std::thread flusherThread ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMD  VMFLUSH Dirty flusher ////
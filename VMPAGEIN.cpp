@@ -0,0 +1,237 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMI  VMPAGEIN Page in queue
+//
+//Generated file:        VMPAGEIN.CPP
+//
+//Module identification letters: VMI
+//Module identification number:  460
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMPAGEIN.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMSEGRUN.hpp"
+   #include "VMPAGEIN.hpp"
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMI  Page in queue
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMI  Page in queue
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Page in queue constructor
+
+   VMC_PageInQueue ::
+             VMC_PageInQueue( int numThreadsParm , int maxFramesParm )
+   {
+
+      maxFrames     = maxFramesParm ;
+      vtRequest     = new VMC_ReadRequest[ maxFrames ] ;
+      vtQueuedFrame = new int[ maxFrames ] ;
+      inxFirst      = 0 ;
+      numQueued     = 0 ;
+      numInFlight   = 0 ;
+      isStopping    = false ;
+      totalReads    = 0 ;
+      maxInFlight   = 0 ;
+
+      for ( int inxFrame = 0 ; inxFrame < maxFrames ; inxFrame++ )
+      {
+         vtRequest[ inxFrame ].idSegment  = TAL_NullIdSeg ;
+         vtRequest[ inxFrame ].idPage     = TAL_NullIdPag ;
+         vtRequest[ inxFrame ].pPageValue = NULL ;
+         vtRequest[ inxFrame ].isDone     = false ;
+         vtRequest[ inxFrame ].pFailure   = NULL ;
+      } /* for */
+
+      numThreads     = numThreadsParm ;
+      vtReaderThread = new std::thread[ numThreads ] ;
+      for ( int inxThread = 0 ; inxThread < numThreads ; inxThread++ )
+      {
+         vtReaderThread[ inxThread ] = std::thread( &VMC_PageInQueue::ReadRequests , this ) ;
+      } /* for */
+
+   } // End of function: VMI $Page in queue constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Page in queue destructor
+
+   VMC_PageInQueue ::
+             ~VMC_PageInQueue( )
+   {
+
+      {
+         std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+         isStopping = true ;
+      }
+      requestQueued.notify_all( ) ;
+
+      for ( int inxThread = 0 ; inxThread < numThreads ; inxThread++ )
+      {
+         vtReaderThread[ inxThread ].join( ) ;
+      } /* for */
+
+      for ( int inxFrame = 0 ; inxFrame < maxFrames ; inxFrame++ )
+      {
+         delete vtRequest[ inxFrame ].pFailure ;
+      } /* for */
+
+      delete [ ] vtReaderThread ;
+      delete [ ] vtQueuedFrame ;
+      delete [ ] vtRequest ;
+
+   } // End of function: VMI $Page in queue destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Schedule read into a frame
+
+   void VMC_PageInQueue ::
+             ScheduleRead( int inxFrame , int idSeg , int idPag ,
+                           char * pPageValue )
+   {
+
+      {
+         std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+
+         VMC_ReadRequest * pRequest = &vtRequest[ inxFrame ] ;
+         pRequest->idSegment  = idSeg ;
+         pRequest->idPage     = idPag ;
+         pRequest->pPageValue = pPageValue ;
+         pRequest->isDone     = false ;
+         pRequest->pFailure   = NULL ;
+
+         vtQueuedFrame[ ( inxFirst + numQueued ) % maxFrames ] = inxFrame ;
+         numQueued ++ ;
+
+         numInFlight ++ ;
+         if ( numInFlight > maxInFlight )
+         {
+            maxInFlight = numInFlight ;
+         } /* if */
+         totalReads ++ ;
+      }
+
+      requestQueued.notify_one( ) ;
+
+   } // End of function: VMI $Schedule read into a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Wait for the read into a frame
+
+   EXC_Exception * VMC_PageInQueue ::
+             WaitRead( int inxFrame )
+   {
+
+      std::unique_lock< std::mutex > queueLock( queueMutex ) ;
+
+      VMC_ReadRequest * pRequest = &vtRequest[ inxFrame ] ;
+      while ( !pRequest->isDone )
+      {
+         readDone.wait( queueLock ) ;
+      } /* while */
+
+      EXC_Exception * pExc = pRequest->pFailure ;
+
+      pRequest->isDone   = false ;
+      pRequest->pFailure = NULL ;
+
+      return pExc ;
+
+   } // End of function: VMI $Wait for the read into a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Get counters
+
+   void VMC_PageInQueue ::
+             GetCounters( int * pNumThreads ,
+                          int * pNumReads   ,
+                          int * pMaxInFlight  )
+   {
+
+      std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+
+      *pNumThreads  = numThreads ;
+      *pNumReads    = totalReads ;
+      *pMaxInFlight = maxInFlight ;
+
+   } // End of function: VMI $Get counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMI $Read requests
+//    Segment I/O is serialized by segmentIoMutex, the threads overlap
+//    reads with the work of the thread using the virtual memory root.
+//    Reads of direct segments are done with the lock released, hence
+//    they also overlap each other.
+
+   void VMC_PageInQueue ::
+             ReadRequests( )
+   {
+
+      std::unique_lock< std::mutex > queueLock( queueMutex ) ;
+
+      for( ; ; )
+      {
+         while ( ( numQueued == 0 )
+              && ( !isStopping ))
+         {
+            requestQueued.wait( queueLock ) ;
+         } /* while */
+
+         if ( numQueued == 0 )
+         {
+            break ;
+         } /* if */
+
+         VMC_ReadRequest * pRequest = &vtRequest[ vtQueuedFrame[ inxFirst ]] ;
+         inxFirst = ( inxFirst + 1 ) % maxFrames ;
+         numQueued -- ;
+
+         queueLock.unlock( ) ;
+
+         EXC_Exception * pExc = NULL ;
+         try
+         {
+            std::unique_lock< std::mutex > ioLock( segmentIoMutex ) ;
+            VMC_VirtualMemoryRoot::GetRoot( )->GetSegmentPageRun( )->
+                      ReadRun( pRequest->idSegment , pRequest->idPage ,
+                               pRequest->pPageValue , ioLock ) ;
+         }
+         catch ( EXC_Exception * pCaught )
+         {
+            pExc = pCaught ;
+         } /* end catch */
+
+         queueLock.lock( ) ;
+
+         pRequest->pFailure = pExc ;
+         pRequest->isDone   = true ;
+         numInFlight -- ;
+
+         readDone.notify_all( ) ;
+
+      } /* for */
+
+   } // End of function: VMI $Read requests
+
+//--- End of class: VMI  Page in queue
+
+////// End of implementation module: VMI  VMPAGEIN Page in queue ////
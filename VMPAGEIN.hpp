@@ -0,0 +1,154 @@
+#ifndef _VMPAGEIN_
+   #define _VMPAGEIN_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMI  VMPAGEIN Page in queue
+//
+// Generated file:    VMPAGEIN.HPP
+//
+// Module identification letters: VMI
+// Module identification number:  460
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMPAGEIN.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Reads pages into frames from a pool of reader threads, hence page
+//    faults of several frames overlap.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+   #include  <thread>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+   #include "exceptn.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMI Read request
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_ReadRequest
+   {
+
+   // VMI Virtual address of the page and buffer receiving its value
+
+      int idSegment ;
+      int idPage ;
+      char * pPageValue ;
+
+   // VMI Completion of the read
+   //    pFailure is the exception thrown by a failed read.
+
+      bool isDone ;
+      EXC_Exception * pFailure ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMI  Page in queue
+//    Pool of reader threads reading pages into reserved frames.
+//    A frame has at most one read in flight, hence requests are kept in
+//    a vector indexed by the frame, and queued in a FIFO of frame
+//    indexes. The threads only read segment pages into page value
+//    buffers. Page frames are handled exclusively by the thread using
+//    the virtual memory root.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_PageInQueue
+   {
+
+   //  Method: VMI $Page in queue constructor
+   //    Starts the reader threads
+
+      public:
+         VMC_PageInQueue( int numThreadsParm , int maxFramesParm )  ;
+
+   //  Method: VMI $Page in queue destructor
+   //    Performs the queued reads and stops the reader threads.
+   //    Results not yet waited for are discarded.
+
+      public:
+         ~VMC_PageInQueue( )  ;
+
+   //  Method: VMI $Schedule read into a frame
+
+      public:
+         void ScheduleRead( int inxFrame , int idSeg , int idPag ,
+                            char * pPageValue )  ;
+
+   //  Method: VMI $Wait for the read into a frame
+   //    Returns the exception of a failed read, NULL otherwise.
+
+      public:
+         EXC_Exception * WaitRead( int inxFrame )  ;
+
+   //  Method: VMI $Get counters
+
+      public:
+         void GetCounters( int * pNumThreads ,
+                           int * pNumReads   ,
+                           int * pMaxInFlight  )  ;
+
+   //  Method: VMI $Read requests
+   //    Body of the reader threads
+
+      private:
+         void ReadRequests( )  ;
+
+   // VMI Queue lock, request and completion notifications
+
+      private:
+         std::mutex queueMutex ;
+         std::condition_variable requestQueued ;
+         std::condition_variable readDone ;
+
+   // VMI Requests indexed by frame, and circular FIFO of queued frames
+
+      private:
+         VMC_ReadRequest * vtRequest ;
+         int * vtQueuedFrame ;
+         int maxFrames ;
+         int inxFirst ;
+         int numQueued ;
+         int numInFlight ;
+
+   // VMI Reader threads
+
+      private:
+         bool isStopping ;
+         std::thread * vtReaderThread ;
+         int numThreads ;
+
+   // VMI Counters
+
+      private:
+         int totalReads ;
+         int maxInFlight ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMI  VMPAGEIN Page in queue ////
@@ -0,0 +1,1484 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMP  VMPOLICY Page replacement policies
+//
+//Generated file:        VMPOLICY.CPP
+//
+//Module identification letters: VMP
+//Module identification number:  457
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMPOLICY.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMPOLICY.hpp"
+
+   #include "exceptn.hpp"
+   #include "message.hpp"
+   #include "msgbin.hpp"
+   #include "global.hpp"
+
+   #include "str_vmc.inc"
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  Page replacement policy
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Public method implementations -----
+//==========================================================================
+
+// Class: VMP  Page replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Replacement policy constructor
+
+   VMC_ReplacementPolicy ::
+             VMC_ReplacementPolicy( )
+   {
+
+   } // End of function: VMP !Replacement policy constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Replacement policy destructor
+
+   VMC_ReplacementPolicy ::
+             ~VMC_ReplacementPolicy( )
+   {
+
+   } // End of function: VMP !Replacement policy destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !:Create built in replacement policy
+
+   VMC_ReplacementPolicy * VMC_ReplacementPolicy ::
+             CreatePolicy( VMC_tpReplacementPolicy policy )
+   {
+
+      switch ( policy )
+      {
+         case VMC_REPLACE_CLOCK :
+            return new VMC_ClockPolicy( ) ;
+
+         case VMC_REPLACE_2Q :
+            return new VMC_2QPolicy( ) ;
+
+         default :
+            return new VMC_LruPolicy( ) ;
+      } /* switch */
+
+   } // End of function: VMP !:Create built in replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Forget segment
+
+   void VMC_ReplacementPolicy ::
+             ForgetSegment( int )
+   {
+
+   } // End of function: VMP !Forget segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On pin
+
+   void VMC_ReplacementPolicy ::
+             OnPin( VMC_PageFrame * )
+   {
+
+   } // End of function: VMP !On pin
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On unpin
+
+   void VMC_ReplacementPolicy ::
+             OnUnpin( VMC_PageFrame * )
+   {
+
+   } // End of function: VMP !On unpin
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On prefetch
+
+   void VMC_ReplacementPolicy ::
+             OnPrefetch( VMC_PageFrame * pPageFrame )
+   {
+
+      OnInsert( pPageFrame ) ;
+
+   } // End of function: VMP !On prefetch
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Get victim candidates
+
+   int VMC_ReplacementPolicy ::
+             GetVictimCandidates( VMC_PageFrame ** , int )
+   {
+
+      return 0 ;
+
+   } // End of function: VMP !Get victim candidates
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Verify replacement policy
+
+   int VMC_ReplacementPolicy ::
+             VerifyPolicy( TAL_tpVerifyMode )
+   {
+
+      return 0 ;
+
+   } // End of function: VMP !Verify replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Display policy statistics
+
+   void VMC_ReplacementPolicy ::
+             DisplayStatistics( LOG_Logger * )
+   {
+
+   } // End of function: VMP !Display policy statistics
+
+//--- End of class: VMP  Page replacement policy
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  Frame index links
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMP  Frame index links
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Frame links constructor and destructor
+
+   VMC_FrameLinks ::
+             VMC_FrameLinks( )
+   {
+
+      numFrames = 0 ;
+      vtPrev    = NULL ;
+      vtNext    = NULL ;
+      vtList    = NULL ;
+
+   } // End of function: VMP $Frame links constructor
+
+   VMC_FrameLinks ::
+             ~VMC_FrameLinks( )
+   {
+
+      delete [ ] vtPrev ;
+      delete [ ] vtNext ;
+      delete [ ] vtList ;
+
+   } // End of function: VMP $Frame links destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Allocate link vectors
+
+   void VMC_FrameLinks ::
+             Allocate( int numFramesParm )
+   {
+
+      numFrames = numFramesParm ;
+      vtPrev    = new int[ numFrames + 1 ] ;
+      vtNext    = new int[ numFrames + 1 ] ;
+      vtList    = new VMC_FrameList * [ numFrames + 1 ] ;
+
+      for ( int inxFrame = 0 ; inxFrame < numFrames ; inxFrame++ )
+      {
+         vtPrev[ inxFrame ] = -1 ;
+         vtNext[ inxFrame ] = -1 ;
+         vtList[ inxFrame ] = NULL ;
+      } /* for */
+
+   } // End of function: VMP $Allocate link vectors
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Make list empty
+
+   void VMC_FrameLinks ::
+             ClearList( VMC_FrameList * pList )
+   {
+
+      pList->inxHead = -1 ;
+      pList->inxTail = -1 ;
+      pList->numElem = 0 ;
+
+   } // End of function: VMP $Make list empty
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Insert frame at list head
+
+   void VMC_FrameLinks ::
+             LinkHead( VMC_FrameList * pList , int inxFrame )
+   {
+
+      vtPrev[ inxFrame ] = -1 ;
+      vtNext[ inxFrame ] = pList->inxHead ;
+
+      if ( pList->inxHead >= 0 )
+      {
+         vtPrev[ pList->inxHead ] = inxFrame ;
+      } else
+      {
+         pList->inxTail = inxFrame ;
+      } /* if */
+
+      pList->inxHead = inxFrame ;
+      pList->numElem ++ ;
+      vtList[ inxFrame ] = pList ;
+
+   } // End of function: VMP $Insert frame at list head
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Insert frame at list tail
+
+   void VMC_FrameLinks ::
+             LinkTail( VMC_FrameList * pList , int inxFrame )
+   {
+
+      vtNext[ inxFrame ] = -1 ;
+      vtPrev[ inxFrame ] = pList->inxTail ;
+
+      if ( pList->inxTail >= 0 )
+      {
+         vtNext[ pList->inxTail ] = inxFrame ;
+      } else
+      {
+         pList->inxHead = inxFrame ;
+      } /* if */
+
+      pList->inxTail = inxFrame ;
+      pList->numElem ++ ;
+      vtList[ inxFrame ] = pList ;
+
+   } // End of function: VMP $Insert frame at list tail
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Unlink frame from the list it belongs to
+
+   void VMC_FrameLinks ::
+             Unlink( int inxFrame )
+   {
+
+      VMC_FrameList * pList = vtList[ inxFrame ] ;
+      if ( pList == NULL )
+      {
+         return ;
+      } /* if */
+
+      if ( vtPrev[ inxFrame ] >= 0 )
+      {
+         vtNext[ vtPrev[ inxFrame ]] = vtNext[ inxFrame ] ;
+      } else
+      {
+         pList->inxHead = vtNext[ inxFrame ] ;
+      } /* if */
+
+      if ( vtNext[ inxFrame ] >= 0 )
+      {
+         vtPrev[ vtNext[ inxFrame ]] = vtPrev[ inxFrame ] ;
+      } else
+      {
+         pList->inxTail = vtPrev[ inxFrame ] ;
+      } /* if */
+
+      pList->numElem -- ;
+
+      vtPrev[ inxFrame ] = -1 ;
+      vtNext[ inxFrame ] = -1 ;
+      vtList[ inxFrame ] = NULL ;
+
+   } // End of function: VMP $Unlink frame from the list it belongs to
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Get list containing a frame
+
+   VMC_FrameList * VMC_FrameLinks ::
+             GetList( int inxFrame )
+   {
+
+      return vtList[ inxFrame ] ;
+
+   } // End of function: VMP $Get list containing a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Get predecessor of a frame
+
+   int VMC_FrameLinks ::
+             GetPrev( int inxFrame )
+   {
+
+      return vtPrev[ inxFrame ] ;
+
+   } // End of function: VMP $Get predecessor of a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Get successor of a frame
+
+   int VMC_FrameLinks ::
+             GetNext( int inxFrame )
+   {
+
+      return vtNext[ inxFrame ] ;
+
+   } // End of function: VMP $Get successor of a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Verify list links
+
+   #define   ASSERT_VER( Condition , idMsg )   \
+      if ( !( Condition ) )                    \
+      {                                        \
+         if ( verifyMode == TAL_VerifyLog )    \
+         {                                     \
+            EXC_LOG( envelope.pMsg , idMsg ) ; \
+            numErrors ++ ;                     \
+         } else                                \
+         {                                     \
+            return 1 ;                         \
+         } /* if */                            \
+      }  /* if */
+
+   int VMC_FrameLinks ::
+             VerifyList( VMC_FrameList * pList , TAL_tpVerifyMode verifyMode )
+   {
+
+      int numErrors = 0 ;
+
+      // Frame links verification setup
+
+         struct PointerEnvelope
+         {
+            MSG_Message * pMsg ;
+
+            PointerEnvelope( )
+            {
+               pMsg = NULL ;
+            }
+
+           ~PointerEnvelope( )
+            {
+               delete pMsg ;
+            }
+         } envelope ; /* struct */
+
+         if ( verifyMode == TAL_VerifyLog )
+         {
+            envelope.pMsg = new MSG_Message( VMC_ErrorRootElemVerify ) ;
+         } /* if */
+
+      // Verify list anchors
+
+         if ( pList->inxHead >= 0 )
+         {
+            ASSERT_VER( vtPrev[ pList->inxHead ] == -1 , 70 ) ;
+         } else
+         {
+            ASSERT_VER( pList->numElem == 0 , 70 ) ;
+         } /* if */
+
+         if ( pList->inxTail >= 0 )
+         {
+            ASSERT_VER( vtNext[ pList->inxTail ] == -1 , 71 ) ;
+         } else
+         {
+            ASSERT_VER( pList->inxHead == -1 , 71 ) ;
+         } /* if */
+
+      // Verify all list elements
+
+         int countElem = 0 ;
+         int inxFrame  = pList->inxHead ;
+
+         while ( ( inxFrame >= 0 )
+              && ( countElem <= numFrames ))
+         {
+            if ( envelope.pMsg != NULL )
+            {
+               envelope.pMsg->AddItem( 1 , new MSG_ItemInteger( inxFrame )) ;
+            } /* if */
+
+            if ( vtNext[ inxFrame ] >= 0 )
+            {
+               ASSERT_VER( vtPrev[ vtNext[ inxFrame ]] == inxFrame , 72 ) ;
+            } else
+            {
+               ASSERT_VER( inxFrame == pList->inxTail , 72 ) ;
+            } /* if */
+
+            if ( vtPrev[ inxFrame ] >= 0 )
+            {
+               ASSERT_VER( vtNext[ vtPrev[ inxFrame ]] == inxFrame , 73 ) ;
+            } else
+            {
+               ASSERT_VER( inxFrame == pList->inxHead , 73 ) ;
+            } /* if */
+
+            ASSERT_VER( vtList[ inxFrame ] == pList , 74 ) ;
+
+            countElem ++ ;
+            inxFrame = vtNext[ inxFrame ] ;
+         } /* while */
+
+         ASSERT_VER( countElem == pList->numElem , 75 ) ;
+
+      return numErrors ;
+
+   } // End of function: VMP $Verify list links
+
+//--- End of class: VMP  Frame index links
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  Basic replacement policy
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMP  Basic replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Basic policy constructor
+
+   VMC_BasicPolicy ::
+             VMC_BasicPolicy( )
+   {
+
+      numFrames      = 0 ;
+      numAddedFrames = 0 ;
+      vtPageFrame    = NULL ;
+      vtHomeList     = NULL ;
+
+      VMC_FrameLinks::ClearList( &pinnedList ) ;
+
+   } // End of function: VMP $Basic policy constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Basic policy destructor
+
+   VMC_BasicPolicy ::
+             ~VMC_BasicPolicy( )
+   {
+
+      delete [ ] vtPageFrame ;
+      delete [ ] vtHomeList ;
+
+   } // End of function: VMP $Basic policy destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Start policy
+
+   void VMC_BasicPolicy ::
+             StartPolicy( int numFramesParm )
+   {
+
+      numFrames      = numFramesParm ;
+      numAddedFrames = 0 ;
+      vtPageFrame    = new VMC_PageFrame * [ numFrames + 1 ] ;
+      vtHomeList  = new VMC_FrameList * [ numFrames + 1 ] ;
+
+      for ( int inxFrame = 0 ; inxFrame < numFrames ; inxFrame++ )
+      {
+         vtPageFrame[ inxFrame ] = NULL ;
+         vtHomeList[  inxFrame ] = NULL ;
+      } /* for */
+
+      frameLinks.Allocate( numFrames ) ;
+
+   } // End of function: VMP !Start policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Add empty frame
+//    Only registers the frame, empty frames belong to no list
+
+   void VMC_BasicPolicy ::
+             AddFrame( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      vtPageFrame[ inxFrame ] = pPageFrame ;
+      if ( numAddedFrames <= inxFrame )
+      {
+         numAddedFrames = inxFrame + 1 ;
+      } /* if */
+
+   } // End of function: VMP !Add empty frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On remove
+//    The frame leaves whatever list it is in, including the pinned list
+
+   void VMC_BasicPolicy ::
+             OnRemove( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      vtHomeList[ inxFrame ] = NULL ;
+
+   } // End of function: VMP !On remove
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On pin
+//    Moves the frame from its current list to the pinned list
+
+   void VMC_BasicPolicy ::
+             OnPin( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      if ( frameLinks.GetList( inxFrame ) == &pinnedList )
+      {
+         return ;
+      } /* if */
+
+      vtHomeList[ inxFrame ] = frameLinks.GetList( inxFrame ) ;
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkTail( &pinnedList , inxFrame ) ;
+
+   } // End of function: VMP !On pin
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On unpin
+//    Returns the frame to the head of the list it came from
+
+   void VMC_BasicPolicy ::
+             OnUnpin( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      VMC_FrameList * pHomeList = ReleasePinnedFrame( inxFrame ) ;
+      if ( pHomeList != NULL )
+      {
+         frameLinks.LinkHead( pHomeList , inxFrame ) ;
+      } /* if */
+
+   } // End of function: VMP !On unpin
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Release frame from the pinned list
+
+   VMC_FrameList * VMC_BasicPolicy ::
+             ReleasePinnedFrame( int inxFrame )
+   {
+
+      if ( frameLinks.GetList( inxFrame ) != &pinnedList )
+      {
+         return NULL ;
+      } /* if */
+
+      frameLinks.Unlink( inxFrame ) ;
+
+      VMC_FrameList * pHomeList = vtHomeList[ inxFrame ] ;
+      vtHomeList[ inxFrame ] = NULL ;
+
+      return pHomeList ;
+
+   } // End of function: VMP $Release frame from the pinned list
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $List frames from list tail to head
+
+   int VMC_BasicPolicy ::
+             ListFromTail( VMC_FrameList * pList ,
+                           VMC_PageFrame ** vtCandidate ,
+                           int numCandidates ,
+                           int maxCandidates )
+   {
+
+      int inxFrame = pList->inxTail ;
+
+      while ( ( inxFrame >= 0 )
+           && ( numCandidates < maxCandidates ))
+      {
+         vtCandidate[ numCandidates ] = vtPageFrame[ inxFrame ] ;
+         numCandidates ++ ;
+         inxFrame = frameLinks.GetPrev( inxFrame ) ;
+      } /* while */
+
+      return numCandidates ;
+
+   } // End of function: VMP $List frames from list tail to head
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Is frame empty
+
+   bool VMC_BasicPolicy ::
+             IsFrameEmpty( int inxFrame )
+   {
+
+      return vtPageFrame[ inxFrame ]->GetIdSeg( ) < 0 ;
+
+   } // End of function: VMP $Is frame empty
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Verify frame vector
+
+   int VMC_BasicPolicy ::
+             VerifyFrames( TAL_tpVerifyMode verifyMode )
+   {
+
+      int numErrors = 0 ;
+
+      // Frame vector verification setup
+
+         struct PointerEnvelope
+         {
+            MSG_Message * pMsg ;
+
+            PointerEnvelope( )
+            {
+               pMsg = NULL ;
+            }
+
+           ~PointerEnvelope( )
+            {
+               delete pMsg ;
+            }
+         } envelope ; /* struct */
+
+         if ( verifyMode == TAL_VerifyLog )
+         {
+            envelope.pMsg = new MSG_Message( VMC_ErrorRootElemVerify ) ;
+         } /* if */
+
+      // Verify all frames are known
+
+         for ( int inxFrame = 0 ; inxFrame < numAddedFrames ; inxFrame++ )
+         {
+            if ( envelope.pMsg != NULL )
+            {
+               envelope.pMsg->AddItem( 1 , new MSG_ItemInteger( inxFrame )) ;
+            } /* if */
+
+            ASSERT_VER( vtPageFrame[ inxFrame ] != NULL , 78 ) ;
+            if ( vtPageFrame[ inxFrame ] != NULL )
+            {
+               ASSERT_VER( vtPageFrame[ inxFrame ]->GetInxPageFrameElem( ) ==
+                         inxFrame , 76 ) ;
+               ASSERT_VER( ( vtPageFrame[ inxFrame ]->GetNumPins( ) > 0 ) ==
+                         ( frameLinks.GetList( inxFrame ) == &pinnedList ) , 77 ) ;
+               ASSERT_VER( IsFrameEmpty( inxFrame ) ==
+                         ( frameLinks.GetList( inxFrame ) == NULL ) , 77 ) ;
+            } /* if */
+         } /* for */
+
+      // Verify pinned list
+
+         numErrors += frameLinks.VerifyList( &pinnedList , verifyMode ) ;
+
+      return numErrors ;
+
+   } // End of function: VMP $Verify frame vector
+
+//--- End of class: VMP  Basic replacement policy
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  LRU replacement policy
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMP  LRU replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $LRU policy constructor
+
+   VMC_LruPolicy ::
+             VMC_LruPolicy( )
+   {
+
+      VMC_FrameLinks::ClearList( &lruList ) ;
+
+   } // End of function: VMP $LRU policy constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On access
+//    Moves the frame to the head of the LRU list
+//    Pinned frames are not moved, they return to the head when unpinned
+
+   void VMC_LruPolicy ::
+             OnAccess( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      if ( ( frameLinks.GetList( inxFrame ) == &lruList )
+        && ( lruList.inxHead != inxFrame ))
+      {
+         frameLinks.Unlink( inxFrame ) ;
+         frameLinks.LinkHead( &lruList , inxFrame ) ;
+      } /* if */
+
+   } // End of function: VMP !On access
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On insert
+
+   void VMC_LruPolicy ::
+             OnInsert( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkHead( &lruList , inxFrame ) ;
+
+   } // End of function: VMP !On insert
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On prefetch
+//    Pages read ahead enter at the tail, they reach the head only when
+//    accessed
+
+   void VMC_LruPolicy ::
+             OnPrefetch( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkTail( &lruList , inxFrame ) ;
+
+   } // End of function: VMP !On prefetch
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Choose victim
+//    The LRU list contains no pinned frame, its tail is the victim
+
+   VMC_PageFrame * VMC_LruPolicy ::
+             ChooseVictim( )
+   {
+
+      if ( lruList.inxTail >= 0 )
+      {
+         return vtPageFrame[ lruList.inxTail ] ;
+      } /* if */
+
+      return NULL ;
+
+   } // End of function: VMP !Choose victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Get victim candidates
+
+   int VMC_LruPolicy ::
+             GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )
+   {
+
+      return ListFromTail( &lruList , vtCandidate , 0 , maxCandidates ) ;
+
+   } // End of function: VMP !Get victim candidates
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Verify replacement policy
+
+   int VMC_LruPolicy ::
+             VerifyPolicy( TAL_tpVerifyMode verifyMode )
+   {
+
+      int numErrors = VerifyFrames( verifyMode ) ;
+      if ( ( numErrors != 0 )
+        && ( verifyMode != TAL_VerifyLog ))
+      {
+         return numErrors ;
+      } /* if */
+
+      numErrors += frameLinks.VerifyList( &lruList , verifyMode ) ;
+
+      return numErrors ;
+
+   } // End of function: VMP !Verify replacement policy
+
+//--- End of class: VMP  LRU replacement policy
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  Clock replacement policy
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMP  Clock replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Clock policy constructor
+
+   VMC_ClockPolicy ::
+             VMC_ClockPolicy( )
+   {
+
+      VMC_FrameLinks::ClearList( &clockList ) ;
+      vtReferenced = NULL ;
+      inxHand      = 0 ;
+
+   } // End of function: VMP $Clock policy constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Clock policy destructor
+
+   VMC_ClockPolicy ::
+             ~VMC_ClockPolicy( )
+   {
+
+      delete [ ] vtReferenced ;
+
+   } // End of function: VMP $Clock policy destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Start policy
+
+   void VMC_ClockPolicy ::
+             StartPolicy( int numFramesParm )
+   {
+
+      VMC_BasicPolicy::StartPolicy( numFramesParm ) ;
+
+      vtReferenced = new bool[ numFrames + 1 ] ;
+      for ( int inxFrame = 0 ; inxFrame < numFrames ; inxFrame++ )
+      {
+         vtReferenced[ inxFrame ] = false ;
+      } /* for */
+
+   } // End of function: VMP !Start policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On access
+//    Only sets the reference bit, the frame is not moved
+
+   void VMC_ClockPolicy ::
+             OnAccess( VMC_PageFrame * pPageFrame )
+   {
+
+      vtReferenced[ pPageFrame->GetInxPageFrameElem( ) ] = true ;
+
+   } // End of function: VMP !On access
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On insert
+//    The frame joins the ring referenced, the hand passes over it once
+//    before it may be chosen
+
+   void VMC_ClockPolicy ::
+             OnInsert( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkTail( &clockList , inxFrame ) ;
+      vtReferenced[ inxFrame ] = true ;
+
+   } // End of function: VMP !On insert
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On prefetch
+//    Pages read ahead enter the ring unreferenced, the clock hand evicts
+//    them at its next pass unless they are accessed before
+
+   void VMC_ClockPolicy ::
+             OnPrefetch( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkTail( &clockList , inxFrame ) ;
+      vtReferenced[ inxFrame ] = false ;
+
+   } // End of function: VMP !On prefetch
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On remove
+
+   void VMC_ClockPolicy ::
+             OnRemove( VMC_PageFrame * pPageFrame )
+   {
+
+      vtReferenced[ pPageFrame->GetInxPageFrameElem( ) ] = false ;
+
+      VMC_BasicPolicy::OnRemove( pPageFrame ) ;
+
+   } // End of function: VMP !On remove
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On unpin
+//    The frame returns to the ring referenced
+
+   void VMC_ClockPolicy ::
+             OnUnpin( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      VMC_FrameList * pHomeList = ReleasePinnedFrame( inxFrame ) ;
+      if ( pHomeList != NULL )
+      {
+         frameLinks.LinkTail( pHomeList , inxFrame ) ;
+         vtReferenced[ inxFrame ] = true ;
+      } /* if */
+
+   } // End of function: VMP !On unpin
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Choose victim
+//    Advances the clock hand over the frame vector until a frame of the
+//    ring that has not been referenced since the previous sweep is found.
+//    The reference bit of every frame of the ring passed over is reset,
+//    empty and pinned frames are skipped. Hence at most two full turns
+//    are needed, and an empty ring means all frames are pinned.
+
+   VMC_PageFrame * VMC_ClockPolicy ::
+             ChooseVictim( )
+   {
+
+      if ( clockList.numElem == 0 )
+      {
+         return NULL ;
+      } /* if */
+
+      for ( int numSteps = 0 ; numSteps < 2 * numAddedFrames ; numSteps++ )
+      {
+         int inxFrame = inxHand ;
+
+         inxHand ++ ;
+         if ( inxHand >= numAddedFrames )
+         {
+            inxHand = 0 ;
+         } /* if */
+
+         if ( frameLinks.GetList( inxFrame ) == &clockList )
+         {
+            if ( !vtReferenced[ inxFrame ] )
+            {
+               return vtPageFrame[ inxFrame ] ;
+            } /* if */
+
+            vtReferenced[ inxFrame ] = false ;
+         } /* if */
+      } /* for */
+
+      return NULL ;
+
+   } // End of function: VMP !Choose victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Get victim candidates
+//    The hand evicts the frames not referenced in frame order, starting
+//    at the hand, after a full turn the others follow in the same order.
+
+   int VMC_ClockPolicy ::
+             GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )
+   {
+
+      int numCandidates = 0 ;
+
+      for ( int isReferenced = 0 ; isReferenced < 2 ; isReferenced++ )
+      {
+         for ( int numSteps = 0 ; ( numSteps < numAddedFrames )
+                               && ( numCandidates < maxCandidates ) ; numSteps++ )
+         {
+            int inxFrame = ( inxHand + numSteps ) % numAddedFrames ;
+
+            if ( ( frameLinks.GetList( inxFrame ) == &clockList )
+              && ( vtReferenced[ inxFrame ] == ( isReferenced != 0 )))
+            {
+               vtCandidate[ numCandidates ] = vtPageFrame[ inxFrame ] ;
+               numCandidates ++ ;
+            } /* if */
+         } /* for */
+      } /* for */
+
+      return numCandidates ;
+
+   } // End of function: VMP !Get victim candidates
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Verify replacement policy
+
+   int VMC_ClockPolicy ::
+             VerifyPolicy( TAL_tpVerifyMode verifyMode )
+   {
+
+      int numErrors = VerifyFrames( verifyMode ) ;
+      if ( ( numErrors != 0 )
+        && ( verifyMode != TAL_VerifyLog ))
+      {
+         return numErrors ;
+      } /* if */
+
+      numErrors += frameLinks.VerifyList( &clockList , verifyMode ) ;
+
+      return numErrors ;
+
+   } // End of function: VMP !Verify replacement policy
+
+//--- End of class: VMP  Clock replacement policy
+
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMP  2Q replacement policy
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMP  2Q replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $2Q policy constructor
+
+   VMC_2QPolicy ::
+             VMC_2QPolicy( )
+   {
+
+      VMC_FrameLinks::ClearList( &amList ) ;
+      VMC_FrameLinks::ClearList( &a1inList ) ;
+
+      maxA1inFrames        = 1 ;
+      vtGhostEntry         = NULL ;
+      numGhostEntries      = 0 ;
+      inxGhostEntry        = 0 ;
+      totalGhostHitCounter = 0 ;
+
+      for ( int i = 0 ; i < TAL_dimColision ; i++ )
+      {
+         vtGhostHash[ i ] = -1 ;
+      } /* for */
+
+   } // End of function: VMP $2Q policy constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $2Q policy destructor
+
+   VMC_2QPolicy ::
+             ~VMC_2QPolicy( )
+   {
+
+      delete [ ] vtGhostEntry ;
+
+   } // End of function: VMP $2Q policy destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Start policy
+//    The ghost queue remembers half as many pages as there may be frames.
+
+   void VMC_2QPolicy ::
+             StartPolicy( int numFramesParm )
+   {
+
+      VMC_BasicPolicy::StartPolicy( numFramesParm ) ;
+
+      maxA1inFrames = 1 ;
+
+      numGhostEntries = numFrames / 2 ;
+      if ( numGhostEntries < 1 )
+      {
+         numGhostEntries = 1 ;
+      } /* if */
+
+      vtGhostEntry = new VMC_GhostEntry[ numGhostEntries ] ;
+      for ( int i = 0 ; i < numGhostEntries ; i++ )
+      {
+         vtGhostEntry[ i ].idSegment    = TAL_NullIdSeg ;
+         vtGhostEntry[ i ].idPage       = TAL_NullIdPag ;
+         vtGhostEntry[ i ].inxNextGhost = -1 ;
+      } /* for */
+
+   } // End of function: VMP !Start policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Add empty frame
+//    A1in is limited to a quarter of the frames added so far.
+
+   void VMC_2QPolicy ::
+             AddFrame( VMC_PageFrame * pPageFrame )
+   {
+
+      VMC_BasicPolicy::AddFrame( pPageFrame ) ;
+
+      maxA1inFrames = numAddedFrames / 4 ;
+      if ( maxA1inFrames < 1 )
+      {
+         maxA1inFrames = 1 ;
+      } /* if */
+
+   } // End of function: VMP !Add empty frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On access
+//    Frames in A1in are not moved
+
+   void VMC_2QPolicy ::
+             OnAccess( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      if ( ( frameLinks.GetList( inxFrame ) == &amList )
+        && ( amList.inxHead != inxFrame ))
+      {
+         frameLinks.Unlink( inxFrame ) ;
+         frameLinks.LinkHead( &amList , inxFrame ) ;
+      } /* if */
+
+   } // End of function: VMP !On access
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On insert
+
+   void VMC_2QPolicy ::
+             OnInsert( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+
+      if ( RemoveGhostEntry( pPageFrame->GetIdSeg( ) , pPageFrame->GetIdPag( )))
+      {
+         totalGhostHitCounter ++ ;
+         frameLinks.LinkHead( &amList , inxFrame ) ;
+      } else
+      {
+         frameLinks.LinkHead( &a1inList , inxFrame ) ;
+      } /* if */
+
+   } // End of function: VMP !On insert
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On prefetch
+//    Pages read ahead enter at the tail of A1in, reading ahead is not a
+//    reference, hence the ghost queue is not consulted
+
+   void VMC_2QPolicy ::
+             OnPrefetch( VMC_PageFrame * pPageFrame )
+   {
+
+      int inxFrame = pPageFrame->GetInxPageFrameElem( ) ;
+
+      frameLinks.Unlink( inxFrame ) ;
+      frameLinks.LinkTail( &a1inList , inxFrame ) ;
+
+   } // End of function: VMP !On prefetch
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Choose victim
+//    While A1in holds more than its share of frames its oldest page is
+//    evicted, otherwise the least recently used page of the LRU list.
+//    If the chosen list is empty the other one is used. Neither list
+//    contains pinned frames.
+
+   VMC_PageFrame * VMC_2QPolicy ::
+             ChooseVictim( )
+   {
+
+      int inxFrame = amList.inxTail ;
+
+      if ( ( a1inList.numElem > maxA1inFrames )
+        || ( inxFrame < 0 ))
+      {
+         inxFrame = a1inList.inxTail ;
+      } /* if */
+
+      if ( inxFrame < 0 )
+      {
+         return NULL ;
+      } /* if */
+
+      return vtPageFrame[ inxFrame ] ;
+
+   } // End of function: VMP !Choose victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Get victim candidates
+//    Lists the frames of the list ChooseVictim would use first, then
+//    those of the other list.
+
+   int VMC_2QPolicy ::
+             GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )
+   {
+
+      VMC_FrameList * pFirstList  = &amList ;
+      VMC_FrameList * pSecondList = &a1inList ;
+
+      if ( a1inList.numElem > maxA1inFrames )
+      {
+         pFirstList  = &a1inList ;
+         pSecondList = &amList ;
+      } /* if */
+
+      int numCandidates = ListFromTail( pFirstList , vtCandidate , 0 ,
+                                        maxCandidates ) ;
+      return ListFromTail( pSecondList , vtCandidate , numCandidates ,
+                           maxCandidates ) ;
+
+   } // End of function: VMP !Get victim candidates
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !On remove
+//    The address of a page removed from A1in enters the ghost queue
+
+   void VMC_2QPolicy ::
+             OnRemove( VMC_PageFrame * pPageFrame )
+   {
+
+      if ( frameLinks.GetList( pPageFrame->GetInxPageFrameElem( )) == &a1inList )
+      {
+         InsertGhostEntry( pPageFrame->GetIdSeg( ) , pPageFrame->GetIdPag( )) ;
+      } /* if */
+
+      VMC_BasicPolicy::OnRemove( pPageFrame ) ;
+
+   } // End of function: VMP !On remove
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Forget segment
+
+   void VMC_2QPolicy ::
+             ForgetSegment( int idSeg )
+   {
+
+      for ( int inxGhost = 0 ; inxGhost < numGhostEntries ; inxGhost++ )
+      {
+         if ( vtGhostEntry[ inxGhost ].idSegment == idSeg )
+         {
+            UnlinkGhostEntry( inxGhost ) ;
+         } /* if */
+      } /* for */
+
+   } // End of function: VMP !Forget segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Verify replacement policy
+
+   int VMC_2QPolicy ::
+             VerifyPolicy( TAL_tpVerifyMode verifyMode )
+   {
+
+      int numErrors = VerifyFrames( verifyMode ) ;
+      if ( ( numErrors != 0 )
+        && ( verifyMode != TAL_VerifyLog ))
+      {
+         return numErrors ;
+      } /* if */
+
+      numErrors += frameLinks.VerifyList( &amList   , verifyMode ) ;
+      numErrors += frameLinks.VerifyList( &a1inList , verifyMode ) ;
+
+      return numErrors ;
+
+   } // End of function: VMP !Verify replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP !Display policy statistics
+
+   void VMC_2QPolicy ::
+             DisplayStatistics( LOG_Logger * pLogger )
+   {
+
+      char msg[ DIM_STAT_LINE ] ;
+      snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStat2Q ) ,
+              a1inList.numElem , maxA1inFrames ,
+              numGhostEntries , totalGhostHitCounter ) ;
+      pLogger->Log( msg ) ;
+
+   } // End of function: VMP !Display policy statistics
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Compute ghost hash index
+
+   int VMC_2QPolicy ::
+             ComputeInxGhostHash( int idSeg , int idPag )
+   {
+
+      return static_cast< int >
+                (( idSeg * 2083 + idPag ) % TAL_dimColision ) ;
+
+   } // End of function: VMP $Compute ghost hash index
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Insert virtual address into ghost queue
+//    Reuses the oldest entry of the circular ghost vector.
+
+   void VMC_2QPolicy ::
+             InsertGhostEntry( int idSeg , int idPag )
+   {
+
+      int inxGhost = inxGhostEntry ;
+
+      inxGhostEntry ++ ;
+      if ( inxGhostEntry >= numGhostEntries )
+      {
+         inxGhostEntry = 0 ;
+      } /* if */
+
+      UnlinkGhostEntry( inxGhost ) ;
+
+      int inxHash = ComputeInxGhostHash( idSeg , idPag ) ;
+
+      vtGhostEntry[ inxGhost ].idSegment    = idSeg ;
+      vtGhostEntry[ inxGhost ].idPage       = idPag ;
+      vtGhostEntry[ inxGhost ].inxNextGhost = vtGhostHash[ inxHash ] ;
+      vtGhostHash[ inxHash ] = inxGhost ;
+
+   } // End of function: VMP $Insert virtual address into ghost queue
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Remove virtual address from ghost queue
+//    Returns true if the address was found and removed
+
+   bool VMC_2QPolicy ::
+             RemoveGhostEntry( int idSeg , int idPag )
+   {
+
+      int inxGhost = vtGhostHash[ ComputeInxGhostHash( idSeg , idPag ) ] ;
+
+      while ( inxGhost >= 0 )
+      {
+         if ( ( vtGhostEntry[ inxGhost ].idSegment == idSeg )
+           && ( vtGhostEntry[ inxGhost ].idPage    == idPag ))
+         {
+            UnlinkGhostEntry( inxGhost ) ;
+            return true ;
+         } /* if */
+         inxGhost = vtGhostEntry[ inxGhost ].inxNextGhost ;
+      } /* while */
+
+      return false ;
+
+   } // End of function: VMP $Remove virtual address from ghost queue
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMP $Unlink ghost entry from its hash chain
+//    The entry becomes unused. Unused entries are ignored.
+
+   void VMC_2QPolicy ::
+             UnlinkGhostEntry( int inxGhost )
+   {
+
+      VMC_GhostEntry * pGhost = &vtGhostEntry[ inxGhost ] ;
+
+      if ( pGhost->idSegment == TAL_NullIdSeg )
+      {
+         return ;
+      } /* if */
+
+      int * pLink = &vtGhostHash[ ComputeInxGhostHash( pGhost->idSegment ,
+                                                       pGhost->idPage )] ;
+      while ( *pLink != inxGhost )
+      {
+         pLink = &vtGhostEntry[ *pLink ].inxNextGhost ;
+      } /* while */
+      *pLink = pGhost->inxNextGhost ;
+
+      pGhost->idSegment    = TAL_NullIdSeg ;
+      pGhost->idPage       = TAL_NullIdPag ;
+      pGhost->inxNextGhost = -1 ;
+
+   } // End of function: VMP $Unlink ghost entry from its hash chain
+
+//--- End of class: VMP  2Q replacement policy
+
+////// End of implementation module: VMP  VMPOLICY Page replacement policies ////
@@ -0,0 +1,391 @@
+#ifndef _VMPOLICY_
+   #define _VMPOLICY_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMP  VMPOLICY Page replacement policies
+//
+// Generated file:    VMPOLICY.HPP
+//
+// Module identification letters: VMP
+// Module identification number:  457
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMPOLICY.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Implements the page replacement policies, LRU, clock and 2Q, the
+//    virtual memory root chooses its victims with. The policies keep the
+//    replacement order of the frames in index linked lists.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMP Frame index list anchor
+//    Anchors a non circular doubly linked list of frame indexes.
+//    The links are kept by a VMC_FrameLinks object, hence a frame
+//    may belong to at most one of the lists sharing this object.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_FrameList
+   {
+
+   // VMP First and last frame index, -1 if the list is empty
+
+      int inxHead ;
+      int inxTail ;
+
+   // VMP Number of frames in the list
+
+      int numElem ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMP 2Q ghost queue entry
+//    Virtual address of a page recently evicted from A1in.
+//    Entries with the same hash index are chained by inxNextGhost.
+//    Unused entries contain TAL_NullIdSeg.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_GhostEntry
+   {
+
+      int idSegment ;
+
+      int idPage ;
+
+      int inxNextGhost ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMP  Frame index links
+//    Vectors of forward and backward links between frame indexes.
+//    Each frame also records the list it currently belongs to.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_FrameLinks
+   {
+
+   //  Method: VMP $Frame links constructor and destructor
+
+      public:
+         VMC_FrameLinks( )  ;
+         ~VMC_FrameLinks( )  ;
+
+   //  Method: VMP $Allocate link vectors
+
+      public:
+         void Allocate( int numFramesParm )  ;
+
+   //  Method: VMP $Make list empty
+
+      public:
+         static void ClearList( VMC_FrameList * pList )  ;
+
+   //  Method: VMP $Insert frame at list head or tail
+   //    The frame must not belong to any list.
+
+      public:
+         void LinkHead( VMC_FrameList * pList , int inxFrame )  ;
+         void LinkTail( VMC_FrameList * pList , int inxFrame )  ;
+
+   //  Method: VMP $Unlink frame from the list it belongs to
+
+      public:
+         void Unlink( int inxFrame )  ;
+
+   //  Method: VMP $Get list containing a frame, NULL if none
+
+      public:
+         VMC_FrameList * GetList( int inxFrame )  ;
+
+   //  Method: VMP $Get predecessor and successor of a frame, -1 if none
+
+      public:
+         int GetPrev( int inxFrame )  ;
+         int GetNext( int inxFrame )  ;
+
+   //  Method: VMP $Verify list links
+
+      public:
+         int VerifyList( VMC_FrameList * pList , TAL_tpVerifyMode verifyMode )  ;
+
+   // VMP Number of frames
+
+      private:
+         int numFrames ;
+
+   // VMP Link vectors indexed by frame index
+
+      private:
+         int * vtPrev ;
+         int * vtNext ;
+         VMC_FrameList ** vtList ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMP  Basic replacement policy
+//    Common base of the built in policies.
+//    Keeps the vector of page frames and the frame index links.
+//    Empty frames belong to no list, they are kept by the root.
+//    Pinned frames are moved to the pinned list, hence the lists of the
+//    derived policies only contain replaceable frames.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_BasicPolicy : public VMC_ReplacementPolicy
+   {
+
+      public:
+         VMC_BasicPolicy( )  ;
+         ~VMC_BasicPolicy( )  ;
+
+      public:
+         void StartPolicy( int numFramesParm )  ;
+         void AddFrame( VMC_PageFrame * pPageFrame )  ;
+         void OnRemove( VMC_PageFrame * pPageFrame )  ;
+         void OnPin( VMC_PageFrame * pPageFrame )  ;
+         void OnUnpin( VMC_PageFrame * pPageFrame )  ;
+
+   //  Method: VMP $Release frame from the pinned list
+   //    Returns the list the frame belonged to when it was pinned,
+   //    NULL if the frame is not in the pinned list.
+
+      protected:
+         VMC_FrameList * ReleasePinnedFrame( int inxFrame )  ;
+
+   //  Method: VMP $List frames from list tail to head
+   //    Appends at most maxCandidates frames to vtCandidate after the
+   //    numCandidates already there. Returns the new number of frames.
+
+      protected:
+         int ListFromTail( VMC_FrameList * pList ,
+                           VMC_PageFrame ** vtCandidate ,
+                           int numCandidates ,
+                           int maxCandidates )  ;
+
+   //  Method: VMP $Is frame empty
+
+      protected:
+         bool IsFrameEmpty( int inxFrame )  ;
+
+   //  Method: VMP $Verify frame vector
+
+      protected:
+         int VerifyFrames( TAL_tpVerifyMode verifyMode )  ;
+
+   // VMP Number of frames and vector of frames
+   //    numFrames is the maximum number of frames, frames
+   //    0 .. numAddedFrames - 1 have been added.
+
+      protected:
+         int numFrames ;
+         int numAddedFrames ;
+         VMC_PageFrame ** vtPageFrame ;
+
+   // VMP Frame index links
+
+      protected:
+         VMC_FrameLinks frameLinks ;
+
+   // VMP Pinned frames
+   //    vtHomeList holds the list each pinned frame is to return to.
+
+      protected:
+         VMC_FrameList pinnedList ;
+         VMC_FrameList ** vtHomeList ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMP  LRU replacement policy
+//    Least recently used frames are at the tail.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_LruPolicy : public VMC_BasicPolicy
+   {
+
+      public:
+         VMC_LruPolicy( )  ;
+
+      public:
+         void OnAccess( VMC_PageFrame * pPageFrame )  ;
+         void OnInsert( VMC_PageFrame * pPageFrame )  ;
+         void OnPrefetch( VMC_PageFrame * pPageFrame )  ;
+         VMC_PageFrame * ChooseVictim( )  ;
+         int GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )  ;
+         int VerifyPolicy( TAL_tpVerifyMode verifyMode )  ;
+
+   // VMP LRU list, most recently used at the head
+
+      private:
+         VMC_FrameList lruList ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMP  Clock replacement policy
+//    Accesses only set the reference bit of the frame.
+//    The clock hand is an index sweeping the frame vector, it skips the
+//    frames that are empty or pinned and thus not part of the ring.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_ClockPolicy : public VMC_BasicPolicy
+   {
+
+      public:
+         VMC_ClockPolicy( )  ;
+         ~VMC_ClockPolicy( )  ;
+
+      public:
+         void StartPolicy( int numFramesParm )  ;
+         void OnAccess( VMC_PageFrame * pPageFrame )  ;
+         void OnInsert( VMC_PageFrame * pPageFrame )  ;
+         void OnPrefetch( VMC_PageFrame * pPageFrame )  ;
+         void OnRemove( VMC_PageFrame * pPageFrame )  ;
+         void OnUnpin( VMC_PageFrame * pPageFrame )  ;
+         VMC_PageFrame * ChooseVictim( )  ;
+         int GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )  ;
+         int VerifyPolicy( TAL_tpVerifyMode verifyMode )  ;
+
+   // VMP Clock ring
+   //    Frames that may be replaced. The order of the list is not used,
+   //    the clock hand sweeps the frame vector.
+
+      private:
+         VMC_FrameList clockList ;
+
+   // VMP Reference bits
+   //    Set whenever the frame is accessed, reset when the clock hand
+   //    passes over the frame giving it a second chance.
+
+      private:
+         bool * vtReferenced ;
+
+   // VMP Clock hand
+   //    Index of the next frame the hand passes over.
+
+      private:
+         int inxHand ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMP  2Q replacement policy
+//    Pages read for the first time enter the A1in FIFO, pages whose
+//    address is still in the ghost queue enter the LRU list.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_2QPolicy : public VMC_BasicPolicy
+   {
+
+      public:
+         VMC_2QPolicy( )  ;
+         ~VMC_2QPolicy( )  ;
+
+      public:
+         void StartPolicy( int numFramesParm )  ;
+         void AddFrame( VMC_PageFrame * pPageFrame )  ;
+         void OnAccess( VMC_PageFrame * pPageFrame )  ;
+         void OnInsert( VMC_PageFrame * pPageFrame )  ;
+         void OnPrefetch( VMC_PageFrame * pPageFrame )  ;
+         void OnRemove( VMC_PageFrame * pPageFrame )  ;
+         VMC_PageFrame * ChooseVictim( )  ;
+         int GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                  int maxCandidates )  ;
+         void ForgetSegment( int idSeg )  ;
+         int VerifyPolicy( TAL_tpVerifyMode verifyMode )  ;
+         void DisplayStatistics( LOG_Logger * pLogger )  ;
+
+   //  Method: VMP $Compute ghost hash index
+
+      private:
+         int ComputeInxGhostHash( int idSeg , int idPag )  ;
+
+   //  Method: VMP $Insert virtual address into ghost queue
+
+      private:
+         void InsertGhostEntry( int idSeg , int idPag )  ;
+
+   //  Method: VMP $Remove virtual address from ghost queue
+
+      private:
+         bool RemoveGhostEntry( int idSeg , int idPag )  ;
+
+   //  Method: VMP $Unlink ghost entry from its hash chain
+
+      private:
+         void UnlinkGhostEntry( int inxGhost )  ;
+
+   // VMP LRU list of re-referenced pages and A1in FIFO
+
+      private:
+         VMC_FrameList amList ;
+         VMC_FrameList a1inList ;
+
+   // VMP A1in size limit
+
+      private:
+         int maxA1inFrames ;
+
+   // VMP A1out ghost queue
+   //    Circular vector of virtual addresses recently evicted from A1in.
+   //    inxGhostEntry is the next entry to be reused.
+   //    The hash table heads the chains of entries, -1 ends a chain.
+
+      private:
+         VMC_GhostEntry * vtGhostEntry ;
+         int numGhostEntries ;
+         int inxGhostEntry ;
+         int vtGhostHash[ TAL_dimColision ] ;
+
+   // VMP Ghost hit counter
+
+      private:
+         int totalGhostHitCounter ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMP  VMPOLICY Page replacement policies ////
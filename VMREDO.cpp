@@ -0,0 +1,510 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VML  VMREDO Redo log
+//
+//Generated file:        VMREDO.CPP
+//
+//Module identification letters: VML
+//Module identification number:  464
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMREDO.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+   #include  <unistd.h>
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMSEGRUN.hpp"
+   #include "VMREDO.hpp"
+
+   #include "exceptn.hpp"
+   #include "message.hpp"
+   #include "msgbin.hpp"
+   #include "segmsg.hpp"
+
+   #include "str_vmc.inc"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VML Minimum size of each record buffer of the redo log
+
+   static const int LOG_BUFFER_MIN_SIZE = 1024 * 1024 ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VML  Redo log
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VML  Redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Redo log constructor
+//    A buffer holds at least two records of a whole page.
+
+   VMC_RedoLog ::
+             VMC_RedoLog( int logFileParm , long long maxLogSizeParm ,
+                          int pageSizeParm )
+   {
+
+      sizeBuffer = 2 * ( pageSizeParm + static_cast< int >( sizeof( VMC_LogRecord ))) ;
+      if ( sizeBuffer < LOG_BUFFER_MIN_SIZE )
+      {
+         sizeBuffer = LOG_BUFFER_MIN_SIZE ;
+      } /* if */
+
+      vtBuffer[ 0 ]    = new char[ sizeBuffer ] ;
+      vtBuffer[ 1 ]    = new char[ sizeBuffer ] ;
+      inxActive        = 0 ;
+      sizeActive       = 0 ;
+
+      appendedLsn      = 0 ;
+      requestedLsn     = 0 ;
+      durableLsn       = 0 ;
+
+      isWriting        = false ;
+      isStopping       = false ;
+      isFailed         = false ;
+      isCheckpointing  = false ;
+
+      logFile          = logFileParm ;
+      logSize          = 0 ;
+      maxLogSize       = maxLogSizeParm ;
+
+      vtIsSegmentLogged = NULL ;
+      dimSegmentLogged  = 0 ;
+
+      totalRecords     = 0 ;
+      totalCommits     = 0 ;
+      totalSyncs       = 0 ;
+      totalCheckpoints = 0 ;
+      totalBytes       = 0 ;
+
+      writerThread     = std::thread( &VMC_RedoLog::WriteBatches , this ) ;
+
+   } // End of function: VML $Redo log constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Redo log destructor
+
+   VMC_RedoLog ::
+             ~VMC_RedoLog( )
+   {
+
+      {
+         std::lock_guard< std::mutex > logLock( logMutex ) ;
+         requestedLsn = appendedLsn ;
+         isStopping   = true ;
+      }
+      logChanged.notify_all( ) ;
+
+      writerThread.join( ) ;
+
+      close( logFile ) ;
+
+      delete [ ] vtBuffer[ 0 ] ;
+      delete [ ] vtBuffer[ 1 ] ;
+      delete [ ] vtIsSegmentLogged ;
+
+   } // End of function: VML $Redo log destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Append data record
+//    The first record of a segment since the last truncation is
+//    preceded by a record of its name.
+
+   long long VMC_RedoLog ::
+             AppendData( int idSeg , long long position ,
+                         int sizeData , const char * pData )
+   {
+
+      std::unique_lock< std::mutex > logLock( logMutex ) ;
+
+      if ( idSeg >= dimSegmentLogged )
+      {
+         int dimNew = dimSegmentLogged > 0 ? dimSegmentLogged : 8 ;
+         while ( dimNew <= idSeg )
+         {
+            dimNew *= 2 ;
+         } /* while */
+
+         bool * vtNew = new bool[ dimNew ] ;
+         for ( int inxSeg = 0 ; inxSeg < dimNew ; inxSeg++ )
+         {
+            vtNew[ inxSeg ] = ( inxSeg < dimSegmentLogged ) && vtIsSegmentLogged[ inxSeg ] ;
+         } /* for */
+
+         delete [ ] vtIsSegmentLogged ;
+         vtIsSegmentLogged = vtNew ;
+         dimSegmentLogged  = dimNew ;
+      } /* if */
+
+      if ( !vtIsSegmentLogged[ idSeg ] )
+      {
+         STR_String * pSegName ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            pSegName = SEG_SegmentRoot::GetRoot( )->GetSegmentFullName( idSeg ) ;
+         }
+         AppendRecord( logLock , LOG_RECORD_SEGMENT , idSeg , 0 ,
+                       pSegName->GetLength( ) , pSegName->GetString( )) ;
+         delete pSegName ;
+
+         vtIsSegmentLogged[ idSeg ] = true ;
+      } /* if */
+
+      totalRecords ++ ;
+
+      return AppendRecord( logLock , LOG_RECORD_DATA , idSeg , position ,
+                           sizeData , pData ) ;
+
+   } // End of function: VML $Append data record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Commit
+//    Nothing is synced if no record was appended since the last request.
+
+   bool VMC_RedoLog ::
+             Commit( bool isWait )
+   {
+
+      std::unique_lock< std::mutex > logLock( logMutex ) ;
+
+      totalCommits ++ ;
+
+      if ( requestedLsn < appendedLsn )
+      {
+         requestedLsn = appendedLsn ;
+         logChanged.notify_all( ) ;
+      } /* if */
+
+      if ( isWait )
+      {
+         return WaitDurable( logLock , appendedLsn ) ;
+      } /* if */
+
+      return !isFailed ;
+
+   } // End of function: VML $Commit
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Force log for a page
+//    Asks for all records appended, the sync is shared with them.
+
+   void VMC_RedoLog ::
+             ForcePage( long long pageLsn , int idSeg , int idPag )
+   {
+
+      std::unique_lock< std::mutex > logLock( logMutex ) ;
+
+      if ( pageLsn <= durableLsn )
+      {
+         return ;
+      } /* if */
+
+      if ( requestedLsn < appendedLsn )
+      {
+         requestedLsn = appendedLsn ;
+         logChanged.notify_all( ) ;
+      } /* if */
+
+      if ( !WaitDurable( logLock , pageLsn )
+        && !isCheckpointing )
+      {
+         logLock.unlock( ) ;
+
+         MSG_Message * pMsg = new MSG_Message( VMC_ErrorLogFailed ) ;
+         pMsg->AddItem( 0 , new MSG_ItemInteger( idPag )) ;
+         pMsg->AddItem( 1 , new SEG_ItemSegmentFullName( idSeg )) ;
+         EXC_ERROR( pMsg , -1 , TAL_NullIdHelp ) ;
+      } /* if */
+
+   } // End of function: VML $Force log for a page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Set checkpointing
+//    Wakes the pages waiting for a failed log, they are written by the
+//    checkpoint.
+
+   void VMC_RedoLog ::
+             SetCheckpointing( bool isOn )
+   {
+
+      std::lock_guard< std::mutex > logLock( logMutex ) ;
+
+      isCheckpointing = isOn ;
+      logChanged.notify_all( ) ;
+
+   } // End of function: VML $Set checkpointing
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Truncate log
+//    Once the records are durable or discarded and no batch is being
+//    written, the file is emptied and synced, hence a crash cannot
+//    leave records older than pages already written.
+
+   bool VMC_RedoLog ::
+             Truncate( )
+   {
+
+      std::unique_lock< std::mutex > logLock( logMutex ) ;
+
+      requestedLsn = appendedLsn ;
+      logChanged.notify_all( ) ;
+
+      WaitDurable( logLock , appendedLsn ) ;
+
+      while ( isWriting
+           || ( sizeActive > 0 ))
+      {
+         logChanged.wait( logLock ) ;
+      } /* while */
+
+      if ( ( ftruncate( logFile , 0 ) != 0 )
+        || ( fdatasync( logFile ) != 0 ))
+      {
+         return false ;
+      } /* if */
+
+      durableLsn = appendedLsn ;
+      isFailed   = false ;
+      logSize    = 0 ;
+
+      for ( int inxSeg = 0 ; inxSeg < dimSegmentLogged ; inxSeg++ )
+      {
+         vtIsSegmentLogged[ inxSeg ] = false ;
+      } /* for */
+
+      totalCheckpoints ++ ;
+
+      return true ;
+
+   } // End of function: VML $Truncate log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Forget segment
+
+   void VMC_RedoLog ::
+             ForgetSegment( int idSeg )
+   {
+
+      std::lock_guard< std::mutex > logLock( logMutex ) ;
+
+      if ( ( idSeg >= 0 )
+        && ( idSeg < dimSegmentLogged ))
+      {
+         vtIsSegmentLogged[ idSeg ] = false ;
+      } /* if */
+
+   } // End of function: VML $Forget segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Is checkpoint due
+//    Counts the records not yet written as well.
+
+   bool VMC_RedoLog ::
+             IsCheckpointDue( )
+   {
+
+      std::lock_guard< std::mutex > logLock( logMutex ) ;
+
+      return logSize + ( appendedLsn - durableLsn ) > maxLogSize ;
+
+   } // End of function: VML $Is checkpoint due
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Get counters
+
+   void VMC_RedoLog ::
+             GetCounters( int * pNumRecords     ,
+                          int * pNumCommits     ,
+                          int * pNumSyncs       ,
+                          int * pNumCheckpoints ,
+                          long long * pNumBytes  )
+   {
+
+      std::lock_guard< std::mutex > logLock( logMutex ) ;
+
+      *pNumRecords     = totalRecords ;
+      *pNumCommits     = totalCommits ;
+      *pNumSyncs       = totalSyncs ;
+      *pNumCheckpoints = totalCheckpoints ;
+      *pNumBytes       = totalBytes ;
+
+   } // End of function: VML $Get counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Append record
+//    Waits until the active buffer has room, asking for it to be
+//    written if needed.
+
+   long long VMC_RedoLog ::
+             AppendRecord( std::unique_lock< std::mutex > & logLock ,
+                           int kind , int idSeg , long long position ,
+                           int sizeData , const char * pData )
+   {
+
+      const int sizeHeader   = sizeof( VMC_LogRecord ) ;
+      const int sizeChecksum = sizeof( unsigned int ) ;
+      int sizeRecord = sizeHeader + sizeData ;
+
+      while ( sizeActive + sizeRecord > sizeBuffer )
+      {
+         if ( requestedLsn < appendedLsn )
+         {
+            requestedLsn = appendedLsn ;
+            logChanged.notify_all( ) ;
+         } /* if */
+         logChanged.wait( logLock ) ;
+      } /* while */
+
+      char * pRecord = vtBuffer[ inxActive ] + sizeActive ;
+
+      VMC_LogRecord record ;
+      record.checksum  = 0 ;
+      record.kind      = kind ;
+      record.idSegment = idSeg ;
+      record.sizeData  = sizeData ;
+      record.position  = position ;
+
+      memcpy( pRecord , &record , sizeHeader ) ;
+      memcpy( pRecord + sizeHeader , pData , sizeData ) ;
+
+      record.checksum = VMC_VirtualMemoryRoot::GetRoot( )->GetSegmentPageRun( )->
+                ComputeChecksum( pRecord + sizeChecksum ,
+                                 sizeRecord - sizeChecksum ) ;
+      memcpy( pRecord , &record.checksum , sizeChecksum ) ;
+
+      sizeActive  += sizeRecord ;
+      appendedLsn += sizeRecord ;
+
+      return appendedLsn ;
+
+   } // End of function: VML $Append record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Wait until durable
+
+   bool VMC_RedoLog ::
+             WaitDurable( std::unique_lock< std::mutex > & logLock ,
+                          long long lsn )
+   {
+
+      while ( ( durableLsn < lsn )
+           && ( !isFailed ))
+      {
+         logChanged.wait( logLock ) ;
+      } /* while */
+
+      return !isFailed ;
+
+   } // End of function: VML $Wait until durable
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VML $Write batches
+//    Records appended while a batch is written go to the other buffer,
+//    and wait for the next batch. A batch is written when some caller
+//    asks for a record in it, or when the log stops.
+
+   void VMC_RedoLog ::
+             WriteBatches( )
+   {
+
+      std::unique_lock< std::mutex > logLock( logMutex ) ;
+
+      for( ; ; )
+      {
+         while ( ( ( sizeActive == 0 )
+                || ( requestedLsn <= durableLsn ))
+              && ( !isStopping ))
+         {
+            logChanged.wait( logLock ) ;
+         } /* while */
+
+         if ( sizeActive == 0 )
+         {
+            break ;
+         } /* if */
+
+         const char * pBatch = vtBuffer[ inxActive ] ;
+         int sizeBatch       = sizeActive ;
+         long long batchLsn  = appendedLsn ;
+         bool isDiscarded    = isFailed ;
+
+         inxActive  = 1 - inxActive ;
+         sizeActive = 0 ;
+         isWriting  = true ;
+         logLock.unlock( ) ;
+         logChanged.notify_all( ) ;
+
+         bool isWritten = true ;
+
+         if ( !isDiscarded )
+         {
+            int sizeWritten = 0 ;
+            while ( sizeWritten < sizeBatch )
+            {
+               ssize_t numWritten = write( logFile , pBatch + sizeWritten ,
+                         sizeBatch - sizeWritten ) ;
+               if ( numWritten <= 0 )
+               {
+                  isWritten = false ;
+                  break ;
+               } /* if */
+               sizeWritten += numWritten ;
+            } /* while */
+
+            isWritten = isWritten && ( fdatasync( logFile ) == 0 ) ;
+         } /* if */
+
+         logLock.lock( ) ;
+
+         isWriting = false ;
+
+         if ( isDiscarded )
+         {
+            // The batch was dropped, the log stays failed until truncated
+         } else if ( isWritten )
+         {
+            durableLsn  = batchLsn ;
+            logSize    += sizeBatch ;
+            totalBytes += sizeBatch ;
+            totalSyncs ++ ;
+         } else
+         {
+            isFailed = true ;
+         } /* if */
+
+         logChanged.notify_all( ) ;
+      } /* for */
+
+   } // End of function: VML $Write batches
+
+//--- End of class: VML  Redo log
+
+////// End of implementation module: VML  VMREDO Redo log ////
@@ -0,0 +1,261 @@
+#ifndef _VMREDO_
+   #define _VMREDO_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VML  VMREDO Redo log
+//
+// Generated file:    VMREDO.HPP
+//
+// Module identification letters: VML
+// Module identification number:  464
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMREDO.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Logs the changes of the virtual pages, makes them durable with group
+//    commits and forces the log before a page is written. The root redoes
+//    the records left by a previous session when the log is opened.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+   #include  <thread>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported data items -----
+//==========================================================================
+
+
+// VML Redo log record kinds
+
+   static const int LOG_RECORD_SEGMENT = 1 ;
+
+   static const int LOG_RECORD_DATA    = 2 ;
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VML Redo log record header
+//    A header is followed by sizeData bytes. Data records carry the
+//    bytes set at a position of a segment. Segment records carry the
+//    full name of the segment the following data records of idSegment
+//    belong to, since segment ids are not kept across sessions.
+//    The checksum is the CRC32C of the rest of the header and the data.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_LogRecord
+   {
+
+      unsigned int checksum ;
+
+      int kind ;
+
+      int idSegment ;
+
+      int sizeData ;
+
+   // VML Byte position within the segment, page * page size + offset
+
+      long long position ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VML  Redo log
+//    Sequential log of the changes made by SetPageData since the last
+//    checkpoint. Records are appended to the active one of two buffers.
+//    A writer thread swaps the buffers when a commit or a page write
+//    asks for records not yet durable, writes the whole batch and syncs
+//    the log once for it, hence commits arriving while a batch is being
+//    synced share the next sync.
+//    Log sequence numbers are byte counts of the records appended since
+//    the log was opened, truncating the log does not reset them.
+//    Records are appended by the thread using the virtual memory root.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_RedoLog
+   {
+
+   //  Method: VML $Redo log constructor
+   //    Takes over the open log file, which must be empty, and starts
+   //    the writer thread.
+
+      public:
+         VMC_RedoLog( int logFileParm , long long maxLogSizeParm ,
+                      int pageSizeParm )  ;
+
+   //  Method: VML $Redo log destructor
+   //    Makes all records durable, stops the writer thread and closes
+   //    the log file.
+
+      public:
+         ~VMC_RedoLog( )  ;
+
+   //  Method: VML $Append data record
+   //    Waits for the writer thread if the active buffer is full.
+   //    Returns the sequence number the record is durable at.
+
+      public:
+         long long AppendData( int idSeg , long long position ,
+                               int sizeData , const char * pData )  ;
+
+   //  Method: VML $Commit
+   //    Asks for the records appended so far to be made durable, and
+   //    waits until they are if isWait. Returns false if the log failed.
+
+      public:
+         bool Commit( bool isWait )  ;
+
+   //  Method: VML $Force log for a page
+   //    Waits until the records up to pageLsn are durable, before the
+   //    page is written. Throws if the log failed, the page then stays
+   //    dirty, unless a checkpoint writes it.
+
+      public:
+         void ForcePage( long long pageLsn , int idSeg , int idPag )  ;
+
+   //  Method: VML $Set checkpointing
+   //    While a checkpoint writes the dirty pages they are written even
+   //    if the log failed, the checkpoint then empties it.
+
+      public:
+         void SetCheckpointing( bool isOn )  ;
+
+   //  Method: VML $Truncate log
+   //    Makes all records durable, then empties the log file.
+   //    All dirty pages must have been written, hence a failed log is
+   //    cleared. Returns false if the log file cannot be emptied.
+
+      public:
+         bool Truncate( )  ;
+
+   //  Method: VML $Forget segment
+   //    The next record of the segment is preceded by its name again.
+
+      public:
+         void ForgetSegment( int idSeg )  ;
+
+   //  Method: VML $Is checkpoint due
+   //    Returns true if the log has grown beyond its maximum size.
+
+      public:
+         bool IsCheckpointDue( )  ;
+
+   //  Method: VML $Get counters
+
+      public:
+         void GetCounters( int * pNumRecords     ,
+                           int * pNumCommits     ,
+                           int * pNumSyncs       ,
+                           int * pNumCheckpoints ,
+                           long long * pNumBytes  )  ;
+
+   //  Method: VML $Append record
+   //    Must be called holding the log lock.
+
+      private:
+         long long AppendRecord( std::unique_lock< std::mutex > & logLock ,
+                                 int kind , int idSeg , long long position ,
+                                 int sizeData , const char * pData )  ;
+
+   //  Method: VML $Wait until durable
+   //    Must be called holding the log lock. Returns false if the log
+   //    failed.
+
+      private:
+         bool WaitDurable( std::unique_lock< std::mutex > & logLock ,
+                           long long lsn )  ;
+
+   //  Method: VML $Write batches
+   //    Body of the writer thread
+
+      private:
+         void WriteBatches( )  ;
+
+   // VML Log lock and change notification
+   //    Taken before segmentIoMutex whenever both are held.
+
+      private:
+         std::mutex logMutex ;
+         std::condition_variable logChanged ;
+
+   // VML Record buffers
+   //    Records are appended to vtBuffer[ inxActive ], the other buffer
+   //    is the one being written, if any.
+
+      private:
+         char * vtBuffer[ 2 ] ;
+         int sizeBuffer ;
+         int inxActive ;
+         int sizeActive ;
+
+   // VML Log sequence numbers
+   //    appendedLsn ends the records appended, requestedLsn the records
+   //    some caller waits for, durableLsn the records synced.
+
+      private:
+         long long appendedLsn ;
+         long long requestedLsn ;
+         long long durableLsn ;
+
+   // VML Writer thread control
+   //    Once a write fails the log is failed, the following batches are
+   //    discarded.
+
+      private:
+         bool isWriting ;
+         bool isStopping ;
+         bool isFailed ;
+         bool isCheckpointing ;
+         std::thread writerThread ;
+
+   // VML Log file and its size since the last truncation
+
+      private:
+         int logFile ;
+         long long logSize ;
+         long long maxLogSize ;
+
+   // VML Segments whose name has been logged since the last truncation
+   //    Indexed by segment id, grows when larger ids are used.
+
+      private:
+         bool * vtIsSegmentLogged ;
+         int dimSegmentLogged ;
+
+   // VML Counters, guarded by logMutex
+
+      private:
+         int totalRecords ;
+         int totalCommits ;
+         int totalSyncs ;
+         int totalCheckpoints ;
+         long long totalBytes ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VML  VMREDO Redo log ////
@@ -0,0 +1,1354 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMS  VMSEGRUN Segment page run
+//
+//Generated file:        VMSEGRUN.CPP
+//
+//Module identification letters: VMS
+//Module identification number:  458
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMSEGRUN.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+   #include  <stdint.h>
+   #include  <limits.h>
+   #include  <unistd.h>
+   #include  <fcntl.h>
+   #include  <sys/stat.h>
+   #include  <sys/uio.h>
+
+   #if defined( __x86_64__ ) && defined( __GNUC__ )
+      #include  <nmmintrin.h>
+   #elif defined( __aarch64__ ) && defined( __GNUC__ )
+      #include  <arm_acle.h>
+      #if defined( __linux__ )
+         #include  <sys/auxv.h>
+      #endif
+   #endif
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMSEGRUN.hpp"
+
+   #include "exceptn.hpp"
+   #include "message.hpp"
+   #include "msgbin.hpp"
+
+   #include "str_vmc.inc"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VMS CRC32C polynomial, reflected
+
+   static const unsigned int CRC32C_POLYNOMIAL = 0x82F63B78 ;
+
+// VMS Checksum file identifier and name suffix
+
+   static const unsigned int CHECKSUM_FILE_ID = 0x564D4331 ;
+
+   static const char CHECKSUM_FILE_SUFFIX[ ] = ".crc" ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMS  Segment page run
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMS  Segment page run
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Segment page run constructor
+
+   VMC_SegmentPageRun ::
+             VMC_SegmentPageRun( int numSegmentPagesPerPageParm )
+   {
+
+      numSegmentPagesPerPage = numSegmentPagesPerPageParm ;
+      pageSize               = numSegmentPagesPerPage * TAL_PageSize ;
+
+      vtDirectFile               = NULL ;
+      dimDirectFile              = 0 ;
+      totalDirectReadCounter     = 0 ;
+      totalDirectWriteCounter    = 0 ;
+      totalDirectFallbackCounter = 0 ;
+      numDirectReadsInFlight     = 0 ;
+
+      checksumMode                   = VMC_CHECKSUM_OFF ;
+      vtSegmentChecksum              = NULL ;
+      vtDimChecksum                  = NULL ;
+      dimSegmentChecksum             = 0 ;
+      totalChecksumCounter           = 0 ;
+      totalChecksumMismatchCounter   = 0 ;
+      totalChecksumUnverifiedCounter = 0 ;
+      isCrcHardware                  = false ;
+
+      vtIsSegmentWritten = NULL ;
+      dimSegmentWritten  = 0 ;
+      vtWrittenName      = NULL ;
+      numWrittenNames    = 0 ;
+      dimWrittenName     = 0 ;
+
+      BuildChecksumTables( ) ;
+
+   } // End of function: VMS $Segment page run constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Read page run
+//    A mismatch is counted. In VMC_CHECKSUM_FAIL mode the run is read
+//    once more, a torn read is then corrected, and the read fails if the
+//    run still does not match. Otherwise the new checksum is recorded.
+//    A run without a known checksum is counted as unverified.
+
+   void VMC_SegmentPageRun ::
+             ReadRun( int idSeg , int idPag , char * pPageValue ,
+                      std::unique_lock< std::mutex > & ioLock )
+   {
+
+      if ( checksumMode == VMC_CHECKSUM_OFF )
+      {
+         ReadRunValue( idSeg , idPag , pPageValue , ioLock ) ;
+         return ;
+      } /* if */
+
+      ReadRunValue( idSeg , idPag , pPageValue , ioLock ) ;
+
+      unsigned int checksum = ComputeChecksum( pPageValue , pageSize ) ;
+
+      totalChecksumCounter ++ ;
+
+      VMC_PageChecksum * pEntry = GetChecksumEntry( idSeg , idPag , true ) ;
+
+      if ( !pEntry->isKnown )
+      {
+         totalChecksumUnverifiedCounter ++ ;
+
+      } else if ( pEntry->checksum != checksum )
+      {
+         totalChecksumMismatchCounter ++ ;
+
+         if ( checksumMode == VMC_CHECKSUM_FAIL )
+         {
+            ReadRunValue( idSeg , idPag , pPageValue , ioLock ) ;
+            checksum = ComputeChecksum( pPageValue , pageSize ) ;
+
+            if ( pEntry->checksum != checksum )
+            {
+               MSG_Message * pMsg = new MSG_Message( VMC_ErrorPageFrame ) ;
+               pMsg->AddItem( 1 , new MSG_ItemInteger( idSeg )) ;
+               pMsg->AddItem( 2 , new MSG_ItemInteger( idPag )) ;
+               EXC_PROGRAM( pMsg , -1 , TAL_NullIdHelp ) ;
+            } /* if */
+         } /* if */
+      } /* if */
+
+      pEntry->checksum = checksum ;
+      pEntry->isKnown  = true ;
+
+   } // End of function: VMS $Read page run
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Read page run value
+//    The first segment page is always read, hence reading a page beyond
+//    the end of the segment fails as it does with single segment pages.
+//    The lock is released while a direct run is read.
+
+   void VMC_SegmentPageRun ::
+             ReadRunValue( int idSeg , int idPag , char * pPageValue ,
+                           std::unique_lock< std::mutex > & ioLock )
+   {
+
+      SEG_SegmentRoot * pRoot = SEG_SegmentRoot::GetRoot( ) ;
+
+      if ( IsDirectRun( idSeg , pPageValue ))
+      {
+         int numSegmentPages = pRoot->GetSegmentNumPages( idSeg ) ;
+         int idSegmentPage   = idPag * numSegmentPagesPerPage ;
+
+         int numRead = numSegmentPages - idSegmentPage ;
+         if ( numRead > numSegmentPagesPerPage )
+         {
+            numRead = numSegmentPagesPerPage ;
+         } /* if */
+
+         ssize_t sizeRead = -1 ;
+         if ( numRead > 0 )
+         {
+            int fileDescriptor = vtDirectFile[ idSeg ] ;
+            numDirectReadsInFlight ++ ;
+            ioLock.unlock( ) ;
+
+            sizeRead = pread( fileDescriptor , pPageValue ,
+                              ( size_t ) numRead * TAL_PageSize ,
+                              ( off_t ) idSegmentPage * TAL_PageSize ) ;
+
+            ioLock.lock( ) ;
+            numDirectReadsInFlight -- ;
+            if ( numDirectReadsInFlight == 0 )
+            {
+               directReadDone.notify_all( ) ;
+            } /* if */
+         } /* if */
+
+         if ( sizeRead == ( ssize_t ) numRead * TAL_PageSize )
+         {
+            memset( pPageValue + ( size_t ) numRead * TAL_PageSize , VALUE_UNDEFINED ,
+                    ( size_t ) ( numSegmentPagesPerPage - numRead ) * TAL_PageSize ) ;
+            totalDirectReadCounter += numRead ;
+            return ;
+         } /* if */
+
+         totalDirectFallbackCounter ++ ;
+      } /* if */
+
+      if ( numSegmentPagesPerPage == 1 )
+      {
+         pRoot->ReadPage( idSeg , idPag , pPageValue ) ;
+         return ;
+      } /* if */
+
+      int numSegmentPages = pRoot->GetSegmentNumPages( idSeg ) ;
+      int idSegmentPage   = idPag * numSegmentPagesPerPage ;
+
+      for ( int inxRun = 0 ; inxRun < numSegmentPagesPerPage ; inxRun++ )
+      {
+         char * pSegmentPage = pPageValue + inxRun * TAL_PageSize ;
+
+         if ( ( inxRun == 0 )
+           || ( idSegmentPage + inxRun < numSegmentPages ))
+         {
+            pRoot->ReadPage( idSeg , idSegmentPage + inxRun , pSegmentPage ) ;
+         } else
+         {
+            memset( pSegmentPage , VALUE_UNDEFINED , TAL_PageSize ) ;
+         } /* if */
+      } /* for */
+
+   } // End of function: VMS $Read page run value
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Write page run
+//    The checksum is computed before the write, the value may be changed
+//    by its frame once written, and recorded once the write succeeded.
+
+   void VMC_SegmentPageRun ::
+             WriteRun( int idSeg , int idPag , char * pPageValue )
+   {
+
+      if ( checksumMode == VMC_CHECKSUM_OFF )
+      {
+         WriteRunValue( idSeg , idPag , pPageValue ) ;
+         return ;
+      } /* if */
+
+      unsigned int checksum = ComputeChecksum( pPageValue , pageSize ) ;
+
+      WriteRunValue( idSeg , idPag , pPageValue ) ;
+
+      totalChecksumCounter ++ ;
+
+      VMC_PageChecksum * pEntry = GetChecksumEntry( idSeg , idPag , true ) ;
+      pEntry->checksum = checksum ;
+      pEntry->isKnown  = true ;
+
+   } // End of function: VMS $Write page run
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Write adjacent page runs by direct I/O
+//    Runs within the last, partial page of the segment grow it, they are
+//    left to WriteRun. The vector holds at most IOV_MAX runs, longer
+//    sequences take one pwritev per IOV_MAX runs. A short write is
+//    counted as a fallback, the runs are then written anew by WriteRun.
+
+   bool VMC_SegmentPageRun ::
+             WriteDirectRuns( int idSeg , int idPag ,
+                              char * const * vtPageValue ,
+                              int numRuns )
+   {
+
+      if ( !IsDirectWritable( idSeg ))
+      {
+         return false ;
+      } /* if */
+
+      int numSegmentPages = SEG_SegmentRoot::GetRoot( )->GetSegmentNumPages( idSeg ) ;
+      if ( ( idPag + numRuns ) * numSegmentPagesPerPage > numSegmentPages )
+      {
+         return false ;
+      } /* if */
+
+      for ( int inxRun = 0 ; inxRun < numRuns ; inxRun++ )
+      {
+         if ( !IsDirectRun( idSeg , vtPageValue[ inxRun ] ))
+         {
+            return false ;
+         } /* if */
+      } /* for */
+
+      NoteWritten( idSeg ) ;
+
+      unsigned int * vtChecksum = NULL ;
+      if ( checksumMode != VMC_CHECKSUM_OFF )
+      {
+         vtChecksum = new unsigned int[ numRuns ] ;
+         for ( int inxRun = 0 ; inxRun < numRuns ; inxRun++ )
+         {
+            vtChecksum[ inxRun ] = ComputeChecksum( vtPageValue[ inxRun ] , pageSize ) ;
+         } /* for */
+      } /* if */
+
+      // Write the runs, IOV_MAX at a time
+
+         size_t sizeRun = ( size_t ) numSegmentPagesPerPage * TAL_PageSize ;
+
+         struct iovec vtVector[ IOV_MAX ] ;
+
+         bool isWritten = true ;
+         int inxFirst   = 0 ;
+
+         while ( isWritten
+              && ( inxFirst < numRuns ))
+         {
+            int numVector = numRuns - inxFirst ;
+            if ( numVector > IOV_MAX )
+            {
+               numVector = IOV_MAX ;
+            } /* if */
+
+            for ( int inxVector = 0 ; inxVector < numVector ; inxVector++ )
+            {
+               vtVector[ inxVector ].iov_base = vtPageValue[ inxFirst + inxVector ] ;
+               vtVector[ inxVector ].iov_len  = sizeRun ;
+            } /* for */
+
+            isWritten = pwritev( vtDirectFile[ idSeg ] , vtVector , numVector ,
+                                 ( off_t )( idPag + inxFirst ) * ( off_t ) sizeRun )
+                        == ( ssize_t )( sizeRun * numVector ) ;
+
+            inxFirst += numVector ;
+         } /* while */
+
+         if ( !isWritten )
+         {
+            delete [ ] vtChecksum ;
+            totalDirectFallbackCounter ++ ;
+            return false ;
+         } /* if */
+
+         totalDirectWriteCounter += numRuns * numSegmentPagesPerPage ;
+
+      // Record the checksums
+
+         if ( vtChecksum != NULL )
+         {
+            for ( int inxRun = 0 ; inxRun < numRuns ; inxRun++ )
+            {
+               VMC_PageChecksum * pEntry = GetChecksumEntry( idSeg , idPag + inxRun , true ) ;
+               pEntry->checksum = vtChecksum[ inxRun ] ;
+               pEntry->isKnown  = true ;
+            } /* for */
+
+            totalChecksumCounter += numRuns ;
+            delete [ ] vtChecksum ;
+         } /* if */
+
+      return true ;
+
+   } // End of function: VMS $Write adjacent page runs by direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Sync segment in direct I/O mode
+
+   bool VMC_SegmentPageRun ::
+             SyncDirect( int idSeg )
+   {
+
+      return IsDirect( idSeg )
+          && ( fdatasync( vtDirectFile[ idSeg ] ) == 0 ) ;
+
+   } // End of function: VMS $Sync segment in direct I/O mode
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Write page run value
+//    A gap between the end of the segment and the run belongs to the
+//    last, partial page. It is filled with undefined values taken from
+//    the run, the value of that page overwrites them when written.
+
+   void VMC_SegmentPageRun ::
+             WriteRunValue( int idSeg , int idPag , char * pPageValue )
+   {
+
+      SEG_SegmentRoot * pRoot = SEG_SegmentRoot::GetRoot( ) ;
+
+      int numSegmentPages = pRoot->GetSegmentNumPages( idSeg ) ;
+      int idSegmentPage   = idPag * numSegmentPagesPerPage ;
+
+      NoteWritten( idSeg ) ;
+
+      if ( ( idSegmentPage + numSegmentPagesPerPage <= numSegmentPages )
+        && IsDirectWritable( idSeg )
+        && IsDirectRun( idSeg , pPageValue ))
+      {
+         if ( pwrite( vtDirectFile[ idSeg ] , pPageValue ,
+                      ( size_t ) numSegmentPagesPerPage * TAL_PageSize ,
+                      ( off_t ) idSegmentPage * TAL_PageSize )
+              == ( ssize_t ) numSegmentPagesPerPage * TAL_PageSize )
+         {
+            totalDirectWriteCounter += numSegmentPagesPerPage ;
+            return ;
+         } /* if */
+
+         totalDirectFallbackCounter ++ ;
+      } /* if */
+
+      while ( numSegmentPages < idSegmentPage )
+      {
+         pRoot->AddPage( idSeg , pPageValue ) ;
+         numSegmentPages ++ ;
+      } /* while */
+
+      for ( int inxRun = 0 ; inxRun < numSegmentPagesPerPage ; inxRun++ )
+      {
+         char * pSegmentPage = pPageValue + inxRun * TAL_PageSize ;
+
+         if ( idSegmentPage + inxRun < numSegmentPages )
+         {
+            pRoot->WritePage( idSeg , idSegmentPage + inxRun , pSegmentPage ) ;
+         } else
+         {
+            pRoot->AddPage( idSeg , pSegmentPage ) ;
+            numSegmentPages ++ ;
+         } /* if */
+      } /* for */
+
+   } // End of function: VMS $Write page run value
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get number of virtual pages of a segment
+
+   int VMC_SegmentPageRun ::
+             GetNumPages( int idSeg )
+   {
+
+      int numSegmentPages = SEG_SegmentRoot::GetRoot( )->GetSegmentNumPages( idSeg ) ;
+
+      return ( numSegmentPages + numSegmentPagesPerPage - 1 ) / numSegmentPagesPerPage ;
+
+   } // End of function: VMS $Get number of virtual pages of a segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Open segment file
+
+   int VMC_SegmentPageRun ::
+             OpenSegmentFile( int idSeg , int flags )
+   {
+
+      char * fileName = GetFullName( idSeg ) ;
+
+      int fileDescriptor = open( fileName , flags ) ;
+      delete [ ] fileName ;
+
+      return fileDescriptor ;
+
+   } // End of function: VMS $Open segment file
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Is segment file laid out plain
+//    A segment module that keeps a header, or pages in another order,
+//    gives different bytes for one of the pages compared.
+
+   bool VMC_SegmentPageRun ::
+             IsPlainLayout( int idSeg )
+   {
+
+      int numSegmentPages = SEG_SegmentRoot::GetRoot( )->GetSegmentNumPages( idSeg ) ;
+      if ( numSegmentPages <= 0 )
+      {
+         return false ;
+      } /* if */
+
+      int fileDescriptor = OpenSegmentFile( idSeg , O_RDONLY ) ;
+      if ( fileDescriptor < 0 )
+      {
+         return false ;
+      } /* if */
+
+      char * pSegmentPage = new char[ TAL_PageSize ] ;
+      char * pFilePage    = new char[ TAL_PageSize ] ;
+
+      bool isPlain = true ;
+
+      try
+      {
+         int vtIdPage[ 2 ] = { 0 , numSegmentPages - 1 } ;
+         for ( int inxPage = 0 ; isPlain && ( inxPage < 2 ) ; inxPage++ )
+         {
+            SEG_SegmentRoot::GetRoot( )->ReadPage( idSeg , vtIdPage[ inxPage ] ,
+                      pSegmentPage ) ;
+            isPlain = ( pread( fileDescriptor , pFilePage , TAL_PageSize ,
+                               ( off_t ) vtIdPage[ inxPage ] * TAL_PageSize )
+                        == TAL_PageSize )
+                   && ( memcmp( pSegmentPage , pFilePage , TAL_PageSize ) == 0 ) ;
+         } /* for */
+      }
+      catch ( ... )
+      {
+         close( fileDescriptor ) ;
+         delete [ ] pSegmentPage ;
+         delete [ ] pFilePage ;
+         throw ;
+      } // end try catch
+
+      close( fileDescriptor ) ;
+      delete [ ] pSegmentPage ;
+      delete [ ] pFilePage ;
+
+      return isPlain ;
+
+   } // End of function: VMS $Is segment file laid out plain
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Open segment for direct I/O
+//    The file is opened read only if the segment is, writes to a read
+//    only segment then fall back and fail in the segment module.
+//    A file the segment module does not lay out plain is refused.
+
+   bool VMC_SegmentPageRun ::
+             OpenDirect( int idSeg )
+   {
+
+      if ( IsDirect( idSeg ))
+      {
+         return true ;
+      } /* if */
+
+      if ( ( ( TAL_PageSize % DIRECT_IO_ALIGNMENT ) != 0 )
+        || !IsPlainLayout( idSeg ))
+      {
+         return false ;
+      } /* if */
+
+      int flags = O_RDWR ;
+      if ( SEG_SegmentRoot::GetRoot( )->GetSegmentOpeningMode( idSeg ) ==
+                TAL_OpeningModeRead )
+      {
+         flags = O_RDONLY ;
+      } /* if */
+
+      int fileDescriptor = OpenSegmentFile( idSeg , flags | O_DIRECT ) ;
+      if ( fileDescriptor < 0 )
+      {
+         return false ;
+      } /* if */
+
+      if ( idSeg >= dimDirectFile )
+      {
+         int dimFile = ( dimDirectFile > 0 ) ? 2 * dimDirectFile : 8 ;
+         while ( dimFile <= idSeg )
+         {
+            dimFile *= 2 ;
+         } /* while */
+
+         int * vtFile = new int[ dimFile ] ;
+         for ( int inxFile = 0 ; inxFile < dimFile ; inxFile++ )
+         {
+            vtFile[ inxFile ] = ( inxFile < dimDirectFile ) ?
+                      vtDirectFile[ inxFile ] : -1 ;
+         } /* for */
+
+         delete [ ] vtDirectFile ;
+         vtDirectFile  = vtFile ;
+         dimDirectFile = dimFile ;
+      } /* if */
+
+      vtDirectFile[ idSeg ] = fileDescriptor ;
+
+      return true ;
+
+   } // End of function: VMS $Open segment for direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Close segment for direct I/O
+
+   void VMC_SegmentPageRun ::
+             CloseDirect( int idSeg )
+   {
+
+      if ( IsDirect( idSeg ))
+      {
+         while ( numDirectReadsInFlight > 0 )
+         {
+            directReadDone.wait( segmentIoMutex ) ;
+         } /* while */
+
+         close( vtDirectFile[ idSeg ] ) ;
+         vtDirectFile[ idSeg ] = -1 ;
+      } /* if */
+
+   } // End of function: VMS $Close segment for direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Close all segments for direct I/O
+
+   void VMC_SegmentPageRun ::
+             CloseAllDirect( )
+   {
+
+      for ( int idSeg = 0 ; idSeg < dimDirectFile ; idSeg++ )
+      {
+         CloseDirect( idSeg ) ;
+      } /* for */
+
+      delete [ ] vtDirectFile ;
+      vtDirectFile  = NULL ;
+      dimDirectFile = 0 ;
+
+      totalDirectReadCounter     = 0 ;
+      totalDirectWriteCounter    = 0 ;
+      totalDirectFallbackCounter = 0 ;
+
+   } // End of function: VMS $Close all segments for direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Sync segments written
+//    Each file is reopened by its full name, a sync through any
+//    descriptor also covers the direct writes. A segment that cannot be
+//    synced is kept for the next sync.
+
+   bool VMC_SegmentPageRun ::
+             SyncWrittenSegments( )
+   {
+
+      for ( int idSeg = 0 ; idSeg < dimSegmentWritten ; idSeg++ )
+      {
+         vtIsSegmentWritten[ idSeg ] = false ;
+      } /* for */
+
+      int numKept = 0 ;
+
+      for ( int inxName = 0 ; inxName < numWrittenNames ; inxName++ )
+      {
+         int fileDescriptor = open( vtWrittenName[ inxName ] , O_RDONLY ) ;
+
+         bool isSynced = ( fileDescriptor >= 0 )
+                      && ( fdatasync( fileDescriptor ) == 0 ) ;
+
+         if ( fileDescriptor >= 0 )
+         {
+            close( fileDescriptor ) ;
+         } /* if */
+
+         if ( isSynced )
+         {
+            delete [ ] vtWrittenName[ inxName ] ;
+         } else
+         {
+            vtWrittenName[ numKept ] = vtWrittenName[ inxName ] ;
+            numKept ++ ;
+         } /* if */
+      } /* for */
+
+      numWrittenNames = numKept ;
+
+      return numKept == 0 ;
+
+   } // End of function: VMS $Sync segments written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Forget segment written
+
+   void VMC_SegmentPageRun ::
+             ForgetWritten( int idSeg )
+   {
+
+      if ( ( idSeg >= 0 ) && ( idSeg < dimSegmentWritten ))
+      {
+         vtIsSegmentWritten[ idSeg ] = false ;
+      } /* if */
+
+   } // End of function: VMS $Forget segment written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Forget all segments written
+
+   void VMC_SegmentPageRun ::
+             ForgetAllWritten( )
+   {
+
+      for ( int inxName = 0 ; inxName < numWrittenNames ; inxName++ )
+      {
+         delete [ ] vtWrittenName[ inxName ] ;
+      } /* for */
+
+      delete [ ] vtWrittenName ;
+      vtWrittenName   = NULL ;
+      numWrittenNames = 0 ;
+      dimWrittenName  = 0 ;
+
+      delete [ ] vtIsSegmentWritten ;
+      vtIsSegmentWritten = NULL ;
+      dimSegmentWritten  = 0 ;
+
+   } // End of function: VMS $Forget all segments written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Note segment written
+//    Noted before the write, a write that fails halfway may still have
+//    changed the file. A name kept by a failed sync is not added again.
+
+   void VMC_SegmentPageRun ::
+             NoteWritten( int idSeg )
+   {
+
+      if ( ( idSeg < dimSegmentWritten ) && vtIsSegmentWritten[ idSeg ] )
+      {
+         return ;
+      } /* if */
+
+      if ( idSeg >= dimSegmentWritten )
+      {
+         int dimWritten = ( dimSegmentWritten > 0 ) ? 2 * dimSegmentWritten : 8 ;
+         while ( dimWritten <= idSeg )
+         {
+            dimWritten *= 2 ;
+         } /* while */
+
+         bool * vtIsWritten = new bool[ dimWritten ] ;
+         for ( int inxWritten = 0 ; inxWritten < dimWritten ; inxWritten++ )
+         {
+            vtIsWritten[ inxWritten ] = ( inxWritten < dimSegmentWritten ) &&
+                      vtIsSegmentWritten[ inxWritten ] ;
+         } /* for */
+
+         delete [ ] vtIsSegmentWritten ;
+         vtIsSegmentWritten = vtIsWritten ;
+         dimSegmentWritten  = dimWritten ;
+      } /* if */
+
+      if ( numWrittenNames >= dimWrittenName )
+      {
+         int dimName = ( dimWrittenName > 0 ) ? 2 * dimWrittenName : 8 ;
+
+         char ** vtName = new char * [ dimName ] ;
+         for ( int inxName = 0 ; inxName < numWrittenNames ; inxName++ )
+         {
+            vtName[ inxName ] = vtWrittenName[ inxName ] ;
+         } /* for */
+
+         delete [ ] vtWrittenName ;
+         vtWrittenName  = vtName ;
+         dimWrittenName = dimName ;
+      } /* if */
+
+      vtIsSegmentWritten[ idSeg ] = true ;
+
+      char * fileName = GetFullName( idSeg ) ;
+
+      for ( int inxName = 0 ; inxName < numWrittenNames ; inxName++ )
+      {
+         if ( strcmp( vtWrittenName[ inxName ] , fileName ) == 0 )
+         {
+            delete [ ] fileName ;
+            return ;
+         } /* if */
+      } /* for */
+
+      vtWrittenName[ numWrittenNames ] = fileName ;
+      numWrittenNames ++ ;
+
+   } // End of function: VMS $Note segment written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get segment full name
+
+   char * VMC_SegmentPageRun ::
+             GetFullName( int idSeg )
+   {
+
+      STR_String * pFileName = SEG_SegmentRoot::GetRoot( )->GetSegmentFullName( idSeg ) ;
+
+      char * fileName = new char[ pFileName->GetLength( ) + 1 ] ;
+      memcpy( fileName , pFileName->GetString( ) , pFileName->GetLength( )) ;
+      fileName[ pFileName->GetLength( ) ] = 0 ;
+      delete pFileName ;
+
+      return fileName ;
+
+   } // End of function: VMS $Get segment full name
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Is segment in direct I/O mode
+
+   bool VMC_SegmentPageRun ::
+             IsDirect( int idSeg )
+   {
+
+      return ( idSeg >= 0 )
+          && ( idSeg < dimDirectFile )
+          && ( vtDirectFile[ idSeg ] >= 0 ) ;
+
+   } // End of function: VMS $Is segment in direct I/O mode
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get direct I/O counters
+
+   void VMC_SegmentPageRun ::
+             GetDirectCounters( int * pNumSegments ,
+                                int * pNumReads    ,
+                                int * pNumWrites   ,
+                                int * pNumFallbacks )
+   {
+
+      *pNumSegments = 0 ;
+      for ( int idSeg = 0 ; idSeg < dimDirectFile ; idSeg++ )
+      {
+         if ( vtDirectFile[ idSeg ] >= 0 )
+         {
+            ( *pNumSegments ) ++ ;
+         } /* if */
+      } /* for */
+
+      *pNumReads     = totalDirectReadCounter ;
+      *pNumWrites    = totalDirectWriteCounter ;
+      *pNumFallbacks = totalDirectFallbackCounter ;
+
+   } // End of function: VMS $Get direct I/O counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Is run transferable by direct I/O
+//    Offsets and lengths are multiples of TAL_PageSize, which OpenDirect
+//    requires to be aligned, hence only the buffer must be checked.
+
+   bool VMC_SegmentPageRun ::
+             IsDirectRun( int idSeg , char * pPageValue )
+   {
+
+      return IsDirect( idSeg )
+          && ( ( reinterpret_cast< uintptr_t >( pPageValue ) %
+                 DIRECT_IO_ALIGNMENT ) == 0 ) ;
+
+   } // End of function: VMS $Is run transferable by direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Is segment writable by direct I/O
+
+   bool VMC_SegmentPageRun ::
+             IsDirectWritable( int idSeg )
+   {
+
+      return IsDirect( idSeg )
+          && ( SEG_SegmentRoot::GetRoot( )->GetSegmentOpeningMode( idSeg ) !=
+               TAL_OpeningModeRead ) ;
+
+   } // End of function: VMS $Is segment writable by direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Set checksum mode
+
+   void VMC_SegmentPageRun ::
+             SetChecksumMode( VMC_tpChecksumMode mode )
+   {
+
+      if ( mode == VMC_CHECKSUM_OFF )
+      {
+         for ( int idSeg = 0 ; idSeg < dimSegmentChecksum ; idSeg++ )
+         {
+            ForgetChecksums( idSeg ) ;
+         } /* for */
+      } /* if */
+
+      checksumMode = mode ;
+
+   } // End of function: VMS $Set checksum mode
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Build checksum tables
+
+   void VMC_SegmentPageRun ::
+             BuildChecksumTables( )
+   {
+
+      for ( int inxByte = 0 ; inxByte < 256 ; inxByte++ )
+      {
+         unsigned int crc = inxByte ;
+         for ( int inxBit = 0 ; inxBit < 8 ; inxBit++ )
+         {
+            crc = ( crc >> 1 ) ^ ( ( crc & 1 ) ? CRC32C_POLYNOMIAL : 0 ) ;
+         } /* for */
+         vtCrcTable[ 0 ][ inxByte ] = crc ;
+      } /* for */
+
+      for ( int inxByte = 0 ; inxByte < 256 ; inxByte++ )
+      {
+         for ( int inxTable = 1 ; inxTable < 8 ; inxTable++ )
+         {
+            unsigned int crc = vtCrcTable[ inxTable - 1 ][ inxByte ] ;
+            vtCrcTable[ inxTable ][ inxByte ] = ( crc >> 8 ) ^
+                      vtCrcTable[ 0 ][ crc & 0xFF ] ;
+         } /* for */
+      } /* for */
+
+   #if defined( __x86_64__ ) && defined( __GNUC__ )
+      isCrcHardware = __builtin_cpu_supports( "sse4.2" ) ;
+   #elif defined( __aarch64__ ) && defined( __GNUC__ ) && defined( __linux__ )
+      isCrcHardware = ( getauxval( AT_HWCAP ) & HWCAP_CRC32 ) != 0 ;
+   #elif defined( __aarch64__ ) && defined( __ARM_FEATURE_CRC32 )
+      isCrcHardware = true ;
+   #endif
+
+   } // End of function: VMS $Build checksum tables
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Forget checksums of a segment
+
+   void VMC_SegmentPageRun ::
+             ForgetChecksums( int idSeg )
+   {
+
+      if ( ( idSeg >= 0 )
+        && ( idSeg < dimSegmentChecksum ))
+      {
+         SaveChecksums( idSeg ) ;
+
+         delete [ ] vtSegmentChecksum[ idSeg ] ;
+         vtSegmentChecksum[ idSeg ] = NULL ;
+         vtDimChecksum[ idSeg ]     = 0 ;
+      } /* if */
+
+   } // End of function: VMS $Forget checksums of a segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Forget all checksums
+
+   void VMC_SegmentPageRun ::
+             ForgetAllChecksums( )
+   {
+
+      for ( int idSeg = 0 ; idSeg < dimSegmentChecksum ; idSeg++ )
+      {
+         ForgetChecksums( idSeg ) ;
+      } /* for */
+
+      delete [ ] vtSegmentChecksum ;
+      delete [ ] vtDimChecksum ;
+      vtSegmentChecksum  = NULL ;
+      vtDimChecksum      = NULL ;
+      dimSegmentChecksum = 0 ;
+
+      checksumMode                   = VMC_CHECKSUM_OFF ;
+      totalChecksumCounter           = 0 ;
+      totalChecksumMismatchCounter   = 0 ;
+      totalChecksumUnverifiedCounter = 0 ;
+
+   } // End of function: VMS $Forget all checksums
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get checksum counters
+
+   void VMC_SegmentPageRun ::
+             GetChecksumCounters( int * pNumPages      ,
+                                  int * pNumMismatches ,
+                                  int * pNumUnverified  )
+   {
+
+      *pNumPages      = totalChecksumCounter ;
+      *pNumMismatches = totalChecksumMismatchCounter ;
+      *pNumUnverified = totalChecksumUnverifiedCounter ;
+
+   } // End of function: VMS $Get checksum counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get checksum entry of a page
+
+   VMC_PageChecksum * VMC_SegmentPageRun ::
+             GetChecksumEntry( int idSeg , int idPag , bool isCreate )
+   {
+
+      if ( idSeg >= dimSegmentChecksum )
+      {
+         if ( !isCreate )
+         {
+            return NULL ;
+         } /* if */
+
+         int dimSegment = ( dimSegmentChecksum > 0 ) ? 2 * dimSegmentChecksum : 8 ;
+         while ( dimSegment <= idSeg )
+         {
+            dimSegment *= 2 ;
+         } /* while */
+
+         VMC_PageChecksum ** vtSegment = new VMC_PageChecksum * [ dimSegment ] ;
+         int * vtDim = new int[ dimSegment ] ;
+         for ( int inxSegment = 0 ; inxSegment < dimSegment ; inxSegment++ )
+         {
+            if ( inxSegment < dimSegmentChecksum )
+            {
+               vtSegment[ inxSegment ] = vtSegmentChecksum[ inxSegment ] ;
+               vtDim[ inxSegment ]     = vtDimChecksum[ inxSegment ] ;
+            } else
+            {
+               vtSegment[ inxSegment ] = NULL ;
+               vtDim[ inxSegment ]     = 0 ;
+            } /* if */
+         } /* for */
+
+         delete [ ] vtSegmentChecksum ;
+         delete [ ] vtDimChecksum ;
+         vtSegmentChecksum  = vtSegment ;
+         vtDimChecksum      = vtDim ;
+         dimSegmentChecksum = dimSegment ;
+      } /* if */
+
+      if ( ( vtSegmentChecksum[ idSeg ] == NULL )
+        && isCreate )
+      {
+         LoadChecksums( idSeg ) ;
+      } /* if */
+
+      if ( idPag >= vtDimChecksum[ idSeg ] )
+      {
+         if ( !isCreate )
+         {
+            return NULL ;
+         } /* if */
+
+         int dimPage = ( vtDimChecksum[ idSeg ] > 0 ) ? 2 * vtDimChecksum[ idSeg ] : 64 ;
+         while ( dimPage <= idPag )
+         {
+            dimPage *= 2 ;
+         } /* while */
+
+         VMC_PageChecksum * vtEntry = new VMC_PageChecksum[ dimPage ] ;
+         for ( int inxPage = 0 ; inxPage < dimPage ; inxPage++ )
+         {
+            if ( inxPage < vtDimChecksum[ idSeg ] )
+            {
+               vtEntry[ inxPage ] = vtSegmentChecksum[ idSeg ][ inxPage ] ;
+            } else
+            {
+               vtEntry[ inxPage ].checksum = 0 ;
+               vtEntry[ inxPage ].isKnown  = false ;
+            } /* if */
+         } /* for */
+
+         delete [ ] vtSegmentChecksum[ idSeg ] ;
+         vtSegmentChecksum[ idSeg ] = vtEntry ;
+         vtDimChecksum[ idSeg ]     = dimPage ;
+      } /* if */
+
+      return &vtSegmentChecksum[ idSeg ][ idPag ] ;
+
+   } // End of function: VMS $Get checksum entry of a page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Load checksums of a segment
+//    A file of another page size, or written before the segment file
+//    last changed, is ignored. Its checksums would then be mismatches.
+
+   void VMC_SegmentPageRun ::
+             LoadChecksums( int idSeg )
+   {
+
+      char * segmentName = GetFullName( idSeg ) ;
+      struct stat segmentStatus ;
+      int result = stat( segmentName , &segmentStatus ) ;
+      delete [ ] segmentName ;
+
+      if ( result != 0 )
+      {
+         return ;
+      } /* if */
+
+      char * checksumName = GetChecksumFileName( idSeg ) ;
+      int fileDescriptor = open( checksumName , O_RDONLY ) ;
+      delete [ ] checksumName ;
+
+      if ( fileDescriptor < 0 )
+      {
+         return ;
+      } /* if */
+
+      VMC_ChecksumFileHeader header ;
+      VMC_PageChecksum * vtEntry = NULL ;
+
+      if ( ( pread( fileDescriptor , &header , sizeof( header ) , 0 )
+             == ( ssize_t ) sizeof( header ))
+        && ( header.idFile          == CHECKSUM_FILE_ID )
+        && ( header.pageSize        == pageSize )
+        && ( header.numPages        >  0 )
+        && ( header.sizeSegmentFile == segmentStatus.st_size )
+        && ( header.timeModified    ==
+                  segmentStatus.st_mtim.tv_sec * 1000000000LL +
+                  segmentStatus.st_mtim.tv_nsec ))
+      {
+         size_t sizeEntries = ( size_t ) header.numPages * sizeof( VMC_PageChecksum ) ;
+         vtEntry = new VMC_PageChecksum[ header.numPages ] ;
+
+         if ( pread( fileDescriptor , vtEntry , sizeEntries , sizeof( header ))
+              != ( ssize_t ) sizeEntries )
+         {
+            delete [ ] vtEntry ;
+            vtEntry = NULL ;
+         } /* if */
+      } /* if */
+
+      close( fileDescriptor ) ;
+
+      if ( vtEntry != NULL )
+      {
+         vtSegmentChecksum[ idSeg ] = vtEntry ;
+         vtDimChecksum[ idSeg ]     = header.numPages ;
+      } /* if */
+
+   } // End of function: VMS $Load checksums of a segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Save checksums of a segment
+//    A file left short by a failed write is ignored when loaded.
+
+   void VMC_SegmentPageRun ::
+             SaveChecksums( int idSeg )
+   {
+
+      if ( vtSegmentChecksum[ idSeg ] == NULL )
+      {
+         return ;
+      } /* if */
+
+      char * segmentName = GetFullName( idSeg ) ;
+      struct stat segmentStatus ;
+      int result = stat( segmentName , &segmentStatus ) ;
+      delete [ ] segmentName ;
+
+      if ( result != 0 )
+      {
+         return ;
+      } /* if */
+
+      VMC_ChecksumFileHeader header ;
+      memset( &header , 0 , sizeof( header )) ;
+      header.idFile          = CHECKSUM_FILE_ID ;
+      header.pageSize        = pageSize ;
+      header.numPages        = vtDimChecksum[ idSeg ] ;
+      header.sizeSegmentFile = segmentStatus.st_size ;
+      header.timeModified    = segmentStatus.st_mtim.tv_sec * 1000000000LL +
+                               segmentStatus.st_mtim.tv_nsec ;
+
+      char * checksumName = GetChecksumFileName( idSeg ) ;
+      int fileDescriptor = open( checksumName , O_WRONLY | O_CREAT | O_TRUNC , 0644 ) ;
+
+      if ( fileDescriptor >= 0 )
+      {
+         struct iovec vtVector[ 2 ] ;
+         vtVector[ 0 ].iov_base = &header ;
+         vtVector[ 0 ].iov_len  = sizeof( header ) ;
+         vtVector[ 1 ].iov_base = vtSegmentChecksum[ idSeg ] ;
+         vtVector[ 1 ].iov_len  = ( size_t ) header.numPages * sizeof( VMC_PageChecksum ) ;
+
+         if ( pwritev( fileDescriptor , vtVector , 2 , 0 ) !=
+              ( ssize_t ) ( vtVector[ 0 ].iov_len + vtVector[ 1 ].iov_len ))
+         {
+            ftruncate( fileDescriptor , 0 ) ;
+         } /* if */
+
+         close( fileDescriptor ) ;
+      } /* if */
+
+      delete [ ] checksumName ;
+
+   } // End of function: VMS $Save checksums of a segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Get checksum file name
+
+   char * VMC_SegmentPageRun ::
+             GetChecksumFileName( int idSeg )
+   {
+
+      char * segmentName = GetFullName( idSeg ) ;
+      size_t sizeName = strlen( segmentName ) ;
+
+      char * checksumName = new char[ sizeName + sizeof( CHECKSUM_FILE_SUFFIX ) ] ;
+      memcpy( checksumName , segmentName , sizeName ) ;
+      memcpy( checksumName + sizeName , CHECKSUM_FILE_SUFFIX ,
+              sizeof( CHECKSUM_FILE_SUFFIX )) ;
+      delete [ ] segmentName ;
+
+      return checksumName ;
+
+   } // End of function: VMS $Get checksum file name
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Compute checksum
+
+   unsigned int VMC_SegmentPageRun ::
+             ComputeChecksum( const char * pValue , size_t size )
+   {
+
+      const unsigned char * pByte = reinterpret_cast< const unsigned char * >( pValue ) ;
+
+      if ( isCrcHardware )
+      {
+         return ~ComputeChecksumHardware( ~0U , pByte , size ) ;
+      } /* if */
+
+      return ~ComputeChecksumTable( ~0U , pByte , size ) ;
+
+   } // End of function: VMS $Compute checksum
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Compute checksum with tables
+//    Slicing by 8, one lookup in each table per byte of a step.
+
+   unsigned int VMC_SegmentPageRun ::
+             ComputeChecksumTable( unsigned int crc ,
+                                   const unsigned char * pValue ,
+                                   size_t size )
+   {
+
+      while ( size >= 8 )
+      {
+         unsigned int low  = crc ^ ( pValue[ 0 ]         | ( pValue[ 1 ] << 8 ) |
+                                   ( pValue[ 2 ] << 16 ) | ( ( unsigned int ) pValue[ 3 ] << 24 )) ;
+         unsigned int high =         pValue[ 4 ]         | ( pValue[ 5 ] << 8 ) |
+                                   ( pValue[ 6 ] << 16 ) | ( ( unsigned int ) pValue[ 7 ] << 24 ) ;
+
+         crc = vtCrcTable[ 7 ][   low          & 0xFF ] ^
+               vtCrcTable[ 6 ][ ( low  >>  8 ) & 0xFF ] ^
+               vtCrcTable[ 5 ][ ( low  >> 16 ) & 0xFF ] ^
+               vtCrcTable[ 4 ][   low  >> 24          ] ^
+               vtCrcTable[ 3 ][   high         & 0xFF ] ^
+               vtCrcTable[ 2 ][ ( high >>  8 ) & 0xFF ] ^
+               vtCrcTable[ 1 ][ ( high >> 16 ) & 0xFF ] ^
+               vtCrcTable[ 0 ][   high >> 24          ] ;
+
+         pValue += 8 ;
+         size   -= 8 ;
+      } /* while */
+
+      while ( size > 0 )
+      {
+         crc = ( crc >> 8 ) ^ vtCrcTable[ 0 ][ ( crc ^ *pValue ) & 0xFF ] ;
+         pValue ++ ;
+         size   -- ;
+      } /* while */
+
+      return crc ;
+
+   } // End of function: VMS $Compute checksum with tables
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMS $Compute checksum with CRC instructions
+//    Only called if SetChecksumMode found the instructions. The function
+//    is compiled for them whatever the target, on Linux on ARMv8 the
+//    processor reports them in the auxiliary vector.
+
+#if defined( __x86_64__ ) && defined( __GNUC__ )
+   __attribute__(( target( "sse4.2" )))
+#elif defined( __aarch64__ ) && defined( __GNUC__ )
+   __attribute__(( target( "+crc" )))
+#endif
+   unsigned int VMC_SegmentPageRun ::
+             ComputeChecksumHardware( unsigned int crc ,
+                                      const unsigned char * pValue ,
+                                      size_t size )
+   {
+
+   #if defined( __x86_64__ ) && defined( __GNUC__ )
+
+      unsigned long long crcLong = crc ;
+      while ( size >= 8 )
+      {
+         unsigned long long value ;
+         memcpy( &value , pValue , 8 ) ;
+         crcLong = _mm_crc32_u64( crcLong , value ) ;
+         pValue += 8 ;
+         size   -= 8 ;
+      } /* while */
+
+      crc = static_cast< unsigned int >( crcLong ) ;
+      while ( size > 0 )
+      {
+         crc = _mm_crc32_u8( crc , *pValue ) ;
+         pValue ++ ;
+         size   -- ;
+      } /* while */
+
+      return crc ;
+
+   #elif defined( __aarch64__ ) && defined( __GNUC__ )
+
+      while ( size >= 8 )
+      {
+         unsigned long long value ;
+         memcpy( &value , pValue , 8 ) ;
+         crc = __crc32cd( crc , value ) ;
+         pValue += 8 ;
+         size   -= 8 ;
+      } /* while */
+
+      while ( size > 0 )
+      {
+         crc = __crc32cb( crc , *pValue ) ;
+         pValue ++ ;
+         size   -- ;
+      } /* while */
+
+      return crc ;
+
+   #else
+
+      return ComputeChecksumTable( crc , pValue , size ) ;
+
+   #endif
+
+   } // End of function: VMS $Compute checksum with CRC instructions
+
+//--- End of class: VMS  Segment page run
+
+////// End of implementation module: VMS  VMSEGRUN Segment page run ////
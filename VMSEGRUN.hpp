@@ -0,0 +1,398 @@
+#ifndef _VMSEGRUN_
+   #define _VMSEGRUN_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMS  VMSEGRUN Segment page run
+//
+// Generated file:    VMSEGRUN.HPP
+//
+// Module identification letters: VMS
+// Module identification number:  458
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMSEGRUN.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Transfers the virtual pages of the virtual memory root to and from
+//    the segments, as runs of consecutive segment pages. Segments may be
+//    transferred by direct I/O, and the transfers verified by checksums.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+//    The checksum of a page is known once the page is written, or loaded
+//    from the checksum file of its segment. A page read while its
+//    checksum is unknown cannot be verified: the read is counted as
+//    unverified and its checksum recorded, hence a page corrupted before
+//    that read is accepted, and its corrupted value verifies the later
+//    reads.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <stddef.h>
+   #include  <mutex>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMS Page checksum
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_PageChecksum
+   {
+
+      unsigned int checksum ;
+
+      bool isKnown ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMS Checksum file header
+//    The checksum file of a segment holds this header followed by
+//    numPages page checksums. It is valid while the segment file has
+//    the size and modification time recorded.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_ChecksumFileHeader
+   {
+
+      unsigned int idFile ;
+
+      int pageSize ;
+
+      int numPages ;
+
+      long long sizeSegmentFile ;
+
+      long long timeModified ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMS  Segment page run
+//    Transfers a virtual page as the run of consecutive segment pages
+//    it consists of. The root owns one, built for its page size.
+//    Segment pages of the run beyond the end of the segment are
+//    undefined when read, and appended when written.
+//    Segments in direct I/O mode are transferred with one pread or
+//    pwrite of the whole run on a file opened with O_DIRECT. Runs that
+//    cannot, unaligned buffers, appends and refused transfers, go
+//    through the segment module.
+//    When checksums are on, the CRC32C of every run written or read for
+//    the first time is recorded, and runs read later are verified. A
+//    first read is counted as unverified.
+//    The caller must hold segmentIoMutex. Direct runs are read with it
+//    released, hence reads of several threads overlap.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_SegmentPageRun
+   {
+
+   //  Method: VMS $Segment page run constructor
+
+      public:
+         VMC_SegmentPageRun( int numSegmentPagesPerPageParm )  ;
+
+   //  Method: VMS $Read page run
+
+      public:
+         void ReadRun( int idSeg , int idPag , char * pPageValue ,
+                       std::unique_lock< std::mutex > & ioLock )  ;
+
+   //  Method: VMS $Write page run
+
+      public:
+         void WriteRun( int idSeg , int idPag , char * pPageValue )  ;
+
+   //  Method: VMS $Write adjacent page runs by direct I/O
+   //    Writes the numRuns runs of the pages following idPag with one
+   //    pwritev. Returns false if the runs cannot be written by direct
+   //    I/O, the caller then writes them one by one.
+
+      public:
+         bool WriteDirectRuns( int idSeg , int idPag ,
+                               char * const * vtPageValue ,
+                               int numRuns )  ;
+
+   //  Method: VMS $Sync segment in direct I/O mode
+   //    Returns false if the sync fails.
+
+      public:
+         bool SyncDirect( int idSeg )  ;
+
+   //  Method: VMS $Get number of virtual pages of a segment
+   //    A partial run at the end of the segment counts as a page.
+
+      public:
+         int GetNumPages( int idSeg )  ;
+
+   //  Method: VMS $Open segment file
+   //    Returns the file descriptor, -1 if the file cannot be opened.
+
+      public:
+         int OpenSegmentFile( int idSeg , int flags )  ;
+
+   //  Method: VMS $Is segment file laid out plain
+   //    Returns true if the first and the last page read through the
+   //    segment module match the file bytes at i * TAL_PageSize.
+
+      public:
+         bool IsPlainLayout( int idSeg )  ;
+
+   //  Method: VMS $Open segment for direct I/O
+   //    Returns false if the file system refuses O_DIRECT.
+
+      public:
+         bool OpenDirect( int idSeg )  ;
+
+   //  Method: VMS $Close segment for direct I/O
+   //    Waits until no direct read is in flight.
+
+      public:
+         void CloseDirect( int idSeg )  ;
+
+   //  Method: VMS $Close all segments for direct I/O
+   //    Also clears the counters.
+
+      public:
+         void CloseAllDirect( )  ;
+
+   //  Method: VMS $Sync segments written
+   //    Makes the pages written since the last sync durable.
+   //    Returns false if a segment file cannot be synced.
+
+      public:
+         bool SyncWrittenSegments( )  ;
+
+   //  Method: VMS $Forget segment written
+   //    The segment is still synced by its full name.
+
+      public:
+         void ForgetWritten( int idSeg )  ;
+
+   //  Method: VMS $Forget all segments written
+
+      public:
+         void ForgetAllWritten( )  ;
+
+   //  Method: VMS $Note segment written
+
+      private:
+         void NoteWritten( int idSeg )  ;
+
+   //  Method: VMS $Get segment full name
+   //    Returns a zero terminated copy the caller deletes.
+
+      private:
+         char * GetFullName( int idSeg )  ;
+
+   //  Method: VMS $Is segment in direct I/O mode
+
+      public:
+         bool IsDirect( int idSeg )  ;
+
+   //  Method: VMS $Get direct I/O counters
+
+      public:
+         void GetDirectCounters( int * pNumSegments ,
+                                 int * pNumReads    ,
+                                 int * pNumWrites   ,
+                                 int * pNumFallbacks )  ;
+
+   //  Method: VMS $Is run transferable by direct I/O
+
+      private:
+         bool IsDirectRun( int idSeg , char * pPageValue )  ;
+
+   //  Method: VMS $Is segment writable by direct I/O
+   //    Pages of a read only segment are written through the segment
+   //    module, which refuses them.
+
+      private:
+         bool IsDirectWritable( int idSeg )  ;
+
+   //  Method: VMS $Read page run value
+   //    Reads the run without checksums
+
+      private:
+         void ReadRunValue( int idSeg , int idPag , char * pPageValue ,
+                            std::unique_lock< std::mutex > & ioLock )  ;
+
+   //  Method: VMS $Write page run value
+   //    Writes the run without checksums
+
+      private:
+         void WriteRunValue( int idSeg , int idPag , char * pPageValue )  ;
+
+   //  Method: VMS $Set checksum mode
+   //    Checksums recorded so far are forgotten when they are turned off.
+
+      public:
+         void SetChecksumMode( VMC_tpChecksumMode mode )  ;
+
+   //  Method: VMS $Build checksum tables
+   //    Builds the tables and detects the CRC instructions.
+
+      private:
+         void BuildChecksumTables( )  ;
+
+   //  Method: VMS $Forget checksums of a segment
+   //    Saves them in the checksum file of the segment first.
+
+      public:
+         void ForgetChecksums( int idSeg )  ;
+
+   //  Method: VMS $Forget all checksums
+   //    Also clears the counters.
+
+      public:
+         void ForgetAllChecksums( )  ;
+
+   //  Method: VMS $Get checksum counters
+
+      public:
+         void GetChecksumCounters( int * pNumPages      ,
+                                   int * pNumMismatches ,
+                                   int * pNumUnverified  )  ;
+
+   //  Method: VMS $Compute checksum
+   //    CRC32C, computed with the SSE4.2 or ARMv8 CRC instructions if the
+   //    processor has them, otherwise with tables.
+
+      public:
+         unsigned int ComputeChecksum( const char * pValue , size_t size )  ;
+
+   //  Method: VMS $Get checksum entry of a page
+   //    Returns NULL if the segment has no entry for the page, unless
+   //    isCreate is true. Entries are created unknown.
+
+      private:
+         VMC_PageChecksum * GetChecksumEntry( int idSeg , int idPag ,
+                                              bool isCreate )  ;
+
+   //  Method: VMS $Load checksums of a segment
+   //    Reads the checksum file of the segment, if it is still valid.
+
+      private:
+         void LoadChecksums( int idSeg )  ;
+
+   //  Method: VMS $Save checksums of a segment
+   //    Does nothing if the segment has no file.
+
+      private:
+         void SaveChecksums( int idSeg )  ;
+
+   //  Method: VMS $Get checksum file name
+   //    Returns a zero terminated copy the caller deletes.
+
+      private:
+         char * GetChecksumFileName( int idSeg )  ;
+
+   //  Method: VMS $Compute checksum with tables
+
+      private:
+         unsigned int ComputeChecksumTable( unsigned int crc ,
+                                            const unsigned char * pValue ,
+                                            size_t size )  ;
+
+   //  Method: VMS $Compute checksum with CRC instructions
+
+      private:
+         unsigned int ComputeChecksumHardware( unsigned int crc ,
+                                               const unsigned char * pValue ,
+                                               size_t size )  ;
+
+
+   // VMS Number of segment pages of a virtual page and page size
+
+      private:
+         int numSegmentPagesPerPage ;
+         int pageSize ;
+
+
+   // VMS Direct I/O file descriptors
+   //    Indexed by segment, -1 if the segment is not in direct I/O mode.
+   //    Guarded by segmentIoMutex, like the counters of direct transfers
+   //    and of transfers that fell back to the segment module.
+
+      private:
+         int * vtDirectFile ;
+         int dimDirectFile ;
+         int totalDirectReadCounter ;
+         int totalDirectWriteCounter ;
+         int totalDirectFallbackCounter ;
+
+   // VMS Direct reads in flight
+   //    Direct runs are read with segmentIoMutex released. A direct file
+   //    is closed once no read is in flight, directReadDone is notified
+   //    when the last one ends.
+
+      private:
+         int numDirectReadsInFlight ;
+         std::condition_variable_any directReadDone ;
+
+
+   // VMS Page checksums
+   //    vtSegmentChecksum holds, for each segment, a vector of
+   //    vtDimChecksum checksum entries indexed by page, NULL if the
+   //    segment has none. Guarded by segmentIoMutex, like the counters.
+
+      private:
+         VMC_tpChecksumMode checksumMode ;
+         VMC_PageChecksum ** vtSegmentChecksum ;
+         int * vtDimChecksum ;
+         int dimSegmentChecksum ;
+         int totalChecksumCounter ;
+         int totalChecksumMismatchCounter ;
+         int totalChecksumUnverifiedCounter ;
+
+   // VMS CRC32C tables
+   //    vtCrcTable[ k ][ b ] is the CRC of byte b followed by k zero
+   //    bytes, the tables process 8 bytes per step. isCrcHardware is true
+   //    if the processor has CRC instructions.
+
+      private:
+         unsigned int vtCrcTable[ 8 ][ 256 ] ;
+         bool isCrcHardware ;
+
+
+   // VMS Segments written since the last sync
+   //    vtIsSegmentWritten is indexed by segment. The first write to a
+   //    segment after a sync adds its full name to vtWrittenName, hence
+   //    a segment removed before the sync is still synced. Guarded by
+   //    segmentIoMutex.
+
+      private:
+         bool * vtIsSegmentWritten ;
+         int dimSegmentWritten ;
+         char ** vtWrittenName ;
+         int numWrittenNames ;
+         int dimWrittenName ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMS  VMSEGRUN Segment page run ////
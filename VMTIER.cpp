@@ -0,0 +1,818 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMZ  VMTIER Compressed tier
+//
+//Generated file:        VMTIER.CPP
+//
+//Module identification letters: VMZ
+//Module identification number:  463
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMTIER.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMTIER.hpp"
+
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
+
+
+// VMZ Compressed tier record flags
+
+   static const int TIER_RECORD_LIVE       = 1 ;
+
+   static const int TIER_RECORD_COMPRESSED = 2 ;
+
+// VMZ Mean record size the index of the tier is dimensioned for
+//    Once the index is full the oldest records are dropped.
+
+   static const int TIER_MEAN_RECORD_SIZE = 512 ;
+
+// VMZ Compressor parameters
+
+   static const int LZ_MIN_MATCH  = 4 ;
+
+   static const int LZ_MAX_OFFSET = 65535 ;
+
+   static const int LZ_HASH_BITS  = 12 ;
+
+   static const int LZ_SKIP_SHIFT = 5 ;
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMZ  Compressed tier
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMZ  Compressed tier
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Compressed tier constructor
+
+   VMC_CompressedTier ::
+             VMC_CompressedTier( int arenaSizeParm , int pageSizeParm )
+   {
+
+      pageSize  = pageSizeParm ;
+      arenaSize = arenaSizeParm & ~7 ;
+      if ( arenaSize < 4 * GetRecordSize( pageSize ))
+      {
+         arenaSize = 4 * GetRecordSize( pageSize ) ;
+      } /* if */
+
+      pArena     = new char[ arenaSize ] ;
+      inxHead    = 0 ;
+      inxTail    = 0 ;
+      inxWrap    = arenaSize ;
+      numRecords = 0 ;
+
+      maxLivePages = arenaSize / TIER_MEAN_RECORD_SIZE ;
+      if ( maxLivePages < 16 )
+      {
+         maxLivePages = 16 ;
+      } /* if */
+
+      numSlotBits = 4 ;
+      while ( ( 1 << numSlotBits ) < 2 * maxLivePages )
+      {
+         numSlotBits ++ ;
+      } /* while */
+
+      numSlots     = 1 << numSlotBits ;
+      vtSlot       = new VMC_TierSlot[ numSlots ] ;
+      numLivePages = 0 ;
+
+      for ( int inxSlot = 0 ; inxSlot < numSlots ; inxSlot++ )
+      {
+         vtSlot[ inxSlot ].key       = EMPTY_PAGE_KEY ;
+         vtSlot[ inxSlot ].inxRecord = -1 ;
+      } /* for */
+
+      vtLzHash = new int[ 1 << LZ_HASH_BITS ] ;
+      memset( vtLzHash , 0 , ( 1 << LZ_HASH_BITS ) * sizeof( int )) ;
+
+      pCompressBuffer = new unsigned char[ pageSize ] ;
+
+      totalHits        = 0 ;
+      totalMisses      = 0 ;
+      totalStored      = 0 ;
+      totalDropped     = 0 ;
+      totalValueBytes  = 0 ;
+      totalRecordBytes = 0 ;
+
+   } // End of function: VMZ $Compressed tier constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Compressed tier destructor
+
+   VMC_CompressedTier ::
+             ~VMC_CompressedTier( )
+   {
+
+      delete [ ] pArena ;
+      delete [ ] vtSlot ;
+      delete [ ] vtLzHash ;
+      delete [ ] pCompressBuffer ;
+
+   } // End of function: VMZ $Compressed tier destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Store page
+
+   void VMC_CompressedTier ::
+             StorePage( unsigned long long key , const char * pPageValue )
+   {
+
+      int inxSlot = FindSlot( key ) ;
+      if ( inxSlot >= 0 )
+      {
+         KillRecord( inxSlot ) ;
+      } /* if */
+
+      const unsigned char * pValue = reinterpret_cast< const unsigned char * >( pPageValue ) ;
+
+      int flags     = TIER_RECORD_LIVE | TIER_RECORD_COMPRESSED ;
+      int sizeValue = Compress( pValue , pCompressBuffer , pageSize ) ;
+      if ( sizeValue == 0 )
+      {
+         flags     = TIER_RECORD_LIVE ;
+         sizeValue = pageSize ;
+      } else
+      {
+         pValue    = pCompressBuffer ;
+      } /* if */
+
+      while ( numLivePages >= maxLivePages )
+      {
+         DropOldestRecord( ) ;
+      } /* while */
+
+      int sizeRecord = GetRecordSize( sizeValue ) ;
+      int inxRecord  = ReserveRecord( sizeRecord ) ;
+
+      VMC_TierRecord * pRecord = GetRecord( inxRecord ) ;
+      pRecord->key       = key ;
+      pRecord->sizeValue = sizeValue ;
+      pRecord->flags     = flags ;
+      memcpy( pRecord + 1 , pValue , sizeValue ) ;
+
+      inxHead += sizeRecord ;
+      numRecords ++ ;
+
+      InsertSlot( key , inxRecord ) ;
+      numLivePages ++ ;
+
+      totalStored ++ ;
+      totalValueBytes  += pageSize ;
+      totalRecordBytes += sizeRecord ;
+
+   } // End of function: VMZ $Store page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Load page
+//    A damaged record is dropped and counted as a miss, the page is then
+//    read from its segment.
+
+   bool VMC_CompressedTier ::
+             LoadPage( unsigned long long key , char * pPageValue )
+   {
+
+      int inxSlot = FindSlot( key ) ;
+      if ( inxSlot < 0 )
+      {
+         totalMisses ++ ;
+         return false ;
+      } /* if */
+
+      VMC_TierRecord * pRecord = GetRecord( vtSlot[ inxSlot ].inxRecord ) ;
+      unsigned char * pValue = reinterpret_cast< unsigned char * >( pPageValue ) ;
+
+      bool isLoaded = true ;
+      if ( pRecord->flags & TIER_RECORD_COMPRESSED )
+      {
+         isLoaded = Decompress( reinterpret_cast< unsigned char * >( pRecord + 1 ) ,
+                                pRecord->sizeValue , pValue ) ;
+      } else
+      {
+         memcpy( pValue , pRecord + 1 , pageSize ) ;
+      } /* if */
+
+      KillRecord( inxSlot ) ;
+
+      if ( !isLoaded )
+      {
+         totalMisses ++ ;
+         return false ;
+      } /* if */
+
+      totalHits ++ ;
+      return true ;
+
+   } // End of function: VMZ $Load page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Contains page
+
+   bool VMC_CompressedTier ::
+             ContainsPage( unsigned long long key , bool isCountMiss )
+   {
+
+      if ( FindSlot( key ) >= 0 )
+      {
+         return true ;
+      } /* if */
+
+      if ( isCountMiss )
+      {
+         totalMisses ++ ;
+      } /* if */
+
+      return false ;
+
+   } // End of function: VMZ $Contains page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Drop page
+
+   void VMC_CompressedTier ::
+             DropPage( unsigned long long key )
+   {
+
+      int inxSlot = FindSlot( key ) ;
+      if ( inxSlot >= 0 )
+      {
+         KillRecord( inxSlot ) ;
+      } /* if */
+
+   } // End of function: VMZ $Drop page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Drop all pages of a segment
+
+   void VMC_CompressedTier ::
+             DropSegment( int idSeg )
+   {
+
+      int inxRecord = inxTail ;
+
+      for ( int inxCount = 0 ; inxCount < numRecords ; inxCount++ )
+      {
+         VMC_TierRecord * pRecord = GetRecord( inxRecord ) ;
+
+         if ( ( pRecord->flags & TIER_RECORD_LIVE )
+           && ( static_cast< int >( pRecord->key >> 32 ) == idSeg ))
+         {
+            KillRecord( FindSlot( pRecord->key )) ;
+         } /* if */
+
+         inxRecord += GetRecordSize( pRecord->sizeValue ) ;
+         if ( inxRecord == inxWrap )
+         {
+            inxRecord = 0 ;
+         } /* if */
+      } /* for */
+
+   } // End of function: VMZ $Drop all pages of a segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Verify tier
+
+   bool VMC_CompressedTier ::
+             VerifyTier( )
+   {
+
+      int countLive = 0 ;
+      int inxRecord = inxTail ;
+
+      for ( int inxCount = 0 ; inxCount < numRecords ; inxCount++ )
+      {
+         VMC_TierRecord * pRecord = GetRecord( inxRecord ) ;
+
+         if ( ( pRecord->sizeValue <= 0 )
+           || ( pRecord->sizeValue > pageSize ))
+         {
+            return false ;
+         } /* if */
+
+         if ( pRecord->flags & TIER_RECORD_LIVE )
+         {
+            int inxSlot = FindSlot( pRecord->key ) ;
+            if ( ( inxSlot < 0 )
+              || ( vtSlot[ inxSlot ].inxRecord != inxRecord ))
+            {
+               return false ;
+            } /* if */
+            countLive ++ ;
+         } /* if */
+
+         inxRecord += GetRecordSize( pRecord->sizeValue ) ;
+         if ( inxRecord == inxWrap )
+         {
+            inxRecord = 0 ;
+         } /* if */
+      } /* for */
+
+      return ( countLive == numLivePages )
+          && ( ( numRecords == 0 ) || ( inxRecord == inxHead )) ;
+
+   } // End of function: VMZ $Verify tier
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Get counters
+
+   void VMC_CompressedTier ::
+             GetCounters( int * pArenaSize  ,
+                          int * pNumPages   ,
+                          int * pNumHits    ,
+                          int * pNumMisses  ,
+                          int * pNumStored  ,
+                          int * pNumDropped ,
+                          double * pRatio    )
+   {
+
+      *pArenaSize  = arenaSize ;
+      *pNumPages   = numLivePages ;
+      *pNumHits    = totalHits ;
+      *pNumMisses  = totalMisses ;
+      *pNumStored  = totalStored ;
+      *pNumDropped = totalDropped ;
+      *pRatio      = ( totalRecordBytes > 0 ) ?
+                     static_cast< double >( totalValueBytes ) / totalRecordBytes : 0 ;
+
+   } // End of function: VMZ $Get counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Compress page value
+//    Positions are hashed by their next 4 bytes. A candidate is taken
+//    if those bytes match, and the match is extended as far as possible.
+//    The step grows while no match is found, hence values that do not
+//    compress are skipped quickly.
+
+   int VMC_CompressedTier ::
+             Compress( const unsigned char * pValue ,
+                       unsigned char * pCompressed ,
+                       int maxSize )
+   {
+
+      int sizeCompressed = 0 ;
+      int inxAnchor      = 0 ;
+      int inxValue       = 0 ;
+
+      while ( inxValue <= pageSize - LZ_MIN_MATCH )
+      {
+         unsigned int sequence ;
+         memcpy( &sequence , pValue + inxValue , LZ_MIN_MATCH ) ;
+
+         int inxHash  = static_cast< int >(( sequence * 2654435761U ) >> ( 32 - LZ_HASH_BITS )) ;
+         int inxMatch = vtLzHash[ inxHash ] ;
+         vtLzHash[ inxHash ] = inxValue ;
+
+         bool isMatch = false ;
+         if ( ( inxMatch < inxValue )
+           && ( inxValue - inxMatch <= LZ_MAX_OFFSET ))
+         {
+            unsigned int candidate ;
+            memcpy( &candidate , pValue + inxMatch , LZ_MIN_MATCH ) ;
+            isMatch = ( candidate == sequence ) ;
+         } /* if */
+
+         if ( !isMatch )
+         {
+            inxValue += 1 + (( inxValue - inxAnchor ) >> LZ_SKIP_SHIFT ) ;
+            continue ;
+         } /* if */
+
+         int lenMatch = LZ_MIN_MATCH ;
+         while ( ( inxValue + lenMatch < pageSize )
+              && ( pValue[ inxMatch + lenMatch ] == pValue[ inxValue + lenMatch ] ))
+         {
+            lenMatch ++ ;
+         } /* while */
+
+         sizeCompressed = AppendSequence( pCompressed , sizeCompressed , maxSize ,
+                   pValue + inxAnchor , inxValue - inxAnchor ,
+                   inxValue - inxMatch , lenMatch ) ;
+         if ( sizeCompressed < 0 )
+         {
+            return 0 ;
+         } /* if */
+
+         inxValue += lenMatch ;
+         inxAnchor = inxValue ;
+      } /* while */
+
+      sizeCompressed = AppendSequence( pCompressed , sizeCompressed , maxSize ,
+                pValue + inxAnchor , pageSize - inxAnchor , 0 , 0 ) ;
+      if ( ( sizeCompressed < 0 )
+        || ( sizeCompressed >= maxSize ))
+      {
+         return 0 ;
+      } /* if */
+
+      return sizeCompressed ;
+
+   } // End of function: VMZ $Compress page value
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Decompress page value
+//    Every length and offset is checked against both buffers.
+
+   bool VMC_CompressedTier ::
+             Decompress( const unsigned char * pCompressed ,
+                         int sizeCompressed ,
+                         unsigned char * pValue )
+   {
+
+      int inxCompressed = 0 ;
+      int inxValue      = 0 ;
+
+      while ( inxCompressed < sizeCompressed )
+      {
+         int token = pCompressed[ inxCompressed ++ ] ;
+
+         int lenLiteral = token >> 4 ;
+         if ( ( lenLiteral == 15 )
+           && !ReadLength( pCompressed , sizeCompressed , &inxCompressed , &lenLiteral ))
+         {
+            return false ;
+         } /* if */
+
+         if ( ( lenLiteral > sizeCompressed - inxCompressed )
+           || ( lenLiteral > pageSize - inxValue ))
+         {
+            return false ;
+         } /* if */
+
+         memcpy( pValue + inxValue , pCompressed + inxCompressed , lenLiteral ) ;
+         inxCompressed += lenLiteral ;
+         inxValue      += lenLiteral ;
+
+         if ( inxCompressed == sizeCompressed )
+         {
+            break ;
+         } /* if */
+
+         if ( inxCompressed + 2 > sizeCompressed )
+         {
+            return false ;
+         } /* if */
+
+         int offset = pCompressed[ inxCompressed ] | ( pCompressed[ inxCompressed + 1 ] << 8 ) ;
+         inxCompressed += 2 ;
+
+         int lenMatch = token & 15 ;
+         if ( ( lenMatch == 15 )
+           && !ReadLength( pCompressed , sizeCompressed , &inxCompressed , &lenMatch ))
+         {
+            return false ;
+         } /* if */
+         lenMatch += LZ_MIN_MATCH ;
+
+         if ( ( offset == 0 )
+           || ( offset > inxValue )
+           || ( lenMatch > pageSize - inxValue ))
+         {
+            return false ;
+         } /* if */
+
+         unsigned char * pMatch = pValue + inxValue - offset ;
+         if ( offset >= lenMatch )
+         {
+            memcpy( pValue + inxValue , pMatch , lenMatch ) ;
+         } else
+         {
+            for ( int inxByte = 0 ; inxByte < lenMatch ; inxByte++ )
+            {
+               pValue[ inxValue + inxByte ] = pMatch[ inxByte ] ;
+            } /* for */
+         } /* if */
+         inxValue += lenMatch ;
+      } /* while */
+
+      return inxValue == pageSize ;
+
+   } // End of function: VMZ $Decompress page value
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Append sequence
+//    A token holds 4 bits of the literal length and 4 bits of the match
+//    length beyond LZ_MIN_MATCH. A value of 15 is extended by bytes
+//    added to it, up to the first byte below 255. The literals and the
+//    2 byte offset of the match follow.
+
+   int VMC_CompressedTier ::
+             AppendSequence( unsigned char * pCompressed ,
+                             int sizeCompressed ,
+                             int maxSize ,
+                             const unsigned char * pLiteral ,
+                             int lenLiteral ,
+                             int offset ,
+                             int lenMatch )
+   {
+
+      int lenExtra = ( lenMatch > 0 ) ? lenMatch - LZ_MIN_MATCH : 0 ;
+
+      if ( sizeCompressed + 1 + lenLiteral / 255 + 1 + lenLiteral +
+           2 + lenExtra / 255 + 1 > maxSize )
+      {
+         return -1 ;
+      } /* if */
+
+      unsigned char * pToken = pCompressed + sizeCompressed ++ ;
+
+      *pToken = static_cast< unsigned char >(( lenLiteral < 15 ? lenLiteral : 15 ) << 4 ) ;
+      if ( lenLiteral >= 15 )
+      {
+         int length = lenLiteral - 15 ;
+         while ( length >= 255 )
+         {
+            pCompressed[ sizeCompressed ++ ] = 255 ;
+            length -= 255 ;
+         } /* while */
+         pCompressed[ sizeCompressed ++ ] = static_cast< unsigned char >( length ) ;
+      } /* if */
+
+      memcpy( pCompressed + sizeCompressed , pLiteral , lenLiteral ) ;
+      sizeCompressed += lenLiteral ;
+
+      if ( lenMatch == 0 )
+      {
+         return sizeCompressed ;
+      } /* if */
+
+      pCompressed[ sizeCompressed ++ ] = static_cast< unsigned char >( offset & 0xFF ) ;
+      pCompressed[ sizeCompressed ++ ] = static_cast< unsigned char >( offset >> 8 ) ;
+
+      *pToken |= static_cast< unsigned char >( lenExtra < 15 ? lenExtra : 15 ) ;
+      if ( lenExtra >= 15 )
+      {
+         int length = lenExtra - 15 ;
+         while ( length >= 255 )
+         {
+            pCompressed[ sizeCompressed ++ ] = 255 ;
+            length -= 255 ;
+         } /* while */
+         pCompressed[ sizeCompressed ++ ] = static_cast< unsigned char >( length ) ;
+      } /* if */
+
+      return sizeCompressed ;
+
+   } // End of function: VMZ $Append sequence
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Read length extension
+
+   bool VMC_CompressedTier ::
+             ReadLength( const unsigned char * pCompressed ,
+                         int sizeCompressed ,
+                         int * pInxCompressed ,
+                         int * pLength )
+   {
+
+      int byte ;
+      do
+      {
+         if ( *pInxCompressed >= sizeCompressed )
+         {
+            return false ;
+         } /* if */
+
+         byte = pCompressed[ ( *pInxCompressed ) ++ ] ;
+         *pLength += byte ;
+      } while ( byte == 255 ) ;
+
+      return true ;
+
+   } // End of function: VMZ $Read length extension
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Reserve record
+//    If the space up to the end of the arena does not suffice the log
+//    wraps around, the records dropped then are the oldest ones.
+
+   int VMC_CompressedTier ::
+             ReserveRecord( int sizeRecord )
+   {
+
+      for( ; ; )
+      {
+         if ( ( numRecords == 0 )
+           || ( inxTail < inxHead ))
+         {
+            if ( inxHead + sizeRecord <= arenaSize )
+            {
+               return inxHead ;
+            } /* if */
+
+            inxWrap = inxHead ;
+            inxHead = 0 ;
+
+            if ( numRecords == 0 )
+            {
+               inxTail = 0 ;
+               inxWrap = arenaSize ;
+            } /* if */
+            continue ;
+         } /* if */
+
+         if ( inxTail - inxHead >= sizeRecord )
+         {
+            return inxHead ;
+         } /* if */
+
+         DropOldestRecord( ) ;
+      } /* for */
+
+   } // End of function: VMZ $Reserve record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Drop oldest record
+
+   void VMC_CompressedTier ::
+             DropOldestRecord( )
+   {
+
+      VMC_TierRecord * pRecord = GetRecord( inxTail ) ;
+
+      if ( pRecord->flags & TIER_RECORD_LIVE )
+      {
+         KillRecord( FindSlot( pRecord->key )) ;
+         totalDropped ++ ;
+      } /* if */
+
+      inxTail += GetRecordSize( pRecord->sizeValue ) ;
+      numRecords -- ;
+
+      if ( inxTail == inxWrap )
+      {
+         inxTail = 0 ;
+         inxWrap = arenaSize ;
+      } /* if */
+
+      if ( numRecords == 0 )
+      {
+         inxHead = 0 ;
+         inxTail = 0 ;
+         inxWrap = arenaSize ;
+      } /* if */
+
+   } // End of function: VMZ $Drop oldest record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Kill record
+
+   void VMC_CompressedTier ::
+             KillRecord( int inxSlot )
+   {
+
+      GetRecord( vtSlot[ inxSlot ].inxRecord )->flags &= ~TIER_RECORD_LIVE ;
+      RemoveSlot( inxSlot ) ;
+      numLivePages -- ;
+
+   } // End of function: VMZ $Kill record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Get record
+
+   VMC_TierRecord * VMC_CompressedTier ::
+             GetRecord( int inxRecord )
+   {
+
+      return reinterpret_cast< VMC_TierRecord * >( pArena + inxRecord ) ;
+
+   } // End of function: VMZ $Get record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Get record size
+
+   int VMC_CompressedTier ::
+             GetRecordSize( int sizeValue )
+   {
+
+      return ( static_cast< int >( sizeof( VMC_TierRecord )) + sizeValue + 7 ) & ~7 ;
+
+   } // End of function: VMZ $Get record size
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Find index slot
+
+   int VMC_CompressedTier ::
+             FindSlot( unsigned long long key )
+   {
+
+      int inxSlot = ComputeInxHome( key ) ;
+
+      while ( vtSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
+      {
+         if ( vtSlot[ inxSlot ].key == key )
+         {
+            return inxSlot ;
+         } /* if */
+         inxSlot = ( inxSlot + 1 ) & ( numSlots - 1 ) ;
+      } /* while */
+
+      return -1 ;
+
+   } // End of function: VMZ $Find index slot
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Insert index slot
+
+   void VMC_CompressedTier ::
+             InsertSlot( unsigned long long key , int inxRecord )
+   {
+
+      int inxSlot = ComputeInxHome( key ) ;
+
+      while ( vtSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
+      {
+         inxSlot = ( inxSlot + 1 ) & ( numSlots - 1 ) ;
+      } /* while */
+
+      vtSlot[ inxSlot ].key       = key ;
+      vtSlot[ inxSlot ].inxRecord = inxRecord ;
+
+   } // End of function: VMZ $Insert index slot
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Remove index slot
+
+   void VMC_CompressedTier ::
+             RemoveSlot( int inxSlot )
+   {
+
+      int mask    = numSlots - 1 ;
+      int inxHole = inxSlot ;
+
+      vtSlot[ inxHole ].key       = EMPTY_PAGE_KEY ;
+      vtSlot[ inxHole ].inxRecord = -1 ;
+
+      inxSlot = ( inxHole + 1 ) & mask ;
+
+      while ( vtSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
+      {
+         int inxHome = ComputeInxHome( vtSlot[ inxSlot ].key ) ;
+
+         if ( (( inxSlot - inxHome ) & mask ) >= (( inxSlot - inxHole ) & mask ))
+         {
+            vtSlot[ inxHole ] = vtSlot[ inxSlot ] ;
+
+            vtSlot[ inxSlot ].key       = EMPTY_PAGE_KEY ;
+            vtSlot[ inxSlot ].inxRecord = -1 ;
+            inxHole = inxSlot ;
+         } /* if */
+
+         inxSlot = ( inxSlot + 1 ) & mask ;
+      } /* while */
+
+   } // End of function: VMZ $Remove index slot
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMZ $Compute home slot
+//    Fibonacci hashing, the high bits of the product are the best mixed.
+
+   int VMC_CompressedTier ::
+             ComputeInxHome( unsigned long long key )
+   {
+
+      return static_cast< int >(( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - numSlotBits )) ;
+
+   } // End of function: VMZ $Compute home slot
+
+//--- End of class: VMZ  Compressed tier
+
+////// End of implementation module: VMZ  VMTIER Compressed tier ////
@@ -0,0 +1,305 @@
+#ifndef _VMTIER_
+   #define _VMTIER_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMZ  VMTIER Compressed tier
+//
+// Generated file:    VMTIER.HPP
+//
+// Module identification letters: VMZ
+// Module identification number:  463
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMTIER.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Keeps the values of clean evicted pages compressed in memory, hence
+//    a later fault of such a page is served without reading its segment.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include "VRTMEM.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMZ Compressed tier record header
+//    Precedes the value of a page in the log of the tier. Records start
+//    at multiples of 8 bytes.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_TierRecord
+   {
+
+   // VMZ Page table key of the page
+
+      unsigned long long key ;
+
+   // VMZ Size of the stored value, compressed or not
+
+      int sizeValue ;
+
+   // VMZ TIER_RECORD_LIVE and TIER_RECORD_COMPRESSED flags
+
+      int flags ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMZ Compressed tier index slot
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_TierSlot
+   {
+
+   // VMZ Page table key, EMPTY_PAGE_KEY if the slot is empty
+
+      unsigned long long key ;
+
+   // VMZ Offset of the live record of the page in the log
+
+      int inxRecord ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMZ  Compressed tier
+//    Bounded arena keeping compressed copies of clean pages evicted from
+//    their frames. Records are appended to a circular log, the oldest
+//    records are dropped to make room. The record of a page found again
+//    becomes dead, its space is reclaimed when the log wraps around to
+//    it. An open addressing index maps pages to their live records.
+//    A page is in a frame or in the tier, never in both, hence the copy
+//    in the tier equals the value of the page in its segment.
+//    Values are compressed with a byte oriented LZ77 coder, literal runs
+//    and matches of at least 4 bytes within the page. A value that does
+//    not compress is stored as it is.
+//    The tier is handled exclusively by the thread using the virtual
+//    memory root.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_CompressedTier
+   {
+
+   //  Method: VMZ $Compressed tier constructor
+   //    The arena holds at least a few uncompressed values of the
+   //    current page size.
+
+      public:
+         VMC_CompressedTier( int arenaSizeParm , int pageSizeParm )  ;
+
+   //  Method: VMZ $Compressed tier destructor
+
+      public:
+         ~VMC_CompressedTier( )  ;
+
+   //  Method: VMZ $Store page
+   //    Appends a record of the page value, replacing a record of the
+   //    same page, if any.
+
+      public:
+         void StorePage( unsigned long long key , const char * pPageValue )  ;
+
+   //  Method: VMZ $Load page
+   //    Restores the page value and drops its record. Returns false if
+   //    the page is not in the tier.
+
+      public:
+         bool LoadPage( unsigned long long key , char * pPageValue )  ;
+
+   //  Method: VMZ $Contains page
+   //    Counts a miss if isCountMiss and the page is not in the tier.
+
+      public:
+         bool ContainsPage( unsigned long long key , bool isCountMiss )  ;
+
+   //  Method: VMZ $Drop page
+
+      public:
+         void DropPage( unsigned long long key )  ;
+
+   //  Method: VMZ $Drop all pages of a segment
+
+      public:
+         void DropSegment( int idSeg )  ;
+
+   //  Method: VMZ $Verify tier
+   //    Returns true if the index and the live records agree.
+
+      public:
+         bool VerifyTier( )  ;
+
+   //  Method: VMZ $Get counters
+   //    The ratio is the size of the values stored over the size of
+   //    their records.
+
+      public:
+         void GetCounters( int * pArenaSize  ,
+                           int * pNumPages   ,
+                           int * pNumHits    ,
+                           int * pNumMisses  ,
+                           int * pNumStored  ,
+                           int * pNumDropped ,
+                           double * pRatio    )  ;
+
+   //  Method: VMZ $Compress page value
+   //    Returns the size of the compressed value, 0 if it would not be
+   //    smaller than maxSize.
+
+      private:
+         int Compress( const unsigned char * pValue ,
+                       unsigned char * pCompressed ,
+                       int maxSize )  ;
+
+   //  Method: VMZ $Decompress page value
+   //    Returns false if the compressed value is damaged.
+
+      private:
+         bool Decompress( const unsigned char * pCompressed ,
+                          int sizeCompressed ,
+                          unsigned char * pValue )  ;
+
+   //  Method: VMZ $Append sequence
+   //    Appends literals followed by a match, lenMatch is 0 for the
+   //    final literals. Returns the new size, -1 if it exceeds maxSize.
+
+      private:
+         static int AppendSequence( unsigned char * pCompressed ,
+                                    int sizeCompressed ,
+                                    int maxSize ,
+                                    const unsigned char * pLiteral ,
+                                    int lenLiteral ,
+                                    int offset ,
+                                    int lenMatch )  ;
+
+   //  Method: VMZ $Read length extension
+   //    Returns false if the compressed value ends within it.
+
+      private:
+         static bool ReadLength( const unsigned char * pCompressed ,
+                                 int sizeCompressed ,
+                                 int * pInxCompressed ,
+                                 int * pLength )  ;
+
+   //  Method: VMZ $Reserve record
+   //    Drops the oldest records until sizeRecord contiguous bytes are
+   //    free at the head of the log. Returns the offset of the space.
+
+      private:
+         int ReserveRecord( int sizeRecord )  ;
+
+   //  Method: VMZ $Drop oldest record
+
+      private:
+         void DropOldestRecord( )  ;
+
+   //  Method: VMZ $Kill record
+   //    Marks the record of an index slot dead and frees the slot.
+
+      private:
+         void KillRecord( int inxSlot )  ;
+
+   //  Method: VMZ $Get record
+
+      private:
+         VMC_TierRecord * GetRecord( int inxRecord )  ;
+
+   //  Method: VMZ $Get record size
+
+      private:
+         static int GetRecordSize( int sizeValue )  ;
+
+   //  Method: VMZ $Find index slot
+   //    Returns -1 if the page is not in the index.
+
+      private:
+         int FindSlot( unsigned long long key )  ;
+
+   //  Method: VMZ $Insert index slot
+
+      private:
+         void InsertSlot( unsigned long long key , int inxRecord )  ;
+
+   //  Method: VMZ $Remove index slot
+   //    Shifts following slots back as the page table does.
+
+      private:
+         void RemoveSlot( int inxSlot )  ;
+
+   //  Method: VMZ $Compute home slot
+
+      private:
+         int ComputeInxHome( unsigned long long key )  ;
+
+   // VMZ Log of records
+   //    Records lie from inxTail to inxHead. If the log has wrapped
+   //    around, inxTail is not below inxHead and the records from inxTail
+   //    end at inxWrap.
+
+      private:
+         char * pArena ;
+         int arenaSize ;
+         int inxHead ;
+         int inxTail ;
+         int inxWrap ;
+         int numRecords ;
+
+   // VMZ Index of live records
+   //    numSlots is a power of 2 and at least twice maxLivePages.
+
+      private:
+         VMC_TierSlot * vtSlot ;
+         int numSlots ;
+         int numSlotBits ;
+         int numLivePages ;
+         int maxLivePages ;
+
+   // VMZ Compression work areas
+   //    The hash of 4 byte sequences is not cleared between pages, a
+   //    stale position is verified like any other candidate.
+
+      private:
+         int * vtLzHash ;
+         unsigned char * pCompressBuffer ;
+
+   // VMZ Page size of the values
+
+      private:
+         int pageSize ;
+
+   // VMZ Counters
+
+      private:
+         int totalHits ;
+         int totalMisses ;
+         int totalStored ;
+         int totalDropped ;
+         long long totalValueBytes ;
+         long long totalRecordBytes ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMZ  VMTIER Compressed tier ////
@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//Implementation module: VMW  VMWRITE Write behind queue
+//
+//Generated file:        VMWRITE.CPP
+//
+//Module identification letters: VMW
+//Module identification number:  459
+//
+//Repository name:      Virtual memory
+//Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMWRITE.BSW
+//
+//Owning organization:    LES/DI/PUC-Rio
+//Project:                Talisman
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+   #include  <stdint.h>
+
+   #include "VRTMEM.hpp"
+   #include "VRTMEMI.hpp"
+   #include "VMSEGRUN.hpp"
+   #include "VMREDO.hpp"
+   #include "VMWRITE.hpp"
+
+//==========================================================================
+//----- Class implementation -----
+//==========================================================================
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Implementation of class: VMW  Write behind queue
+////////////////////////////////////////////////////////////////////////////
+
+// Class: VMW  Write behind queue
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Write behind queue constructor
+
+   VMC_WriteBehindQueue ::
+             VMC_WriteBehindQueue( int maxRequestsParm , int pageSizeParm )
+   {
+
+      pageSize       = pageSizeParm ;
+      maxRequests    = maxRequestsParm ;
+      vtRequest      = new VMC_WriteRequest[ maxRequests ] ;
+      pRequestValues = new char[ ( size_t ) maxRequests * pageSize +
+                                 DIRECT_IO_ALIGNMENT ] ;
+
+      char * pFirstValue = pRequestValues + DIRECT_IO_ALIGNMENT -
+                reinterpret_cast< uintptr_t >( pRequestValues ) % DIRECT_IO_ALIGNMENT ;
+      for ( int inxRequest = 0 ; inxRequest < maxRequests ; inxRequest++ )
+      {
+         vtRequest[ inxRequest ].pageValue = pFirstValue +
+                   ( size_t ) inxRequest * pageSize ;
+      } /* for */
+
+      inxFirst       = 0 ;
+      numRequests    = 0 ;
+      isStopping     = false ;
+      pFailure       = NULL ;
+      totalScheduled = 0 ;
+
+      writerThread   = std::thread( &VMC_WriteBehindQueue::WriteRequests , this ) ;
+
+   } // End of function: VMW $Write behind queue constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Write behind queue destructor
+
+   VMC_WriteBehindQueue ::
+             ~VMC_WriteBehindQueue( )
+   {
+
+      {
+         std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+         isStopping = true ;
+      }
+      queueChanged.notify_all( ) ;
+
+      writerThread.join( ) ;
+
+      delete pFailure ;
+      delete [ ] vtRequest ;
+      delete [ ] pRequestValues ;
+
+   } // End of function: VMW $Write behind queue destructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Schedule write of a dirty frame
+
+   void VMC_WriteBehindQueue ::
+             ScheduleWrite( VMC_PageFrame * pPageFrame )
+   {
+
+      std::unique_lock< std::mutex > queueLock( queueMutex ) ;
+
+      ThrowFailure( queueLock ) ;
+
+      while ( numRequests >= maxRequests )
+      {
+         queueChanged.wait( queueLock ) ;
+         ThrowFailure( queueLock ) ;
+      } /* while */
+
+      VMC_WriteRequest * pRequest =
+                &vtRequest[ ( inxFirst + numRequests ) % maxRequests ] ;
+
+      pRequest->pageLsn     = pPageFrame->GetPageLsn( ) ;
+      pRequest->changeLevel = pPageFrame->DetachPageValue( pRequest->pageValue ) ;
+      if ( pRequest->changeLevel >= TAL_NOT_CHANGED )
+      {
+         return ;
+      } /* if */
+
+      pRequest->idSegment = pPageFrame->GetIdSeg( ) ;
+      pRequest->idPage    = pPageFrame->GetIdPag( ) ;
+
+      numRequests ++ ;
+      totalScheduled ++ ;
+
+      queueLock.unlock( ) ;
+      queueChanged.notify_all( ) ;
+
+   } // End of function: VMW $Schedule write of a dirty frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Copy pending page value
+//    Searches from the newest request to the oldest one
+
+   bool VMC_WriteBehindQueue ::
+             CopyPendingPage( int idSeg , int idPag , char * pPageValue )
+   {
+
+      std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+
+      for ( int i = numRequests - 1 ; i >= 0 ; i-- )
+      {
+         VMC_WriteRequest * pRequest = &vtRequest[ ( inxFirst + i ) % maxRequests ] ;
+         if ( ( pRequest->idSegment == idSeg )
+           && ( pRequest->idPage    == idPag ))
+         {
+            memcpy( pPageValue , pRequest->pageValue , pageSize ) ;
+            return true ;
+         } /* if */
+      } /* for */
+
+      return false ;
+
+   } // End of function: VMW $Copy pending page value
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Is page pending
+
+   bool VMC_WriteBehindQueue ::
+             IsPagePending( int idSeg , int idPag )
+   {
+
+      std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+
+      for ( int i = 0 ; i < numRequests ; i++ )
+      {
+         VMC_WriteRequest * pRequest = &vtRequest[ ( inxFirst + i ) % maxRequests ] ;
+         if ( ( pRequest->idSegment == idSeg )
+           && ( pRequest->idPage    == idPag ))
+         {
+            return true ;
+         } /* if */
+      } /* for */
+
+      return false ;
+
+   } // End of function: VMW $Is page pending
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Wait until all requests are written
+
+   void VMC_WriteBehindQueue ::
+             Drain( )
+   {
+
+      std::unique_lock< std::mutex > queueLock( queueMutex ) ;
+
+      while ( numRequests > 0 )
+      {
+         queueChanged.wait( queueLock ) ;
+      } /* while */
+
+      ThrowFailure( queueLock ) ;
+
+   } // End of function: VMW $Wait until all requests are written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Get total number of scheduled writes
+
+   int VMC_WriteBehindQueue ::
+             GetTotalScheduled( )
+   {
+
+      std::lock_guard< std::mutex > queueLock( queueMutex ) ;
+
+      return totalScheduled ;
+
+   } // End of function: VMW $Get total number of scheduled writes
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Write requests
+//    The request being written stays in the queue until the write ends.
+//    Failures of ignorable changes are discarded, as done by
+//    WritePageFrame. Other failures are kept for the foreground.
+
+   void VMC_WriteBehindQueue ::
+             WriteRequests( )
+   {
+
+      std::unique_lock< std::mutex > queueLock( queueMutex ) ;
+
+      for( ; ; )
+      {
+         while ( ( numRequests == 0 )
+              && ( !isStopping ))
+         {
+            queueChanged.wait( queueLock ) ;
+         } /* while */
+
+         if ( numRequests == 0 )
+         {
+            break ;
+         } /* if */
+
+         VMC_WriteRequest * pRequest = &vtRequest[ inxFirst ] ;
+         queueLock.unlock( ) ;
+
+         EXC_Exception * pExc = NULL ;
+         try
+         {
+            VMC_RedoLog * pRedoLog = VMC_VirtualMemoryRoot::GetRoot( )->GetRedoLog( ) ;
+            if ( pRedoLog != NULL )
+            {
+               pRedoLog->ForcePage( pRequest->pageLsn ,
+                         pRequest->idSegment , pRequest->idPage ) ;
+            } /* if */
+
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            VMC_VirtualMemoryRoot::GetRoot( )->GetSegmentPageRun( )->
+                      WriteRun( pRequest->idSegment , pRequest->idPage ,
+                                pRequest->pageValue ) ;
+         }
+         catch ( EXC_Exception * pCaught )
+         {
+            pExc = pCaught ;
+            if ( pRequest->changeLevel == TAL_IGNORABLE_CHANGE )
+            {
+               delete pExc ;
+               pExc = NULL ;
+            } /* if */
+         } /* end catch */
+
+         queueLock.lock( ) ;
+
+         if ( ( pExc != NULL )
+           && ( pFailure == NULL ))
+         {
+            pFailure = pExc ;
+         } else
+         {
+            delete pExc ;
+         } /* if */
+
+         inxFirst = ( inxFirst + 1 ) % maxRequests ;
+         numRequests -- ;
+
+         queueChanged.notify_all( ) ;
+      } /* for */
+
+   } // End of function: VMW $Write requests
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMW $Throw pending failure
+
+   void VMC_WriteBehindQueue ::
+             ThrowFailure( std::unique_lock< std::mutex > & queueLock )
+   {
+
+      if ( pFailure != NULL )
+      {
+         EXC_Exception * pExc = pFailure ;
+         pFailure = NULL ;
+         queueLock.unlock( ) ;
+
+         throw pExc ;
+      } /* if */
+
+   } // End of function: VMW $Throw pending failure
+
+//--- End of class: VMW  Write behind queue
+
+////// End of implementation module: VMW  VMWRITE Write behind queue ////
@@ -0,0 +1,184 @@
+#ifndef _VMWRITE_
+   #define _VMWRITE_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMW  VMWRITE Write behind queue
+//
+// Generated file:    VMWRITE.HPP
+//
+// Module identification letters: VMW
+// Module identification number:  459
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VMWRITE.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Writes the dirty pages evicted in clean first mode from a writer
+//    thread, while the foreground goes on with the clean frames.
+//    Internal to the virtual memory control, see module VRTMEM.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+   #include  <thread>
+   #include  <condition_variable>
+
+   #include "VRTMEM.hpp"
+   #include "exceptn.hpp"
+
+//==========================================================================
+//----- Exported declarations -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMW Write behind request
+//    Copy of a dirty page value waiting to be written to its segment.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_WriteRequest
+   {
+
+   // VMW Virtual address of the page
+
+      int idSegment ;
+      int idPage ;
+
+   // VMW Change level of the frame when the value was copied
+
+      TAL_tpChangeLevel changeLevel ;
+
+   // VMW Log sequence number the redo log must be durable at before the
+   //    value is written
+
+      long long pageLsn ;
+
+   // VMW Copy of the page value
+   //    Points into the value buffer of the queue
+
+      char * pageValue ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMW  Write behind queue
+//    Bounded FIFO of page copies written by a background thread.
+//    The thread only performs the segment writes. Page frames are
+//    handled exclusively by the thread using the virtual memory root.
+//    A request keeps its slot until its write completes, hence a page
+//    being written can still be found by CopyPendingPage.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   class VMC_WriteBehindQueue
+   {
+
+   //  Method: VMW $Write behind queue constructor
+   //    Starts the writer thread
+
+      public:
+         VMC_WriteBehindQueue( int maxRequestsParm , int pageSizeParm )  ;
+
+   //  Method: VMW $Write behind queue destructor
+   //    Writes all pending requests and stops the writer thread.
+   //    A pending failure is discarded.
+
+      public:
+         ~VMC_WriteBehindQueue( )  ;
+
+   //  Method: VMW $Schedule write of a dirty frame
+   //    Copies the page value and marks the frame not dirty.
+   //    Waits for a free slot if the queue is full.
+
+      public:
+         void ScheduleWrite( VMC_PageFrame * pPageFrame )  ;
+
+   //  Method: VMW $Copy pending page value
+   //    Copies the newest pending value of the page.
+   //    Returns false if no write of the page is pending.
+
+      public:
+         bool CopyPendingPage( int idSeg , int idPag , char * pPageValue )  ;
+
+   //  Method: VMW $Is page pending
+   //    Returns true if a write of the page is pending.
+
+      public:
+         bool IsPagePending( int idSeg , int idPag )  ;
+
+   //  Method: VMW $Wait until all requests are written
+   //    Rethrows the exception of a failed write, if any
+
+      public:
+         void Drain( )  ;
+
+   //  Method: VMW $Get total number of scheduled writes
+
+      public:
+         int GetTotalScheduled( )  ;
+
+   //  Method: VMW $Write requests
+   //    Body of the writer thread
+
+      private:
+         void WriteRequests( )  ;
+
+   //  Method: VMW $Throw pending failure
+   //    Must be called holding the queue lock
+
+      private:
+         void ThrowFailure( std::unique_lock< std::mutex > & queueLock )  ;
+
+   // VMW Queue lock and change notification
+
+      private:
+         std::mutex queueMutex ;
+         std::condition_variable queueChanged ;
+
+   // VMW Circular vector of requests
+   //    inxFirst is the oldest request, the one being written.
+   //    The page values of the requests lie within pRequestValues,
+   //    aligned for direct I/O.
+
+      private:
+         VMC_WriteRequest * vtRequest ;
+         char * pRequestValues ;
+         int maxRequests ;
+         int inxFirst ;
+         int numRequests ;
+
+   // VMW Writer thread control
+
+      private:
+         bool isStopping ;
+         EXC_Exception * pFailure ;
+         std::thread writerThread ;
+
+   // VMW Page size of the values
+
+      private:
+         int pageSize ;
+
+   // VMW Number of scheduled writes
+
+      private:
+         int totalScheduled ;
+
+   }  ;
+
+
+#endif 
+
+////// End of definition module: VMW  VMWRITE Write behind queue ////
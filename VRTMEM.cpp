@@ -27,12 +27,33 @@
 
    #include  <string.h>
    #include  <stdlib.h>
+   #include  <stdint.h>
+   #include  <limits.h>
+   #include  <unistd.h>
+   #include  <fcntl.h>
+   #include  <sys/mman.h>
+   #include  <sys/stat.h>
+
+   #include  <new>
+   #include  <mutex>
+   #include  <chrono>
+   #include  <thread>
+   #include  <condition_variable>
 
    #define  _VRTMEM_OWN
    #include "VRTMEM.hpp"
    #undef   _VRTMEM_OWN
 
-  
+   #include "VRTMEMI.hpp"
+   #include "VMSEGRUN.hpp"
+   #include "VMREDO.hpp"
+   #include "VMWRITE.hpp"
+   #include "VMPAGEIN.hpp"
+   #include "VMCLEAN.hpp"
+   #include "VMFLUSH.hpp"
+   #include "VMARENA.hpp"
+   #include "VMTIER.hpp"
+   #include "VMPOLICY.hpp"
 
    #include "exceptn.hpp"
    #include "message.hpp"
@@ -65,7 +86,133 @@
 
    // VMR Free frame
 
-      FRAME_TYPE_FREE
+      FRAME_TYPE_FREE ,
+
+   // VMR Released frame
+   //    Its page value memory has been returned to the system.
+
+      FRAME_TYPE_RELEASED ,
+
+   // VMR Frame being read by a reader thread
+   //    Its page is registered, the frame is pinned.
+
+      FRAME_TYPE_READING
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Frame metadata vectors
+//    Element i of each vector holds the state of frame i.
+//    Page frames and page frame elements refer to their elements, scans
+//    of the whole pool read the vectors without touching the frames.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_FrameMetadata
+   {
+
+   // VMR Page size of the root, the size of every page value
+
+      int pageSize ;
+
+      int * vtIdSegment ;
+
+      int * vtIdPage ;
+
+      int * vtNumPins ;
+
+      TAL_tpChangeLevel * vtChangeLevel ;
+
+      VMC_tpFrameType * vtFrameType ;
+
+      bool * vtIsPrefetched ;
+
+   // VMR Dirty frame set
+   //    vtDirtyFrame lists the indexes of the numDirtyFrames dirty frames
+   //    in no particular order, vtInxDirty holds the position of each
+   //    frame in vtDirtyFrame, -1 if the frame is not dirty.
+
+      int * vtInxDirty ;
+
+      int * vtDirtyFrame ;
+
+      int numDirtyFrames ;
+
+   // VMR Dirty frame age
+   //    vtDirtySince holds the value of dirtyClock when the frame last
+   //    entered the dirty frame set, the lower the older.
+
+      unsigned long long * vtDirtySince ;
+
+      unsigned long long dirtyClock ;
+
+   // VML Page log sequence numbers
+   //    vtPageLsn holds the sequence number of the last record logged
+   //    for the page of the frame, the page must not be written before
+   //    the log is durable up to it.
+
+      long long * vtPageLsn ;
+
+   // VMR Pinned frame counts
+   //    numPinnedFrames counts the frames holding pins, maxPinnedFrames is
+   //    the largest count since the root was created.
+
+      int numPinnedFrames ;
+
+      int maxPinnedFrames ;
+
+   // VMR Set number of pins of a frame
+   //    Keeps the pinned frame counts, also when a frame loses its pins
+   //    because it is emptied.
+
+      void SetNumPins( int inxFrame , int numPins )
+      {
+         if ( ( vtNumPins[ inxFrame ] <= 0 )
+           && ( numPins > 0 ))
+         {
+            numPinnedFrames ++ ;
+            if ( numPinnedFrames > maxPinnedFrames )
+            {
+               maxPinnedFrames = numPinnedFrames ;
+            } /* if */
+         } else if ( ( vtNumPins[ inxFrame ] > 0 )
+                  && ( numPins <= 0 ))
+         {
+            numPinnedFrames -- ;
+         } /* if */
+
+         vtNumPins[ inxFrame ] = numPins ;
+      }
+
+   // VMR Set change level of a frame
+   //    Inserts the frame into the dirty frame set when it becomes dirty,
+   //    removes it when it becomes clean.
+
+      void SetChangeLevel( int inxFrame , TAL_tpChangeLevel level )
+      {
+         if ( level < TAL_NOT_CHANGED )
+         {
+            if ( vtInxDirty[ inxFrame ] < 0 )
+            {
+               vtInxDirty[ inxFrame ] = numDirtyFrames ;
+               vtDirtyFrame[ numDirtyFrames ] = inxFrame ;
+               numDirtyFrames ++ ;
+               dirtyClock ++ ;
+               vtDirtySince[ inxFrame ] = dirtyClock ;
+            } /* if */
+         } else if ( vtInxDirty[ inxFrame ] >= 0 )
+         {
+            numDirtyFrames -- ;
+            int inxLast = vtDirtyFrame[ numDirtyFrames ] ;
+            vtDirtyFrame[ vtInxDirty[ inxFrame ]] = inxLast ;
+            vtInxDirty[ inxLast ]  = vtInxDirty[ inxFrame ] ;
+            vtInxDirty[ inxFrame ] = -1 ;
+         } /* if */
+
+         vtChangeLevel[ inxFrame ] = level ;
+      }
 
    }  ;
 
@@ -74,7 +221,10 @@
 // 
 //  Data type: VMR Frame list element
 //    Defines the frame list element.
-//    All frames are part of the LRU and of colision lists.
+//    Frames in use are registered in the page table, empty frames are
+//    part of the free list.
+//    The order of frames used for replacement is kept by the
+//    replacement policy.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -90,119 +240,243 @@
       int inxFrameElement ;
 
    // VMR Hash index
-//    Frames in use are part of some colision list.
-//    This attribute tell in which colision list the page frame resides.
+//    Page table slot registering a frame in use, -1 if the frame is free.
+//    Kept up to date when entries are moved within the table.
 
       int inxHash ;
 
-   // VMR Previous colision list element
-//    this pair of pointers establish the list of page frames containing
-//    virtual addresses that are coherent with a given hash index.
-//    The colision list is a non circular doubly linked list.
-//    Colision lists are anchored in the hash table.
-
-      VMC_PageFrameElement * prevColisionElem ;
+   // VMR Free list successor
+//    Only meaningful while the frame is free.
 
-   // VMR Colision list successor
-
-      VMC_PageFrameElement * nextColisionElem ;
-
-   // VMR LRU list predecessor
-//    this pair of pointers links page frames in the LRU list.
-//    The LRU list is a non circular doubly linked list.
-//    The elements of this list are ordered by ascending age.
-//    Age is set to 0 whenever a virtual page is accessed using the
-//    GetPageFrame( idSegment, idPage) method.
-//    The age is increased whenever an older frame is accessed by this
-//    method.
-//    nextLruElem follows the list in increasing age order,
-//    prevLruElem does it in decreasing age order.
-//    Empty frames are always placed at the end of the list.
-//    The list is anchored in the virtual memory root.
-
-      VMC_PageFrameElement * prevLruElem ;
-
-   // VMR LRU list successor
-
-      VMC_PageFrameElement * nextLruElem ;
+      VMC_PageFrameElement * nextFreeElem ;
 
    // VMR page frame contained in this element
 
       VMC_PageFrame * pPageFrame ;
 
    // VMR Frame type
+   //    Element of the frame metadata vectors.
+
+      VMC_tpFrameType & frameType ;
 
-      VMC_tpFrameType frameType ;
+   // VMR Page has been read ahead and not yet accessed
+   //    Element of the frame metadata vectors.
+
+      bool & isPrefetched ;
 
    // VMR Framelist element constructor
+   //    The page frame is owned by the root.
 
-      VMC_PageFrameElement( int inxFrameElem )
+      VMC_PageFrameElement( int inxFrameElem ,
+                            VMC_PageFrame * pPageFrameParm ,
+                            VMC_FrameMetadata * pMetadata )
+                : frameType( pMetadata->vtFrameType[ inxFrameElem ] ) ,
+                  isPrefetched( pMetadata->vtIsPrefetched[ inxFrameElem ] )
       {
          inxFrameElement   = inxFrameElem ;
          inxHash           = -1 ;
-         prevColisionElem = NULL ;
-         nextColisionElem = NULL ;
-         prevLruElem       = NULL ;
-         nextLruElem       = NULL ;
+         nextFreeElem      = NULL ;
          frameType         = FRAME_TYPE_FREE ;
-         pPageFrame        = new VMC_PageFrame( inxFrameElem , this ) ;
+         isPrefetched      = false ;
+         pPageFrame        = pPageFrameParm ;
       }
 
    // VMR Framelist element destructor
 
       ~VMC_PageFrameElement( )
       {
-         delete pPageFrame ;
-
          inxFrameElement   = -1 ;
          inxHash           = -1 ;
-         prevColisionElem = NULL ;
-         nextColisionElem = NULL ;
-         prevLruElem       = NULL ;
-         nextLruElem       = NULL ;
+         nextFreeElem      = NULL ;
          pPageFrame        = NULL ;
          frameType         = FRAME_TYPE_FREE ;
+         isPrefetched      = false ;
       }
 
    }  ;
 
 
-//==========================================================================
-//----- Encapsulated data items -----
-//==========================================================================
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Page table slot
+//    The key packs the segment id in the high and the page id in the low
+//    32 bits. Empty slots contain EMPTY_PAGE_KEY.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_PageTableSlot
+   {
+
+      unsigned long long key ;
+
+      int inxFrameElement ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Segment page map
+//    If vtInxFrame is not NULL it is the direct page map of the segment,
+//    which then has no entries in the page table. Element idPag contains
+//    the index of the frame containing the page, -1 if not in memory.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_SegmentPageMap
+   {
+
+   // VMR Direct page map and its dimension
+
+      int * vtInxFrame ;
+      int dimMap ;
+
+   // VMR Number of pages of the segment in memory
+
+      int numResident ;
+
+   // VMR Opening mode of the segment
+   //    Obtained from the segment module when the first page of the
+   //    segment is registered, valid while numResident is not zero.
+
+      TAL_tpOpeningMode openingMode ;
+
+   // VMR Read ahead state
+   //    stride is the distance between the last two pages accessed,
+   //    numStrides the number of consecutive accesses at that distance.
+   //    Pages before nextIdPag, in the direction of the stride, have
+   //    already been read ahead. numReadAhead is the size of the read
+   //    ahead window in pages.
+
+      int lastIdPag ;
+      int stride ;
+      int numStrides ;
+      int nextIdPag ;
+      int numReadAhead ;
+
+   // VMR Mapping of the segment file
+   //    NULL if the segment is not mapped. Pages before numMappedPages
+   //    are mapped, mappingSize is the length of the mapping in bytes.
+
+      char * pMapping ;
+      size_t mappingSize ;
+      int numMappedPages ;
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Lookaside entry
+//    Page key and frame element of a page recently found in memory.
+//    Unused entries contain EMPTY_PAGE_KEY.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   struct VMC_LookasideEntry
+   {
+
+      unsigned long long key ;
+
+      VMC_PageFrameElement * pPageFrameElem ;
+
+   }  ;
 
 
-// VMR Overflow control size
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Dirty frame entry
+//    Sort key and index of a dirty frame. The key is the page key when
+//    all dirty frames are written, the dirty age when the flusher
+//    chooses the oldest ones.
+// 
+////////////////////////////////////////////////////////////////////////////
 
-   static const int PROTECTION_SIZE = 4 ;
+   struct VMC_DirtyFrame
+   {
 
-// VMR Page value buffer underflow protection constant
+      unsigned long long key ;
 
-   static const char BEFORE[ ] = "\0\xF6\x3F\xF3" ;
+      int inxFrame ;
 
-// VMR Page value buffer overflow protection constant
+   }  ;
 
-   static const char AFTER[ ] = "\xF6\x3F\xF3\0" ;
 
-// VMR Undefined page value character
+//==========================================================================
+//----- Encapsulated data items -----
+//==========================================================================
 
-   static const char VALUE_UNDEFINED = '+' ;  //  '\xFA' ;
 
 // VMR Maximum number of pins of any frame
 
    static const int NUM_MAX_PINS = 100 ;
 
+// VMS Maximum number of segment pages of a virtual page
+
+   static const int MAX_SEGMENT_PAGES_PER_PAGE = 64 ;
+
 // VMR Minimum number of page frames
 
    static const int numMinFrames = 5 ;
 
-// VMR Instantaneous number of simmultaneously pinned frames
+// VMR Minimum number of page table slots
+
+   static const int PAGE_TABLE_MIN_SLOTS = 16 ;
+
+// VMR Minimum number of evicted page history slots, a power of 2
+
+   static const int EVICTED_HISTORY_MIN_SLOTS = 16 ;
+
+// VMR Number of lookaside entries, a power of 2
+
+   static const int LOOKASIDE_SIZE = 64 ;
+
+// VMR Direct page map size limit
+//    Segments with more pages than the larger of these limits are kept
+//    in the page table.
+
+   static const int DIRECT_MAP_MIN_PAGES = 1024 ;
 
-   static int numPinnedFrames = 0 ;
+   static const int DIRECT_MAP_PAGES_PER_FRAME = 16 ;
 
-// VMR Max number of simmultaneously pinned frames
+// VMR Number of frames inspected by the clean first eviction
 
-   static int maxPinnedFrames = 0 ;
+   static const int WRITE_BEHIND_SCAN = 8 ;
+
+// VMR Minimum number of write behind queue slots
+
+   static const int WRITE_BEHIND_MIN_SLOTS = 4 ;
+
+// VMR Read ahead window limits in pages
+
+   static const int READ_AHEAD_MIN_PAGES = 2 ;
+
+   static const int READ_AHEAD_MAX_PAGES = 64 ;
+
+// VMR Number of consecutive accesses at the same stride starting read ahead
+
+   static const int READ_AHEAD_MIN_STRIDES = 2 ;
+
+// VMZ Largest compressed tier in KiB
+
+   static const int TIER_MAX_KIB = 1024 * 1024 ;
+
+// VMW Segment I/O lock
+//    Declared in VRTMEMI.
+
+   std::mutex segmentIoMutex ;
+
+// VMT Maximum number of frames inspected by the tail cleaner
+
+   static const int CLEANER_MAX_SCAN = 64 ;
+
+// VML Log size in KiB beyond which CommitLog checkpoints, and its limits
+
+   static const int LOG_CHECKPOINT_DEFAULT_KIB = 64 * 1024 ;
+
+   static const int LOG_CHECKPOINT_MIN_KIB     = 64 ;
+
+   static const int LOG_CHECKPOINT_MAX_KIB     = 16 * 1024 * 1024 ;
 
 //==========================================================================
 //----- Static member initializations -----
@@ -234,13 +508,20 @@
 
    VMC_PageFrame ::
              VMC_PageFrame( int inxPageFrameElemParm ,
-                            VMC_PageFrameElement * pFrameElementParm )
+                            VMC_PageFrameElement * pFrameElementParm ,
+                            char * pPageValueParm ,
+                            VMC_FrameMetadata * pMetadataParm )
+             : idSegment(   pMetadataParm->vtIdSegment[   inxPageFrameElemParm ] ) ,
+               idPage(      pMetadataParm->vtIdPage[      inxPageFrameElemParm ] ) ,
+               changeLevel( pMetadataParm->vtChangeLevel[ inxPageFrameElemParm ] ) ,
+               numPins(     pMetadataParm->vtNumPins[     inxPageFrameElemParm ] )
    {
 
-      memcpy( protectionBefore, BEFORE , PROTECTION_SIZE  ) ;
-      memcpy( protectionAfter , AFTER  , PROTECTION_SIZE  ) ;
+      pageValue        = pPageValueParm ;
+      bufferValue      = pPageValueParm ;
       inxPageFrameElem = inxPageFrameElemParm ;
       pFrameElement    = pFrameElementParm ;
+      pMetadata        = pMetadataParm ;
 
       SetFrameEmpty( ) ;
 
@@ -307,20 +588,27 @@
          } /* if */
 
       // Verify frame page write overflow control
+      //    The arena controls surround the buffer of the frame, also while
+      //    a mapped page value is used instead.
 
-         ASSERT_VER( memcmp( protectionBefore , BEFORE , PROTECTION_SIZE ) == 0 , 50 ) ;
-         ASSERT_VER( memcmp( protectionAfter  , AFTER  , PROTECTION_SIZE ) == 0 , 51 ) ;
+         VMC_FrameArena * pFrameArena = VMC_VirtualMemoryRoot::GetRoot( )->GetFrameArena( ) ;
+         ASSERT_VER( pFrameArena->IsUnderflowControlIntact( inxPageFrameElem ) , 50 ) ;
+         ASSERT_VER( pFrameArena->IsOverflowControlIntact( inxPageFrameElem ) , 51 ) ;
 
       // Verify frame in use
 
          if ( idSegment >= 0 )
          {
 
-            SEG_SegmentRoot * pRoot = SEG_SegmentRoot::GetRoot( ) ;
+            bool isSegmentOpen ;
+            {
+               std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+               isSegmentOpen = SEG_SegmentRoot::GetRoot( )->VerifyIdSeg( idSegment ) ;
+            }
 
             // Verify virtual address of frame
 
-               ASSERT_VER( pRoot->VerifyIdSeg( idSegment ) , 52 ) ;
+               ASSERT_VER( isSegmentOpen , 52 ) ;
 
          } // end selection: Verify frame in use
 
@@ -342,7 +630,7 @@
    void VMC_PageFrame :: DisplayPageFrame( int bytesPerLine )
    {
 
-      DisplayPageFrame( 0 , TAL_PageSize - 1 , bytesPerLine ) ;
+      DisplayPageFrame( 0 , pMetadata->pageSize - 1 , bytesPerLine ) ;
 
    } // End of function: VMF !Display frame
 
@@ -361,9 +649,9 @@
          inxByteFirst = 0 ;
       } /* if */
 
-      if ( inxByteLast >= TAL_PageSize )
+      if ( inxByteLast >= pMetadata->pageSize )
       {
-         inxByteLast = TAL_PageSize - 1 ;
+         inxByteLast = pMetadata->pageSize - 1 ;
       } /* if */
 
       if ( inxByteFirst >= inxByteLast )
@@ -428,16 +716,52 @@
    {
 
 
-      SEG_SegmentRoot::GetRoot( )->ReadPage( idSeg , idPag , &pageValue ) ;
+      {
+         std::unique_lock< std::mutex > ioLock( segmentIoMutex ) ;
+         VMC_VirtualMemoryRoot::GetRoot( )->GetSegmentPageRun( )->
+                   ReadRun( idSeg , idPag , pageValue , ioLock ) ;
+      }
 
       idSegment   = idSeg ;
       idPage      = idPag ;
 
-      changeLevel = TAL_NOT_CHANGED ;
-      numPins     = 0 ;
+      pMetadata->SetChangeLevel( inxPageFrameElem , TAL_NOT_CHANGED ) ;
+      pMetadata->SetNumPins( inxPageFrameElem , 0 ) ;
 
    } // End of function: VMF !Read page value into frame
 
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMF !Map page value into frame
+
+   void VMC_PageFrame ::
+             MapPageFrame( int idSeg ,
+                           int idPag ,
+                           char * pMappedValue )
+   {
+
+      pageValue   = pMappedValue ;
+
+      idSegment   = idSeg ;
+      idPage      = idPag ;
+
+      pMetadata->SetChangeLevel( inxPageFrameElem , TAL_NOT_CHANGED ) ;
+      pMetadata->SetNumPins( inxPageFrameElem , 0 ) ;
+
+   } // End of function: VMF !Map page value into frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMF !Is page value mapped
+
+   bool VMC_PageFrame ::
+             IsPageMapped( )
+   {
+
+      return pageValue != bufferValue ;
+
+   } // End of function: VMF !Is page value mapped
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 // Method: VMF !Write page value contained in frame
@@ -447,22 +771,42 @@
    {
 
 
+      VMC_CleanerLock stateLock ;
+
       if ( changeLevel < TAL_NOT_CHANGED )
       {
 
+         VMC_RedoLog * pRedoLog = VMC_VirtualMemoryRoot::GetRoot( )->GetRedoLog( ) ;
+         if ( pRedoLog != NULL )
+         {
+            pRedoLog->ForcePage( pMetadata->vtPageLsn[ inxPageFrameElem ] ,
+                                 idSegment , idPage ) ;
+         } /* if */
+
+         TAL_tpChangeLevel level = changeLevel ;
+         pMetadata->SetChangeLevel( inxPageFrameElem , TAL_NOT_CHANGED ) ;
+
+         std::unique_lock< std::mutex > ioLock( segmentIoMutex ) ;
+         stateLock.Unlock( ) ;
+
          try
          {
-            SEG_SegmentRoot::GetRoot( )->WritePage( idSegment , idPage , pageValue ) ;
-            changeLevel = TAL_NOT_CHANGED ;
+            VMC_VirtualMemoryRoot::GetRoot( )->GetSegmentPageRun( )->
+                      WriteRun( idSegment , idPage , pageValue ) ;
          }
          catch ( EXC_Exception * pExc )
          {
-            if ( changeLevel == TAL_IGNORABLE_CHANGE )
+            ioLock.unlock( ) ;
+            if ( level == TAL_IGNORABLE_CHANGE )
             {
-               changeLevel = TAL_NOT_CHANGED ;
                delete pExc ;
             } else
             {
+               VMC_CleanerLock restoreLock ;
+               if ( changeLevel > level )
+               {
+                  pMetadata->SetChangeLevel( inxPageFrameElem , level ) ;
+               } /* if */
                throw pExc ;
             } /* if */
          } /* end catch */
@@ -478,6 +822,7 @@
    void VMC_PageFrame :: PinFrame( )
    {
 
+      VMC_CleanerLock stateLock ;
 
       if ( numPins >= NUM_MAX_PINS )
       {
@@ -487,17 +832,13 @@
          EXC_PROGRAM( pMsg , -1 , TAL_NullIdHelp ) ;
       } /* if */
 
-      if ( numPins == 0 )
+      pMetadata->SetNumPins( inxPageFrameElem , numPins + 1 ) ;
+
+      if ( numPins == 1 )
       {
-         numPinnedFrames ++ ;
-         if ( numPinnedFrames > maxPinnedFrames )
-         {
-            maxPinnedFrames = numPinnedFrames ;
-         } /* if */
+         VMC_VirtualMemoryRoot::GetRoot( )->GetReplacementPolicy( )->OnPin( this ) ;
       } /* if */
 
-      numPins ++ ;
-
    } // End of function: VMF !Add a pin to a frame
 
 ////////////////////////////////////////////////////////////////////////////
@@ -507,14 +848,19 @@
    void VMC_PageFrame :: UnpinFrame( )
    {
 
+      VMC_CleanerLock stateLock ;
+
       if ( numPins > 0 )
       {
-         numPins -- ;
-         if ( ( numPins   <= 0 )
+         if ( ( numPins   <= 1 )
            || ( idSegment <  0 ))
          {
-            numPins = 0 ;
-            numPinnedFrames -- ;
+            pMetadata->SetNumPins( inxPageFrameElem , 0 ) ;
+
+            VMC_VirtualMemoryRoot::GetRoot( )->GetReplacementPolicy( )->OnUnpin( this ) ;
+         } else
+         {
+            numPins -- ;
          } /* if */
       } /* if */
 
@@ -527,13 +873,14 @@
    void VMC_PageFrame :: RemoveAllPins( void )
    {
 
+      VMC_CleanerLock stateLock ;
 
       if ( numPins > 0 )
       {
-         numPinnedFrames -- ;
-      } /* if */
+         pMetadata->SetNumPins( inxPageFrameElem , 0 ) ;
 
-      numPins = 0 ;
+         VMC_VirtualMemoryRoot::GetRoot( )->GetReplacementPolicy( )->OnUnpin( this ) ;
+      } /* if */
 
    } // End of function: VMF !Remove all pins from the frame
 
@@ -545,14 +892,24 @@
              SetFrameEmpty( )
    {
 
+      if ( pageValue != bufferValue )
+      {
+         madvise( pageValue , pMetadata->pageSize , MADV_DONTNEED ) ;
+         pageValue = bufferValue ;
+      } /* if */
 
-      SetPageValueUndefined( ) ;
+   // The fill leaves the change level and the dirty frame set alone
+
+   #ifndef VMC_RELEASE
+      memset( pageValue , VALUE_UNDEFINED , pMetadata->pageSize ) ;
+   #endif
 
       idSegment      = TAL_NullIdSeg ;
       idPage         = TAL_NullIdPag ;
 
-      changeLevel    = TAL_NOT_CHANGED ;
-      numPins        = 0 ;
+      pMetadata->SetChangeLevel( inxPageFrameElem , TAL_NOT_CHANGED ) ;
+      pMetadata->vtPageLsn[ inxPageFrameElem ] = 0 ;
+      pMetadata->SetNumPins( inxPageFrameElem , 0 ) ;
 
    } // End of function: VMF !Set frame empty
 
@@ -564,8 +921,8 @@
              SetPageValueUndefined( )
    {
 
-      memset( pageValue , VALUE_UNDEFINED , TAL_PageSize  ) ;
-      changeLevel = TAL_CHANGED ;
+      memset( pageValue , VALUE_UNDEFINED , pMetadata->pageSize ) ;
+      pMetadata->SetChangeLevel( inxPageFrameElem , TAL_CHANGED ) ;
 
    } // End of function: VMF !Set page value to undefined chars
 
@@ -603,8 +960,13 @@
    {
 
 
-      if ( SEG_SegmentRoot::GetRoot( )->GetSegmentOpeningMode( idSegment ) ==
-                TAL_OpeningModeRead )
+      TAL_tpOpeningMode openingMode ;
+      {
+         VMC_CleanerLock stateLock ;
+         openingMode = VMC_VirtualMemoryRoot::GetRoot( )->GetOpeningMode( idSegment ) ;
+      }
+
+      if ( openingMode == TAL_OpeningModeRead )
       {
          if ( level == TAL_IGNORABLE_CHANGE )
          {
@@ -616,9 +978,11 @@
          EXC_USAGE( pMsg , -1 , TAL_NullIdHelp ) ;
       } /* if */
 
+      VMC_CleanerLock stateLock ;
+
       if ( changeLevel > level )
       {
-         changeLevel = level ;
+         pMetadata->SetChangeLevel( inxPageFrameElem , level ) ;
       } /* if */
 
    } // End of function: VMF !Set frame dirty
@@ -640,6 +1004,16 @@
 
       SetFrameDirty( level ) ;
 
+      VMC_RedoLog * pRedoLog = VMC_VirtualMemoryRoot::GetRoot( )->GetRedoLog( ) ;
+      if ( ( pRedoLog != NULL )
+        && ( level == TAL_CHANGED ))
+      {
+         VMC_CleanerLock stateLock ;
+         pMetadata->vtPageLsn[ inxPageFrameElem ] = pRedoLog->AppendData( idSegment ,
+                   static_cast< long long >( idPage ) * pMetadata->pageSize + offset ,
+                   length , pageValue + offset ) ;
+      } /* if */
+
    } // End of function: VMF !Set page data
 
 ////////////////////////////////////////////////////////////////////////////
@@ -722,6 +1096,28 @@
 
    } // End of function: VMF !Get number of pins of the frame
 
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMF !Detach page value
+
+   TAL_tpChangeLevel VMC_PageFrame ::
+             DetachPageValue( char * pBuffer )
+   {
+
+      VMC_CleanerLock stateLock ;
+
+      TAL_tpChangeLevel level = changeLevel ;
+
+      if ( level < TAL_NOT_CHANGED )
+      {
+         memcpy( pBuffer , pageValue , pMetadata->pageSize ) ;
+         pMetadata->SetChangeLevel( inxPageFrameElem , TAL_NOT_CHANGED ) ;
+      } /* if */
+
+      return level ;
+
+   } // End of function: VMF !Detach page value
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 // Method: VMF !Get dirty flag
@@ -730,10 +1126,26 @@
              GetDirtyFlag( )
    {
 
+      VMC_CleanerLock stateLock ;
+
       return changeLevel ;
 
    } // End of function: VMF !Get dirty flag
 
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMF !Get page log sequence number
+
+   long long VMC_PageFrame ::
+             GetPageLsn( )
+   {
+
+      VMC_CleanerLock stateLock ;
+
+      return pMetadata->vtPageLsn[ inxPageFrameElem ] ;
+
+   } // End of function: VMF !Get page log sequence number
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 // Method: VMF !Get segment file name
@@ -744,6 +1156,7 @@
 
       if ( idSegment >= 0 )
       {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
          return SEG_SegmentRoot::GetRoot( )->GetSegmentFileName( idSegment ) ;
       } /* if */
 
@@ -762,6 +1175,7 @@
 
       if ( idSegment >= 0 )
       {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
          return SEG_SegmentRoot::GetRoot( )->GetSegmentFullName( idSegment ) ;
       } /* if */
 
@@ -793,11 +1207,35 @@
 
    void VMC_VirtualMemoryRoot ::
              CreateRoot( int minFrames ,
-                         int maxFrames  )
+                         int maxFrames ,
+                         VMC_tpReplacementPolicy policy ,
+                         VMC_tpArenaPages arenaPages ,
+                         int pageSize )
+   {
+
+
+      CreateRoot( minFrames , maxFrames ,
+                  VMC_ReplacementPolicy::CreatePolicy( policy ) , arenaPages ,
+                  pageSize ) ;
+
+   } // End of function: VMR !:Virtual memory root create
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !:Virtual memory root create with a given policy object
+
+   void VMC_VirtualMemoryRoot ::
+             CreateRoot( int minFrames ,
+                         int maxFrames ,
+                         VMC_ReplacementPolicy * pPolicy ,
+                         VMC_tpArenaPages arenaPages ,
+                         int pageSize )
    {
 
 
-      pVirtualMemoryRoot = new VMC_VirtualMemoryRoot( minFrames , maxFrames ) ;
+      pVirtualMemoryRoot = new VMC_VirtualMemoryRoot( minFrames , maxFrames ,
+                                                      pPolicy , arenaPages ,
+                                                      pageSize ) ;
 
       if ( pVirtualMemoryRoot == NULL )
       {
@@ -805,7 +1243,7 @@
          EXC_PROGRAM( pMsg , -1 , TAL_NullIdHelp ) ;
       } /* if */
 
-   } // End of function: VMR !:Virtual memory root create
+   } // End of function: VMR !:Virtual memory root create with a given policy object
 
 ////////////////////////////////////////////////////////////////////////////
 // 
@@ -815,17 +1253,41 @@
              DestroyRoot( )
    {
 
+      if ( pVirtualMemoryRoot != NULL )
+      {
+         pVirtualMemoryRoot->StopPageInThreads( ) ;
+         pVirtualMemoryRoot->StopTailCleaner( ) ;
+         pVirtualMemoryRoot->StopDirtyFlusher( ) ;
+
+         // A log that cannot be checkpointed is kept, it redoes the
+         // changes not written when it is opened again.
+
+         try
+         {
+            pVirtualMemoryRoot->CloseLog( ) ;
+         }
+         catch ( EXC_Exception * pExc )
+         {
+            delete pExc ;
+         } /* end catch */
+      } /* if */
+
       SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
 
       if ( pSegRoot != NULL )
       {
          int idS = TAL_NullIdSeg ;
 
-         idS = pSegRoot->GetNextIdSegment( idS ) ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            idS = pSegRoot->GetNextIdSegment( idS ) ;
+         }
 
          while ( idS != TAL_NullIdSeg )
          {
             VMC_VirtualMemoryRoot::GetRoot( )->RemoveSegment( idS ) ;
+
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
             pSegRoot->CloseSegment( idS ) ;
             idS = pSegRoot->GetNextIdSegment( idS ) ;
          } /* while */
@@ -848,6 +1310,7 @@
                              int idPag  )
    {
 
+      VMC_CleanerLock rootLock ;
 
       VMC_PageFrameElement * pPageFrameElem = SearchRealPage( idSeg , idPag ) ;
       if ( pPageFrameElem != NULL )
@@ -855,10 +1318,10 @@
          return true ;
       } /* if */
 
-      pPageFrameElem = lruListTail ;
-      if ( pPageFrameElem->frameType == FRAME_TYPE_FREE )
+      pPageFrameElem = GetFreeFrameElement( ) ;
+      if ( pPageFrameElem != NULL )
       {
-         ReplacePage( pPageFrameElem , idSeg , idPag , false ) ;
+         ReplacePage( pPageFrameElem , idSeg , idPag , false , false ) ;
          totalAccessCounter ++ ;
 
          return true ;
@@ -889,6 +1352,7 @@
              VerifyVirtualMemory( TAL_tpVerifyMode verifyMode )
    {
 
+      VMC_CleanerLock rootLock ;
 
       VMC_PageFrameElement * pPageFrameElem = NULL ;
 
@@ -929,7 +1393,7 @@
 
          ASSERT_VER( VerifyCorrectOpenPageCount( ) == 0 , 34 ) ;
 
-      // Verify hash table and colision lists
+      // Verify page table
 
          if ( envelope.pMsg != NULL )
          {
@@ -937,107 +1401,273 @@
            envelope.pMsg = new MSG_Message( VMC_ErrorRootElemVerify ) ;
          } /* if */
 
-         for ( int inxHash = 0 ; inxHash < TAL_dimColision ; inxHash++ )
+         int countEntries = 0 ;
+
+         for ( int inxSlot = 0 ; inxSlot < numPageTableSlots ; inxSlot++ )
          {
-            pPageFrameElem = vtColision[ inxHash ] ;
-            while ( pPageFrameElem != NULL )
+            VMC_PageTableSlot * pSlot = &vtPageTableSlot[ inxSlot ] ;
+            if ( pSlot->key == EMPTY_PAGE_KEY )
             {
-               if ( envelope.pMsg != NULL )
-               {
-                  envelope.pMsg->AddItem( 1 , new MSG_ItemInteger(
-                            pPageFrameElem->inxFrameElement )) ;
-               } /* if */
+               continue ;
+            } /* if */
 
-               ASSERT_VER( pPageFrameElem->frameType == FRAME_TYPE_IN_USE , 4 ) ;
+            countEntries ++ ;
 
-               ASSERT_VER( pPageFrameElem->inxHash   == inxHash , 5 ) ;
-               int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
-               int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
-               ASSERT_VER( idSeg >= 0 , 6 ) ;
-               ASSERT_VER( idPag >= 0 , 7 ) ;
-               if ( ( idSeg >= 0 ) && ( idPag >= 0 ))
-               {
-                  ASSERT_VER( inxHash == ComputeInxHash( idSeg , idPag ) , 8 ) ;
-               } /* if */
+            bool isFrameIndex = ( pSlot->inxFrameElement >= 0 )
+                             && ( pSlot->inxFrameElement < numPageFrames ) ;
+            ASSERT_VER( isFrameIndex , 4 ) ;
+            if ( !isFrameIndex )
+            {
+               continue ;
+            } /* if */
+
+            pPageFrameElem = vtPageFrameElem[ pSlot->inxFrameElement ] ;
+
+            if ( envelope.pMsg != NULL )
+            {
+               envelope.pMsg->AddItem( 1 , new MSG_ItemInteger(
+                         pPageFrameElem->inxFrameElement )) ;
+            } /* if */
+
+            ASSERT_VER( ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+                     || ( pPageFrameElem->frameType == FRAME_TYPE_READING ) , 4 ) ;
+
+            ASSERT_VER( pPageFrameElem->inxHash == inxSlot , 5 ) ;
+            int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
+            int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
+            ASSERT_VER( idSeg >= 0 , 6 ) ;
+            ASSERT_VER( idPag >= 0 , 7 ) ;
+            if ( ( idSeg >= 0 ) && ( idPag >= 0 ))
+            {
+               ASSERT_VER( pSlot->key == ComputePageKey( idSeg , idPag ) , 8 ) ;
+
+               int inxProbe = ComputeInxHash( idSeg , idPag ) ;
+               while ( ( inxProbe != inxSlot )
+                    && ( vtPageTableSlot[ inxProbe ].key != EMPTY_PAGE_KEY ))
+               {
+                  inxProbe = ( inxProbe + 1 ) & ( numPageTableSlots - 1 ) ;
+               } /* while */
+               ASSERT_VER( inxProbe == inxSlot , 9 ) ;
+            } /* if */
+         } /* for */
 
-               if ( pPageFrameElem->nextColisionElem != NULL )
+         ASSERT_VER( countEntries == numPageTableEntries , 10 ) ;
+
+      // Verify direct page maps
+
+         int countDirect = 0 ;
+
+         for ( int idSeg = 0 ; idSeg < dimSegmentMap ; idSeg++ )
+         {
+            VMC_SegmentPageMap * pMap = &vtSegmentMap[ idSeg ] ;
+
+            int countResident = 0 ;
+            for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+            {
+               if ( ( ( pFrameMetadata->vtFrameType[ inxFrame ] == FRAME_TYPE_IN_USE )
+                   || ( pFrameMetadata->vtFrameType[ inxFrame ] == FRAME_TYPE_READING ))
+                 && ( pFrameMetadata->vtIdSegment[ inxFrame ] == idSeg ))
                {
-                  ASSERT_VER( pPageFrameElem->nextColisionElem->
-                            prevColisionElem == pPageFrameElem , 9 ) ;
+                  countResident ++ ;
                } /* if */
-               if ( pPageFrameElem->prevColisionElem != NULL )
+            } /* for */
+
+            ASSERT_VER( countResident == pMap->numResident , 38 ) ;
+
+            if ( pMap->vtInxFrame == NULL )
+            {
+               continue ;
+            } /* if */
+
+            countResident = 0 ;
+            for ( int idPag = 0 ; idPag < pMap->dimMap ; idPag++ )
+            {
+               int inxFrame = pMap->vtInxFrame[ idPag ] ;
+               if ( inxFrame < 0 )
                {
-                  ASSERT_VER( pPageFrameElem->prevColisionElem->
-                            nextColisionElem == pPageFrameElem , 10 ) ;
+                  continue ;
                } /* if */
 
-               pPageFrameElem = pPageFrameElem->nextColisionElem ;
-            } /* while */
+               countResident ++ ;
+
+               bool isFrameIndex = ( inxFrame < numPageFrames ) ;
+               ASSERT_VER( isFrameIndex , 37 ) ;
+               if ( isFrameIndex )
+               {
+                  VMC_PageFrame * pPageFrame = vtPageFrameElem[ inxFrame ]->pPageFrame ;
+                  ASSERT_VER( ( pPageFrame->GetIdSeg( ) == idSeg )
+                           && ( pPageFrame->GetIdPag( ) == idPag ) , 37 ) ;
+               } /* if */
+            } /* for */
+
+            ASSERT_VER( countResident == pMap->numResident , 38 ) ;
+            countDirect += countResident ;
          } /* for */
 
-      // Verify LRU list anchors
+         ASSERT_VER( numPageTableEntries + countDirect ==
+                   numPageFrames - numFreeFrames - numReleasedFrames , 10 ) ;
+
+      // Verify replacement policy
 
          if ( envelope.pMsg != NULL )
          {
             envelope.pMsg->AddItem( 1 , new MSG_ItemInteger( -1 )) ;
          } /* if */
 
-         ASSERT_VER( numPageFrames >= numMinFrames , 11 ) ;
+         ASSERT_VER( ( numPageFrames - numReleasedFrames >= minPageFrames )
+                  && ( numPageFrames <= maxPageFrames ) , 11 ) ;
+
+         ASSERT_VER( pReplacementPolicy->VerifyPolicy( verifyMode ) == 0 , 42 ) ;
+
+      // Verify free list
 
-         if ( lruListHead != NULL )
+         int countFree = 0 ;
+         pPageFrameElem = pFreeListHead ;
+         while ( ( pPageFrameElem != NULL )
+              && ( countFree <= numPageFrames ))
          {
-            ASSERT_VER( lruListHead->prevLruElem == NULL  , 12 ) ;
-         } else
+            if ( envelope.pMsg != NULL )
+            {
+               envelope.pMsg->AddItem( 1 , new MSG_ItemInteger(
+                         pPageFrameElem->inxFrameElement )) ;
+            } /* if */
+
+            ASSERT_VER( pPageFrameElem->frameType == FRAME_TYPE_FREE , 43 ) ;
+            ASSERT_VER( !pPageFrameElem->isPrefetched , 47 ) ;
+
+            countFree ++ ;
+            pPageFrameElem = pPageFrameElem->nextFreeElem ;
+         } /* while */
+
+         ASSERT_VER( countFree == numFreeFrames , 44 ) ;
+
+      // Verify dirty frame set
+
+         int countDirty = 0 ;
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
          {
-            ASSERT_VER( lruListHead != NULL , 13 ) ;
-            return false ;
-         } /* if */
+            int inxDirty = pFrameMetadata->vtInxDirty[ inxFrame ] ;
+            if ( pFrameMetadata->vtChangeLevel[ inxFrame ] < TAL_NOT_CHANGED )
+            {
+               ASSERT_VER( ( inxDirty >= 0 )
+                        && ( inxDirty < pFrameMetadata->numDirtyFrames )
+                        && ( pFrameMetadata->vtDirtyFrame[ inxDirty ] == inxFrame ) , 48 ) ;
+               countDirty ++ ;
+            } else
+            {
+               ASSERT_VER( inxDirty == -1 , 48 ) ;
+            } /* if */
+         } /* for */
+
+         ASSERT_VER( countDirty == pFrameMetadata->numDirtyFrames , 48 ) ;
 
-         if ( lruListTail != NULL )
+      // Verify pinned frame count
+
+         int countPinned = 0 ;
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
          {
-            ASSERT_VER( lruListTail->nextLruElem == NULL , 14 ) ;
-         } else
+            countPinned += ( pFrameMetadata->vtNumPins[ inxFrame ] > 0 ) ;
+         } /* for */
+
+         ASSERT_VER( countPinned == pFrameMetadata->numPinnedFrames , 41 ) ;
+
+         int countEmpty = 0 ;
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
          {
-            ASSERT_VER( lruListTail != NULL , 15 ) ;
-            return false ;
-         } /* if */
+            if ( pFrameMetadata->vtFrameType[ inxFrame ] == FRAME_TYPE_FREE )
+            {
+               countEmpty ++ ;
+            } /* if */
+
+            VMC_PageFrame * pPageFrame = vtPageFrameElem[ inxFrame ]->pPageFrame ;
+            if ( pPageFrame->IsPageMapped( ))
+            {
+               ASSERT_VER( pPageFrame->GetPageValue( ) == GetMappedValue(
+                         pPageFrame->GetIdSeg( ) , pPageFrame->GetIdPag( )) , 49 ) ;
+            } /* if */
+         } /* for */
+
+         ASSERT_VER( countEmpty == numFreeFrames , 44 ) ;
 
-      // Verify all LRU list page frames
+      // Verify released list
 
-         pPageFrameElem = lruListHead ;
-         while ( pPageFrameElem != NULL )
+         int countReleased = 0 ;
+         pPageFrameElem = pReleasedListHead ;
+         while ( ( pPageFrameElem != NULL )
+              && ( countReleased <= numPageFrames ))
          {
             if ( envelope.pMsg != NULL )
             {
                envelope.pMsg->AddItem( 1 , new MSG_ItemInteger(
                          pPageFrameElem->inxFrameElement )) ;
             } /* if */
-            if ( pPageFrameElem->nextLruElem != NULL )
-            {
-               ASSERT_VER( pPageFrameElem->nextLruElem->prevLruElem ==
-                         pPageFrameElem , 16 ) ;
-            } else
+
+            ASSERT_VER( pPageFrameElem->frameType == FRAME_TYPE_RELEASED , 45 ) ;
+
+            countReleased ++ ;
+            pPageFrameElem = pPageFrameElem->nextFreeElem ;
+         } /* while */
+
+         ASSERT_VER( countReleased == numReleasedFrames , 46 ) ;
+
+         countReleased = 0 ;
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+         {
+            if ( pFrameMetadata->vtFrameType[ inxFrame ] == FRAME_TYPE_RELEASED )
             {
-               ASSERT_VER( pPageFrameElem == lruListTail , 18 ) ;
+               countReleased ++ ;
             } /* if */
+         } /* for */
 
-            if ( pPageFrameElem->prevLruElem != NULL )
-            {
-               ASSERT_VER( pPageFrameElem->prevLruElem->nextLruElem ==
-                         pPageFrameElem , 20 ) ;
-            } else
+         ASSERT_VER( countReleased == numReleasedFrames , 46 ) ;
+
+      // Verify all page frames
+
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+         {
+            pPageFrameElem = vtPageFrameElem[ inxFrame ] ;
+
+            if ( envelope.pMsg != NULL )
             {
-               ASSERT_VER( pPageFrameElem == lruListHead , 22 ) ;
+               envelope.pMsg->AddItem( 1 , new MSG_ItemInteger(
+                         pPageFrameElem->inxFrameElement )) ;
             } /* if */
 
-            if ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+            if ( ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+              || ( pPageFrameElem->frameType == FRAME_TYPE_READING ))
             {
-               ASSERT_VER( pPageFrameElem->inxHash >= 0 , 24 ) ;
-               ASSERT_VER( pPageFrameElem->inxHash < TAL_dimColision , 25 ) ;
-               ASSERT_VER( vtColision[ pPageFrameElem->inxHash ] != NULL , 26 ) ;
+               int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
+               int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
+
+               if ( pCompressedTier != NULL )
+               {
+                  ASSERT_VER( !pCompressedTier->ContainsPage(
+                            ComputePageKey( idSeg , idPag ) , false ) , 61 ) ;
+               } /* if */
+
+               if ( ( idSeg >= 0 )
+                 && ( idSeg < dimSegmentMap )
+                 && ( vtSegmentMap[ idSeg ].vtInxFrame != NULL ))
+               {
+                  ASSERT_VER( pPageFrameElem->inxHash < 0 , 24 ) ;
+                  ASSERT_VER( ( idPag >= 0 )
+                           && ( idPag < vtSegmentMap[ idSeg ].dimMap )
+                           && ( vtSegmentMap[ idSeg ].vtInxFrame[ idPag ] == inxFrame ) , 37 ) ;
+               } else
+               {
+                  ASSERT_VER( pPageFrameElem->inxHash >= 0 , 24 ) ;
+                  ASSERT_VER( pPageFrameElem->inxHash < numPageTableSlots , 25 ) ;
+                  if ( ( pPageFrameElem->inxHash >= 0 )
+                    && ( pPageFrameElem->inxHash < numPageTableSlots ))
+                  {
+                     ASSERT_VER( vtPageTableSlot[ pPageFrameElem->inxHash ].
+                               inxFrameElement == inxFrame , 26 ) ;
+                  } /* if */
+               } /* if */
             } else
             {
-               ASSERT_VER( pPageFrameElem->frameType == FRAME_TYPE_FREE , 27 ) ;
+               ASSERT_VER( ( pPageFrameElem->frameType == FRAME_TYPE_FREE )
+                        || ( pPageFrameElem->frameType == FRAME_TYPE_RELEASED ) , 27 ) ;
                ASSERT_VER( pPageFrameElem->inxHash <  0 , 28 ) ;
                ASSERT_VER( pPageFrameElem->pPageFrame->GetIdSeg( ) < 0 , 29 ) ;
                ASSERT_VER( pPageFrameElem->pPageFrame->GetIdPag( ) < 0 , 30 ) ;
@@ -1046,14 +1676,20 @@
             ASSERT_VER( pPageFrameElem->pPageFrame->GetInxPageFrameElem( ) ==
                       pPageFrameElem->inxFrameElement , 31 ) ;
 
+            ASSERT_VER( pPageFrameElem->inxFrameElement == inxFrame , 36 ) ;
+
             ASSERT_VER( pPageFrameElem->pPageFrame->VerifyPageFrame(
                       verifyMode ) == 0 , 32 )
 
-            pPageFrameElem = pPageFrameElem->nextLruElem ;
-         } /* while */
+         } /* for */
 
       ASSERT_VER( VerifyCorrectOpenPageCount( ) == 0 , 35 ) ;
 
+      if ( pCompressedTier != NULL )
+      {
+         ASSERT_VER( pCompressedTier->VerifyTier( ) , 60 ) ;
+      } /* if */
+
       return numErrors ;
 
    } // End of function: VMR !Verify virtual memory root object
@@ -1066,19 +1702,20 @@
              CountOpenPages( int idSeg )
    {
 
-      VMC_PageFrameElement * pPageFrameElem = lruListHead ;
+      VMC_CleanerLock rootLock ;
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
 
       SEG_SegmentRoot::GetRoot( )->StartOpenPageCounter( idSeg ) ;
 
-      while ( pPageFrameElem != NULL )
+      const int * vtIdSegment = pFrameMetadata->vtIdSegment ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
       {
-         if ( pPageFrameElem->pPageFrame->GetIdSeg( ) == idSeg )
+         if ( vtIdSegment[ inxFrame ] == idSeg )
          {
             SEG_SegmentRoot::GetRoot( )->CountOpenPage( idSeg ) ;
          } /* if */
-
-         pPageFrameElem = pPageFrameElem->nextLruElem ;
-      } /* while */
+      } /* for */
 
       return SEG_SegmentRoot::GetRoot( )->GetOpenPageCounter( idSeg ) ;
 
@@ -1092,19 +1729,21 @@
              VerifyOpenPages( TAL_tpVerifyMode verifyMode )
    {
 
+      VMC_CleanerLock rootLock ;
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+
       SEG_SegmentRoot::GetRoot( )->StartAllCounters( ) ;
-      VMC_PageFrameElement * pPageFrameElem = lruListHead ;
 
-      while ( pPageFrameElem != NULL )
+      const int * vtIdSegment = pFrameMetadata->vtIdSegment ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
       {
-         int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
+         int idSeg = vtIdSegment[ inxFrame ] ;
          if ( idSeg >= 0 )
          {
             SEG_SegmentRoot::GetRoot( )->CountOpenPage( idSeg ) ;
          } /* if */
-         pPageFrameElem = pPageFrameElem->nextLruElem ;
-
-      } /* while */
+      } /* for */
 
       return SEG_SegmentRoot::GetRoot( )->
                 VerifyOpenPageCounters( verifyMode )  ;
@@ -1119,14 +1758,14 @@
              DisplayStatistics( )
    {
 
+      VMC_CleanerLock rootLock ;
+
       int numUsedFrames     = 0 ;
       int countPinned       = 0 ;
 
-      int minColisionSize  = 32767 ;
-      int maxColisionSize  = 0 ;
-      int sumColisionSize  = 0 ;
-      int numColisionLists = 0 ;
-      int countColisions   = 0 ;
+      int maxProbeLength    = 0 ;
+      int sumProbeLength    = 0 ;
+      int numDirectMaps     = 0 ;
 
       // Gather statistics about all frames in use
 
@@ -1134,74 +1773,247 @@
          pLogger->Log( "" ) ;
          pLogger->Log( STR_GetStringAddress( VMC_FormatStatTitle )) ;
 
-         for ( int inxHash = 0 ; inxHash < TAL_dimColision ; inxHash++ ) {
-
-         // Gather statistics of a colision list
+         for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+         {
+            if ( pFrameMetadata->vtFrameType[ inxFrame ] != FRAME_TYPE_IN_USE )
+            {
+               continue ;
+            } /* if */
 
-            countColisions = 0 ;
-            VMC_PageFrameElement * pPageFrameElem = vtColision[ inxHash ] ;
+            numUsedFrames ++ ;
 
-            while ( pPageFrameElem != NULL )
+            if ( pFrameMetadata->vtNumPins[ inxFrame ] > 0 )
             {
-               countColisions ++ ;
-               numUsedFrames   ++ ;
+               countPinned ++ ;
+            } /* if */
 
-               if ( pPageFrameElem->pPageFrame->GetNumPins( ) > 0 )
-               {
-                  countPinned ++ ;
-               } /* if */
-               pPageFrameElem = pPageFrameElem->nextColisionElem ;
-            } /* while */
+            VMC_PageFrameElement * pPageFrameElem = vtPageFrameElem[ inxFrame ] ;
 
-         // Compute min, max and mean colision list size.
+         // Compute the number of slots probed to find the page
 
-            if ( countColisions > 0 )
+            if ( pPageFrameElem->inxHash < 0 )
             {
-               numColisionLists ++ ;
+               continue ;
+            } /* if */
 
-               if ( minColisionSize > countColisions )
-               {
-                  minColisionSize =   countColisions ;
-               } /* if */
-               if ( maxColisionSize < countColisions )
-               {
-                  maxColisionSize =   countColisions ;
-               } /* if */
-               sumColisionSize += countColisions ;
+            int inxHome = ComputeInxHash( pPageFrameElem->pPageFrame->GetIdSeg( ) ,
+                                          pPageFrameElem->pPageFrame->GetIdPag( )) ;
+            int probeLength = (( pPageFrameElem->inxHash - inxHome ) &
+                                 ( numPageTableSlots - 1 )) + 1 ;
+
+            if ( maxProbeLength < probeLength )
+            {
+               maxProbeLength = probeLength ;
             } /* if */
+            sumProbeLength += probeLength ;
 
          } // end repetition: Gather statistics about all frames in use
 
+         for ( int idSeg = 0 ; idSeg < dimSegmentMap ; idSeg++ )
+         {
+            if ( vtSegmentMap[ idSeg ].vtInxFrame != NULL )
+            {
+               numDirectMaps ++ ;
+            } /* if */
+         } /* for */
+
       // Print statistics
 
-         char msg[ 100 ] ;
-         sprintf( msg , STR_GetStringAddress( VMC_FormatStatPins ) ,
-                 TAL_PageSize , numPageFrames , numUsedFrames , countPinned , maxPinnedFrames ) ;
+         char msg[ DIM_STAT_LINE ] ;
+         snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatPins ) ,
+                 pageSize , numPageFrames - numReleasedFrames , numUsedFrames ,
+                 countPinned , pFrameMetadata->maxPinnedFrames ) ;
+         pLogger->Log( msg ) ;
+
+         snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatPool ) ,
+                 numPageFrames - numReleasedFrames , minPageFrames , maxPageFrames ,
+                 totalGrowCounter , totalReleaseCounter ) ;
          pLogger->Log( msg ) ;
 
          double hitRate = totalHitCounter ;
          hitRate = hitRate * 100.0 / totalAccessCounter ;
 
-         sprintf( msg , STR_GetStringAddress( VMC_FormatStatAccess ) ,
+         snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatAccess ) ,
                  totalAccessCounter , totalReplaceCounter , totalHitCounter ,
                  hitRate ) ;
 
          pLogger->Log( msg ) ;
 
-         sprintf( msg , STR_GetStringAddress( VMC_FormatStatTotals ) ,
-                 SEG_SegmentRoot::GetRoot( )->GetTotalPagesRead( ) ,
-                 SEG_SegmentRoot::GetRoot( )->GetTotalPagesWritten( ) ,
-                 SEG_SegmentRoot::GetRoot( )->GetTotalPagesAdded( ) ) ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatTotals ) ,
+                    SEG_SegmentRoot::GetRoot( )->GetTotalPagesRead( ) ,
+                    SEG_SegmentRoot::GetRoot( )->GetTotalPagesWritten( ) ,
+                    SEG_SegmentRoot::GetRoot( )->GetTotalPagesAdded( ) ) ;
+         }
+
+         pLogger->Log( msg ) ;
+         double meanProbeLength = 0 ;
+         if ( numPageTableEntries > 0 )
+         {
+            meanProbeLength = sumProbeLength ;
+            meanProbeLength = meanProbeLength / numPageTableEntries ;
+         } /* if */
+
+         if ( totalLookasideSearches > 0 )
+         {
+            double lookasideRate = totalLookasideHits ;
+            lookasideRate = lookasideRate * 100.0 / totalLookasideSearches ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatLookaside ) ,
+                    totalLookasideSearches , totalLookasideHits , lookasideRate ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
 
+         snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatPageTable ) ,
+                 numPageTableSlots , numPageTableEntries , maxProbeLength ,
+                 meanProbeLength , numDirectMaps ) ;
          pLogger->Log( msg ) ;
-         if ( numColisionLists > 0 )
+
+         pFrameArena->DisplayStatistics( pLogger ) ;
+
+         if ( pWriteBehindQueue != NULL )
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatWriteBehind ) ,
+                    pWriteBehindQueue->GetTotalScheduled( )) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( pPageInQueue != NULL )
+         {
+            int numThreads ;
+            int numReads ;
+            int maxInFlight ;
+            pPageInQueue->GetCounters( &numThreads , &numReads , &maxInFlight ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatPageIn ) ,
+                    numThreads , numReads , maxInFlight ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( totalFlushRunCounter > 0 )
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatFlush ) ,
+                    totalFlushPageCounter , totalFlushRunCounter ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         int numMappedSegments = 0 ;
+         for ( int idSeg = 0 ; idSeg < dimSegmentMap ; idSeg++ )
+         {
+            if ( vtSegmentMap[ idSeg ].pMapping != NULL )
+            {
+               numMappedSegments ++ ;
+            } /* if */
+         } /* for */
+
+         if ( ( numMappedSegments > 0 )
+           || ( totalMapCounter > 0 ))
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatMapped ) ,
+                    numMappedSegments , totalMapCounter ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         int numDirectSegments ;
+         int numDirectReads ;
+         int numDirectWrites ;
+         int numDirectFallbacks ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            pSegmentPageRun->GetDirectCounters( &numDirectSegments ,
+                      &numDirectReads , &numDirectWrites , &numDirectFallbacks ) ;
+         }
+
+         if ( ( numDirectSegments > 0 )
+           || ( numDirectReads + numDirectWrites + numDirectFallbacks > 0 ))
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatDirectIo ) ,
+                    numDirectSegments , numDirectReads , numDirectWrites , numDirectFallbacks ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         int numChecksumPages ;
+         int numChecksumMismatches ;
+         int numChecksumUnverified ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            pSegmentPageRun->GetChecksumCounters( &numChecksumPages ,
+                      &numChecksumMismatches , &numChecksumUnverified ) ;
+         }
+
+         if ( numChecksumPages > 0 )
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatChecksum ) ,
+                    numChecksumPages , numChecksumMismatches , numChecksumUnverified ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( pCompressedTier != NULL )
+         {
+            int arenaSize ;
+            int numPages ;
+            int numHits ;
+            int numMisses ;
+            int numStored ;
+            int numDropped ;
+            double ratio ;
+            pCompressedTier->GetCounters( &arenaSize , &numPages , &numHits ,
+                      &numMisses , &numStored , &numDropped , &ratio ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatTier ) ,
+                    arenaSize / 1024 , numPages , numHits , numMisses ,
+                    numStored , numDropped , ratio ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( pRedoLog != NULL )
+         {
+            int numRecords ;
+            int numCommits ;
+            int numSyncs ;
+            int numCheckpoints ;
+            long long numBytes ;
+            pRedoLog->GetCounters( &numRecords , &numCommits , &numSyncs ,
+                                   &numCheckpoints , &numBytes ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatLog ) ,
+                    numRecords , numCommits ,
+                    numSyncs , numCheckpoints , static_cast< int >( numBytes / 1024 )) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( maxReadAhead > 0 )
+         {
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatReadAhead ) ,
+                    maxReadAhead , totalPrefetchCounter , totalPrefetchHitCounter ,
+                    totalPrefetchWasteCounter ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( pTailCleaner != NULL )
+         {
+            int numScans ;
+            int numCleanings ;
+            int numWrites ;
+            int numFailures ;
+            pTailCleaner->GetCounters( &numScans , &numCleanings ,
+                                       &numWrites , &numFailures ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatCleaner ) ,
+                    numScans , numCleanings , numWrites , numFailures ) ;
+            pLogger->Log( msg ) ;
+         } /* if */
+
+         if ( pDirtyFlusher != NULL )
          {
-            double sumCol = sumColisionSize ;
-            sprintf( msg , STR_GetStringAddress( VMC_FormatStatColl ) ,
-                    minColisionSize , maxColisionSize ,
-                    sumCol / numColisionLists ) ;
+            int numPasses ;
+            int numFlushes ;
+            int numWrites ;
+            int numFailures ;
+            pDirtyFlusher->GetCounters( &numPasses , &numFlushes ,
+                                        &numWrites , &numFailures ) ;
+            snprintf( msg , sizeof( msg ) , STR_GetStringAddress( VMC_FormatStatFlusher ) ,
+                    numPasses , numFlushes , numWrites , numFailures ) ;
             pLogger->Log( msg ) ;
          } /* if */
+
+         pReplacementPolicy->DisplayStatistics( pLogger ) ;
          pLogger->Log( "" ) ;
 
    } // End of function: VMR !Display virtual memory usage statistics
@@ -1214,6 +2026,8 @@
              DisplayPinnedFrameList( )
    {
 
+      VMC_CleanerLock rootLock ;
+
       LOG_Logger * pLogger = GLB_GetGlobal( )->GetEventLogger( ) ;
       pLogger->Log( STR_GetStringAddress( VMC_FormatPinList )) ;
 
@@ -1224,12 +2038,15 @@
       char  buffer[ dimBuffer ] ;
 
       int  count = 0 ;
-      VMC_PageFrameElement * pPageFrameElem = lruListHead ;
 
-      while ( pPageFrameElem != NULL )
+      const int * vtNumPins = pFrameMetadata->vtNumPins ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
       {
-         if ( pPageFrameElem->pPageFrame->GetNumPins( ) != 0 )
+         if ( vtNumPins[ inxFrame ] != 0 )
          {
+            VMC_PageFrameElement * pPageFrameElem = vtPageFrameElem[ inxFrame ] ;
+
             if ( count % 2 == 0 )
             {
                pLogger->Log( "    " ) ;
@@ -1247,8 +2064,7 @@
             pLogger->Log( msg , false ) ;
             count ++ ;
          } /* if */
-         pPageFrameElem = pPageFrameElem->nextLruElem ;
-      } /* while */
+      } /* for */
       if ( count == 0 )
       {
          pLogger->Log( STR_GetStringAddress( VMC_FormatPinEmpty )) ;
@@ -1262,676 +2078,3694 @@
 // Method: VMR !Write all dirty frames
 
    void VMC_VirtualMemoryRoot ::
-             WriteAllPageFrames( )
+             WriteAllPageFrames( bool isSync )
    {
 
-      VMC_PageFrameElement * pPageFrameElem = lruListHead ;
+      VMC_CleanerLock rootLock ;
+
+      DrainWriteBehind( ) ;
+
+      // Collect the dirty frames in page order
+
+         int numDirty = pFrameMetadata->numDirtyFrames ;
+
+         if ( numDirty == 0 )
+         {
+            WaitCleanerWrite( ) ;
+            if ( isSync )
+            {
+               SyncAllWrittenSegments( ) ;
+            } /* if */
+            return ;
+         } /* if */
+
+         VMC_DirtyFrame * vtDirtyFrame = new VMC_DirtyFrame[ numDirty ] ;
+
+         for ( int inxDirty = 0 ; inxDirty < numDirty ; inxDirty++ )
+         {
+            int inxFrame = pFrameMetadata->vtDirtyFrame[ inxDirty ] ;
+            vtDirtyFrame[ inxDirty ].key = ComputePageKey(
+                      pFrameMetadata->vtIdSegment[ inxFrame ] ,
+                      pFrameMetadata->vtIdPage[ inxFrame ] ) ;
+            vtDirtyFrame[ inxDirty ].inxFrame = inxFrame ;
+         } /* for */
+
+         qsort( vtDirtyFrame , numDirty , sizeof( VMC_DirtyFrame ) ,
+                CompareDirtyFrames ) ;
+
+      // Write runs of adjacent pages
+
+         int inxFirst = 0 ;
+         while ( inxFirst < numDirty )
+         {
+            int inxLast = inxFirst + 1 ;
+            while ( ( inxLast < numDirty )
+                 && ( vtDirtyFrame[ inxLast ].key == vtDirtyFrame[ inxLast - 1 ].key + 1 ))
+            {
+               inxLast ++ ;
+            } /* while */
+
+            try
+            {
+               WritePageRun( vtDirtyFrame + inxFirst , inxLast - inxFirst ) ;
+            } // end try
+            catch( ... )
+            {
+               delete [ ] vtDirtyFrame ;
+               throw ;
+            } // end try catch
+
+            totalFlushRunCounter ++ ;
+
+         // Sync a segment in direct I/O mode once all its runs are written,
+         // unless all segments written are synced at the end
+
+            int idSegRun = pFrameMetadata->vtIdSegment[ vtDirtyFrame[ inxFirst ].inxFrame ] ;
+
+            if ( !isSync
+              && (( inxLast == numDirty )
+                || ( pFrameMetadata->vtIdSegment[ vtDirtyFrame[ inxLast ].inxFrame ] != idSegRun )))
+            {
+               bool isSynced ;
+               {
+                  std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+                  isSynced = !pSegmentPageRun->IsDirect( idSegRun )
+                          || pSegmentPageRun->SyncDirect( idSegRun ) ;
+               }
+
+               if ( !isSynced )
+               {
+                  delete [ ] vtDirtyFrame ;
+
+                  MSG_Message * pMsg = new MSG_Message( VMC_ErrorPageFrame ) ;
+                  pMsg->AddItem( 1 , new SEG_ItemSegmentFullName( idSegRun )) ;
+                  EXC_ERROR( pMsg , -1 , TAL_NullIdHelp ) ;
+               } /* if */
+            } /* if */
+
+            inxFirst = inxLast ;
+         } /* while */
+
+         delete [ ] vtDirtyFrame ;
 
-      while ( pPageFrameElem != NULL )
+      WaitCleanerWrite( ) ;
+
+      if ( isSync )
       {
-         pPageFrameElem->pPageFrame->WritePageFrame( ) ;
-         pPageFrameElem = pPageFrameElem->nextLruElem ;
-      } /* while */
+         SyncAllWrittenSegments( ) ;
+      } /* if */
 
    } // End of function: VMR !Write all dirty frames
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Remove all pages of a given segment
+// Method: VMR !Set eviction mode
 
    void VMC_VirtualMemoryRoot ::
-             RemoveSegment( int idSeg )
+             SetEvictionMode( VMC_tpEvictionMode mode )
    {
 
-      if ( idSeg < 0 )
+      VMC_CleanerLock rootLock ;
+
+      if ( mode == evictionMode )
       {
          return ;
       } /* if */
 
-      VMC_PageFrameElement * pPageFrameElem    = lruListHead ;
-      VMC_PageFrameElement * nextPageFrameElem = NULL ;
-
-      while ( pPageFrameElem != NULL )
+      if ( mode == VMC_EVICT_CLEAN_FIRST )
       {
-         nextPageFrameElem = pPageFrameElem->nextLruElem ;
-         if ( pPageFrameElem->pPageFrame->GetIdSeg( ) == idSeg )
+         int numSlots = numPageFrames / 4 ;
+         if ( numSlots < WRITE_BEHIND_MIN_SLOTS )
          {
-            RemovePageValue( pPageFrameElem ) ;
-            MoveElemLruTail( pPageFrameElem ) ;
+            numSlots = WRITE_BEHIND_MIN_SLOTS ;
          } /* if */
-         pPageFrameElem = nextPageFrameElem ;
-      } /* while */
 
-   } // End of function: VMR !Remove all pages of a given segment
+         pWriteBehindQueue = new VMC_WriteBehindQueue( numSlots , pageSize ) ;
+         evictionMode      = mode ;
+         return ;
+      } /* if */
 
-////////////////////////////////////////////////////////////////////////////
+      DrainWriteBehind( ) ;
+
+      delete pWriteBehindQueue ;
+      pWriteBehindQueue = NULL ;
+      evictionMode      = mode ;
+
+   } // End of function: VMR !Set eviction mode
+
+////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Add new page value to end of segment file
+// Method: VMR !Get eviction mode
 
-   VMC_PageFrame * VMC_VirtualMemoryRoot ::
-             AddNewPage( int idSeg )
+   VMC_tpEvictionMode VMC_VirtualMemoryRoot ::
+             GetEvictionMode( )
    {
 
-      SEG_SegmentRoot * pRoot = SEG_SegmentRoot::GetRoot( ) ;
-      int idPag = pRoot->GetSegmentNumPages( idSeg ) ;
+      return evictionMode ;
 
-      VMC_PageFrameElement * pPageFrameElem = GetEmptyFrame( idSeg , idPag ) ;
-      pRoot->AddPage( idSeg , pPageFrameElem->pPageFrame->GetPageValue( )) ;
+   } // End of function: VMR !Get eviction mode
 
-      return pPageFrameElem->pPageFrame ;
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Set direct page maps
 
-   } // End of function: VMR !Add new page value to end of segment file
+   void VMC_VirtualMemoryRoot ::
+             SetDirectPageMaps( bool isOn )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      isDirectMapOn = isOn ;
+
+      if ( !isOn )
+      {
+         for ( int idSeg = 0 ; idSeg < dimSegmentMap ; idSeg++ )
+         {
+            ReleaseSegmentMap( idSeg ) ;
+         } /* for */
+      } /* if */
+
+   } // End of function: VMR !Set direct page maps
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get LRU list head
+// Method: VMR !Set read ahead
 
-   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
-             GetLruListHead( )
+   void VMC_VirtualMemoryRoot ::
+             SetReadAhead( int maxPages )
    {
 
-      return lruListHead ;
+      VMC_CleanerLock rootLock ;
 
-   } // End of function: VMR !Get LRU list head
+      if ( maxPages < 0 )
+      {
+         maxPages = 0 ;
+      } /* if */
+      if ( maxPages > READ_AHEAD_MAX_PAGES )
+      {
+         maxPages = READ_AHEAD_MAX_PAGES ;
+      } /* if */
+
+      maxReadAhead = maxPages ;
+
+   } // End of function: VMR !Set read ahead
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get next LRU list element
+// Method: VMR !Set compressed tier
+//    The pages of a former tier are dropped with it.
 
-   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
-             GetNextLruListElement( VMC_PageFrameElement * currentElem )
+   void VMC_VirtualMemoryRoot ::
+             SetCompressedTier( int sizeKiB )
    {
 
+      VMC_CleanerLock rootLock ;
 
-      return currentElem->nextLruElem ;
+      if ( sizeKiB < 0 )
+      {
+         sizeKiB = 0 ;
+      } /* if */
+      if ( sizeKiB > TIER_MAX_KIB )
+      {
+         sizeKiB = TIER_MAX_KIB ;
+      } /* if */
+
+      delete pCompressedTier ;
+      pCompressedTier = NULL ;
+
+      if ( sizeKiB > 0 )
+      {
+         pCompressedTier = new VMC_CompressedTier( sizeKiB * 1024 , pageSize ) ;
+      } /* if */
 
-   } // End of function: VMR !Get next LRU list element
+   } // End of function: VMR !Set compressed tier
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get page frame
+// Method: VMR !Get compressed tier counters
 
-   VMC_PageFrame * VMC_VirtualMemoryRoot ::
-             GetPageFrame( int idSeg ,
-                           int idPag ,
-                           bool inMemory )
+   void VMC_VirtualMemoryRoot ::
+             GetCompressedTierCounters( int * pNumHits    ,
+                                        int * pNumMisses  ,
+                                        int * pNumStored  ,
+                                        int * pNumDropped  )
    {
 
+      VMC_CleanerLock rootLock ;
 
-      // Access frame already in memory
+      if ( pCompressedTier == NULL )
+      {
+         *pNumHits    = 0 ;
+         *pNumMisses  = 0 ;
+         *pNumStored  = 0 ;
+         *pNumDropped = 0 ;
+         return ;
+      } /* if */
 
-         VMC_PageFrameElement * pPageFrameElem = SearchRealPage( idSeg , idPag ) ;
+      int arenaSize ;
+      int numPages ;
+      double ratio ;
+      pCompressedTier->GetCounters( &arenaSize , &numPages , pNumHits ,
+                pNumMisses , pNumStored , pNumDropped , &ratio ) ;
 
-         if ( pPageFrameElem != NULL )
-         {
-            totalAccessCounter ++ ;
-            totalHitCounter ++ ;
-            if ( !inMemory )
+   } // End of function: VMR !Get compressed tier counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Release frames
+
+   int VMC_VirtualMemoryRoot ::
+             ReleaseFrames( int numFrames )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      int numReleased = 0 ;
+
+      while ( ( numReleased < numFrames )
+           && ( numPageFrames - numReleasedFrames > minPageFrames ))
+      {
+
+         // Empty a clean frame if no frame is empty
+
+            if ( pFreeListHead == NULL )
             {
-               MoveElemLruHead( pPageFrameElem ) ;
+               VMC_PageFrame * pPageFrame = ChooseReleasableVictim( ) ;
+               if ( pPageFrame == NULL )
+               {
+                  break ;
+               } /* if */
+
+               RemovePageValue( GetFrameElement( pPageFrame )) ;
             } /* if */
 
-            return pPageFrameElem->pPageFrame ;
-         } /* if */
+         // Release an empty frame
 
-      // Replace empty frame
+            VMC_PageFrameElement * pPageFrameElem = GetFreeFrameElement( ) ;
 
-         pPageFrameElem = lruListTail ;
-         if ( pPageFrameElem->frameType == FRAME_TYPE_FREE )
-         {
-            ReplacePage( pPageFrameElem , idSeg , idPag , false ) ;
-            totalAccessCounter ++ ;
+            pPageFrameElem->frameType = FRAME_TYPE_RELEASED ;
+            pFrameArena->ReleaseBuffer( pPageFrameElem->inxFrameElement ) ;
 
-            return pPageFrameElem->pPageFrame ;
-         } /* if */
+            pPageFrameElem->nextFreeElem = pReleasedListHead ;
+            pReleasedListHead = pPageFrameElem ;
+            numReleasedFrames ++ ;
 
-      // Replace unpinned frame
+            numReleased ++ ;
 
-         if ( inMemory )
-         {
-            return NULL ;
-         } /* if */
+      } // end repetition: Release frames
 
-         pPageFrameElem = FindReplaceableFrame( ) ;
-         ReplacePage( pPageFrameElem , idSeg , idPag , false ) ;
-         totalAccessCounter ++ ;
+      totalReleaseCounter += numReleased ;
 
-         return pPageFrameElem->pPageFrame ;
+      return numReleased ;
 
-   } // End of function: VMR !Get page frame
+   } // End of function: VMR !Release frames
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get number page frames
+// Method: VMR !Start tail cleaner
 
-   int VMC_VirtualMemoryRoot ::
-             GetNumPageFrames( )
+   void VMC_VirtualMemoryRoot ::
+             StartTailCleaner( int numScanFrames ,
+                               int lowWatermark  ,
+                               int highWatermark  )
    {
 
-      return numPageFrames ;
+      StopTailCleaner( ) ;
 
-   } // End of function: VMR !Get number page frames
+      if ( numScanFrames > CLEANER_MAX_SCAN )
+      {
+         numScanFrames = CLEANER_MAX_SCAN ;
+      } /* if */
+      if ( highWatermark > numScanFrames )
+      {
+         highWatermark = numScanFrames ;
+      } /* if */
+      if ( lowWatermark > highWatermark )
+      {
+         lowWatermark = highWatermark ;
+      } /* if */
+
+      if ( lowWatermark <= 0 )
+      {
+         return ;
+      } /* if */
+
+      if ( pDirtyFlusher == NULL )
+      {
+         isCleanerRunning = true ;
+      } /* if */
+      pTailCleaner = new VMC_TailCleaner( numScanFrames , lowWatermark ,
+                                          highWatermark ) ;
+
+   } // End of function: VMR !Start tail cleaner
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get total frame accesses
+// Method: VMR !Stop tail cleaner
 
-   int VMC_VirtualMemoryRoot :: GetTotalAccesses( )
+   void VMC_VirtualMemoryRoot ::
+             StopTailCleaner( )
    {
 
-      return totalAccessCounter ;
+      if ( pTailCleaner != NULL )
+      {
+         delete pTailCleaner ;
+         pTailCleaner = NULL ;
+         if ( pDirtyFlusher == NULL )
+         {
+            isCleanerRunning = false ;
+         } /* if */
+      } /* if */
 
-   } // End of function: VMR !Get total frame accesses
+   } // End of function: VMR !Stop tail cleaner
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get total frame replaces
+// Method: VMR !Clean tail frames
+//    The candidates are listed once. After a write the module lock has
+//    been released, hence the remaining candidates may have been moved or
+//    even received another page. They still are frames of the root, and
+//    are written only if they are dirty and not pinned.
+//    Pages waiting in the write behind queue are skipped, writing them
+//    now could be undone by the older copy in the queue.
 
    int VMC_VirtualMemoryRoot ::
-             GetTotalReplaces( )
+             CleanTailFrames( int numScanFrames ,
+                              int lowWatermark  ,
+                              int highWatermark ,
+                              int * pNumFailures )
    {
 
-      return totalReplaceCounter ;
+      std::unique_lock< std::recursive_mutex > rootLock( cleanerMutex ) ;
 
-   } // End of function: VMR !Get total frame replaces
+      VMC_PageFrame * vtCandidate[ CLEANER_MAX_SCAN ] ;
+
+      if ( numScanFrames > CLEANER_MAX_SCAN )
+      {
+         numScanFrames = CLEANER_MAX_SCAN ;
+      } /* if */
+
+      int numCandidates = pReplacementPolicy->GetVictimCandidates(
+                vtCandidate , numScanFrames ) ;
+
+      int numClean = 0 ;
+      for ( int inxCandidate = 0 ; inxCandidate < numCandidates ; inxCandidate++ )
+      {
+         if ( vtCandidate[ inxCandidate ]->GetDirtyFlag( ) >= TAL_NOT_CHANGED )
+         {
+            numClean ++ ;
+         } /* if */
+      } /* for */
+
+      if ( ( numCandidates == 0 )
+        || ( numClean >= lowWatermark ))
+      {
+         return 0 ;
+      } /* if */
+
+      int numWritten = 0 ;
+
+      for ( int inxCandidate = 0 ;
+            ( inxCandidate < numCandidates ) && ( numClean < highWatermark ) ;
+            inxCandidate++ )
+      {
+         VMC_PageFrame * pPageFrame = vtCandidate[ inxCandidate ] ;
+
+         int idSeg = pPageFrame->GetIdSeg( ) ;
+         int idPag = pPageFrame->GetIdPag( ) ;
+
+         if ( ( idSeg < 0 )
+           || ( pPageFrame->GetNumPins( ) > 0 )
+           || ( pPageFrame->GetDirtyFlag( ) >= TAL_NOT_CHANGED ))
+         {
+            continue ;
+         } /* if */
+
+         if ( ( pWriteBehindQueue != NULL )
+           && ( pWriteBehindQueue->IsPagePending( idSeg , idPag )))
+         {
+            continue ;
+         } /* if */
+
+         pPageFrame->PinFrame( ) ;
+         rootLock.unlock( ) ;
+
+         try
+         {
+            pPageFrame->WritePageFrame( ) ;
+            numWritten ++ ;
+            numClean ++ ;
+         }
+         catch ( EXC_Exception * pExc )
+         {
+            delete pExc ;
+            ( *pNumFailures ) ++ ;
+         } /* end catch */
+
+         rootLock.lock( ) ;
+
+         if ( ( pPageFrame->GetIdSeg( ) == idSeg )
+           && ( pPageFrame->GetIdPag( ) == idPag ))
+         {
+            pPageFrame->UnpinFrame( ) ;
+         } /* if */
+      } /* for */
+
+      return numWritten ;
+
+   } // End of function: VMR !Clean tail frames
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get total hit count
+// Method: VMR !Get tail cleaner counters
 
-   int VMC_VirtualMemoryRoot ::
-             GetTotalHits( )
+   void VMC_VirtualMemoryRoot ::
+             GetCleanerCounters( int * pNumScans     ,
+                                 int * pNumCleanings ,
+                                 int * pNumWrites    ,
+                                 int * pNumFailures   )
    {
 
-      return totalHitCounter ;
+      if ( pTailCleaner == NULL )
+      {
+         *pNumScans     = 0 ;
+         *pNumCleanings = 0 ;
+         *pNumWrites    = 0 ;
+         *pNumFailures  = 0 ;
+         return ;
+      } /* if */
 
-   } // End of function: VMR !Get total hit count
+      pTailCleaner->GetCounters( pNumScans , pNumCleanings ,
+                                 pNumWrites , pNumFailures ) ;
+
+   } // End of function: VMR !Get tail cleaner counters
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get number of pinned frames
+// Method: VMR !Start dirty flusher
 
-   int VMC_VirtualMemoryRoot ::
-            GetNumPinnedFrames( )
+   void VMC_VirtualMemoryRoot ::
+             StartDirtyFlusher( int highWatermark ,
+                                int lowWatermark  ,
+                                int maxPagesPerSecond )
    {
 
-      int countPinned = 0 ;
-      VMC_PageFrameElement * pPageFrameElem = lruListHead ;
+      StopDirtyFlusher( ) ;
+
+      if ( highWatermark > 100 )
+      {
+         highWatermark = 100 ;
+      } /* if */
+      if ( lowWatermark > highWatermark )
+      {
+         lowWatermark = highWatermark ;
+      } /* if */
+      if ( lowWatermark < 0 )
+      {
+         lowWatermark = 0 ;
+      } /* if */
+      if ( maxPagesPerSecond < 0 )
+      {
+         maxPagesPerSecond = 0 ;
+      } /* if */
+
+      if ( highWatermark <= 0 )
+      {
+         return ;
+      } /* if */
+
+      if ( pTailCleaner == NULL )
+      {
+         isCleanerRunning = true ;
+      } /* if */
+      pDirtyFlusher = new VMC_DirtyFlusher( highWatermark , lowWatermark ,
+                                            maxPagesPerSecond ) ;
+
+   } // End of function: VMR !Start dirty flusher
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Stop dirty flusher
+
+   void VMC_VirtualMemoryRoot ::
+             StopDirtyFlusher( )
+   {
 
-      while ( pPageFrameElem != NULL )
+      if ( pDirtyFlusher != NULL )
       {
-         if ( pPageFrameElem->pPageFrame->GetNumPins( ) != 0 )
+         delete pDirtyFlusher ;
+         pDirtyFlusher = NULL ;
+         if ( pTailCleaner == NULL )
          {
-            countPinned ++ ;
+            isCleanerRunning = false ;
          } /* if */
-         pPageFrameElem = pPageFrameElem->nextLruElem ;
-      } /* while */
-
-      return countPinned ;
+      } /* if */
 
-   } // End of function: VMR !Get number of pinned frames
+   } // End of function: VMR !Stop dirty flusher
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR !Get page frame of current element
+// Method: VMR !Flush dirty frames
+//    The oldest dirty frames are chosen once, then written in page order.
+//    After a write the module lock has been released, hence the remaining
+//    frames may have been cleaned or even received another page. They are
+//    written only if they are still frames of the pool, dirty and not
+//    pinned. Pages waiting in the write behind queue are skipped, see
+//    CleanTailFrames.
 
-   VMC_PageFrame * VMC_VirtualMemoryRoot ::
-             GetPageFrame( VMC_PageFrameElement * currentElem )
+   int VMC_VirtualMemoryRoot ::
+             FlushDirtyFrames( int highWatermark ,
+                               int lowWatermark  ,
+                               int maxPages      ,
+                               bool * pIsFlushing ,
+                               int * pNumFailures )
    {
 
+      std::unique_lock< std::recursive_mutex > rootLock( cleanerMutex ) ;
 
-      return currentElem->pPageFrame ;
+      int numHighFrames = ( numPageFrames * highWatermark ) / 100 ;
+      int numLowFrames  = ( numPageFrames * lowWatermark  ) / 100 ;
 
-   } // End of function: VMR !Get page frame of current element
+      if ( pFrameMetadata->numDirtyFrames > numHighFrames )
+      {
+         *pIsFlushing = true ;
+      } /* if */
+
+      if ( !( *pIsFlushing ))
+      {
+         return 0 ;
+      } /* if */
+
+      int numChosen = pFrameMetadata->numDirtyFrames - numLowFrames ;
+      if ( numChosen > maxPages )
+      {
+         numChosen = maxPages ;
+      } /* if */
+
+      if ( numChosen <= 0 )
+      {
+         *pIsFlushing = pFrameMetadata->numDirtyFrames > numLowFrames ;
+         return 0 ;
+      } /* if */
+
+      // Choose the oldest dirty frames
+
+         int numDirty = pFrameMetadata->numDirtyFrames ;
+         VMC_DirtyFrame * vtDirtyFrame = new VMC_DirtyFrame[ numDirty ] ;
+
+         for ( int inxDirty = 0 ; inxDirty < numDirty ; inxDirty++ )
+         {
+            int inxFrame = pFrameMetadata->vtDirtyFrame[ inxDirty ] ;
+            vtDirtyFrame[ inxDirty ].key      = pFrameMetadata->vtDirtySince[ inxFrame ] ;
+            vtDirtyFrame[ inxDirty ].inxFrame = inxFrame ;
+         } /* for */
+
+         qsort( vtDirtyFrame , numDirty , sizeof( VMC_DirtyFrame ) ,
+                CompareDirtyFrames ) ;
+
+         for ( int inxDirty = 0 ; inxDirty < numChosen ; inxDirty++ )
+         {
+            int inxFrame = vtDirtyFrame[ inxDirty ].inxFrame ;
+            vtDirtyFrame[ inxDirty ].key = ComputePageKey(
+                      pFrameMetadata->vtIdSegment[ inxFrame ] ,
+                      pFrameMetadata->vtIdPage[ inxFrame ] ) ;
+         } /* for */
+
+         qsort( vtDirtyFrame , numChosen , sizeof( VMC_DirtyFrame ) ,
+                CompareDirtyFrames ) ;
+
+      // Write the chosen frames
+
+         int numWritten = 0 ;
+
+         for ( int inxDirty = 0 ;
+               ( inxDirty < numChosen )
+            && ( pFrameMetadata->numDirtyFrames > numLowFrames ) ;
+               inxDirty++ )
+         {
+            int inxFrame = vtDirtyFrame[ inxDirty ].inxFrame ;
+
+            if ( ( inxFrame >= numPageFrames )
+              || ( pFrameMetadata->vtChangeLevel[ inxFrame ] >= TAL_NOT_CHANGED )
+              || ( pFrameMetadata->vtNumPins[ inxFrame ] > 0 ))
+            {
+               continue ;
+            } /* if */
+
+            VMC_PageFrame * pPageFrame = vtPageFrameElem[ inxFrame ]->pPageFrame ;
+
+            int idSeg = pPageFrame->GetIdSeg( ) ;
+            int idPag = pPageFrame->GetIdPag( ) ;
+
+            if ( ( pWriteBehindQueue != NULL )
+              && ( pWriteBehindQueue->IsPagePending( idSeg , idPag )))
+            {
+               continue ;
+            } /* if */
+
+            pPageFrame->PinFrame( ) ;
+            rootLock.unlock( ) ;
+
+            try
+            {
+               pPageFrame->WritePageFrame( ) ;
+               numWritten ++ ;
+            }
+            catch ( EXC_Exception * pExc )
+            {
+               delete pExc ;
+               ( *pNumFailures ) ++ ;
+            } /* end catch */
+
+            rootLock.lock( ) ;
+
+            if ( ( pPageFrame->GetIdSeg( ) == idSeg )
+              && ( pPageFrame->GetIdPag( ) == idPag ))
+            {
+               pPageFrame->UnpinFrame( ) ;
+            } /* if */
+         } /* for */
+
+         delete [ ] vtDirtyFrame ;
+
+      *pIsFlushing = pFrameMetadata->numDirtyFrames > numLowFrames ;
+
+      return numWritten ;
+
+   } // End of function: VMR !Flush dirty frames
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get dirty flusher counters
+
+   void VMC_VirtualMemoryRoot ::
+             GetFlusherCounters( int * pNumPasses   ,
+                                 int * pNumFlushes  ,
+                                 int * pNumWrites   ,
+                                 int * pNumFailures  )
+   {
+
+      if ( pDirtyFlusher == NULL )
+      {
+         *pNumPasses   = 0 ;
+         *pNumFlushes  = 0 ;
+         *pNumWrites   = 0 ;
+         *pNumFailures = 0 ;
+         return ;
+      } /* if */
+
+      pDirtyFlusher->GetCounters( pNumPasses , pNumFlushes ,
+                                  pNumWrites , pNumFailures ) ;
+
+   } // End of function: VMR !Get dirty flusher counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get number of dirty frames
+
+   int VMC_VirtualMemoryRoot ::
+             GetNumDirtyFrames( )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      return pFrameMetadata->numDirtyFrames ;
+
+   } // End of function: VMR !Get number of dirty frames
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Remove all pages of a given segment
+
+   void VMC_VirtualMemoryRoot ::
+             RemoveSegment( int idSeg )
+   {
+
+      if ( idSeg < 0 )
+      {
+         return ;
+      } /* if */
+
+      VMC_CleanerLock rootLock ;
+
+      DrainWriteBehind( ) ;
+      WaitCleanerWrite( ) ;
+
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
+
+      if ( pMap->vtInxFrame != NULL )
+      {
+         for ( int idPag = 0 ; ( idPag < pMap->dimMap ) && ( pMap->numResident > 0 ) ;
+               idPag++ )
+         {
+            if ( pMap->vtInxFrame[ idPag ] >= 0 )
+            {
+               RemovePageValue( vtPageFrameElem[ pMap->vtInxFrame[ idPag ]] ) ;
+            } /* if */
+         } /* for */
+
+         delete [ ] pMap->vtInxFrame ;
+         pMap->vtInxFrame = NULL ;
+         pMap->dimMap     = 0 ;
+      } else
+      {
+         const int * vtIdSegment = pFrameMetadata->vtIdSegment ;
+
+         for ( int inxFrame = 0 ; ( inxFrame < numPageFrames ) && ( pMap->numResident > 0 ) ;
+               inxFrame++ )
+         {
+            if ( vtIdSegment[ inxFrame ] == idSeg )
+            {
+               RemovePageValue( vtPageFrameElem[ inxFrame ] ) ;
+            } /* if */
+         } /* for */
+      } /* if */
+
+      UnmapSegment( pMap ) ;
+      ResetReadAhead( pMap ) ;
+      pReplacementPolicy->ForgetSegment( idSeg ) ;
+
+      if ( pCompressedTier != NULL )
+      {
+         pCompressedTier->DropSegment( idSeg ) ;
+      } /* if */
+
+      if ( pRedoLog != NULL )
+      {
+         pRedoLog->ForgetSegment( idSeg ) ;
+      } /* if */
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+      pSegmentPageRun->CloseDirect( idSeg ) ;
+      pSegmentPageRun->ForgetChecksums( idSeg ) ;
+      pSegmentPageRun->ForgetWritten( idSeg ) ;
+
+   } // End of function: VMR !Remove all pages of a given segment
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Map segment file
+//    The file is mapped private and writable, a change to a page value
+//    gives the process its own copy of that page, which is dropped when
+//    the page leaves its frame. Hence the file only changes when dirty
+//    pages are written through the segment module.
+//    A file the segment module does not lay out plain is not mapped.
+
+   bool VMC_VirtualMemoryRoot ::
+             MapSegment( int idSeg )
+   {
+
+      if ( idSeg < 0 )
+      {
+         return false ;
+      } /* if */
+
+      VMC_CleanerLock rootLock ;
+
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
+      if ( pMap->pMapping != NULL )
+      {
+         return true ;
+      } /* if */
+
+      std::unique_lock< std::mutex > ioLock( segmentIoMutex ) ;
+
+      if ( pSegmentPageRun->IsDirect( idSeg )
+        || !pSegmentPageRun->IsPlainLayout( idSeg ))
+      {
+         return false ;
+      } /* if */
+
+      int numMappedPages = SEG_SegmentRoot::GetRoot( )->GetSegmentNumPages( idSeg ) /
+                ( pageSize / TAL_PageSize ) ;
+      if ( numMappedPages <= 0 )
+      {
+         return false ;
+      } /* if */
+
+      size_t mappingSize = static_cast< size_t >( numMappedPages ) * pageSize ;
+
+      // Open the segment file
+
+         int fileDescriptor = pSegmentPageRun->OpenSegmentFile( idSeg , O_RDONLY ) ;
+         ioLock.unlock( ) ;
+         if ( fileDescriptor < 0 )
+         {
+            return false ;
+         } /* if */
+
+      // Map the file
+
+         struct stat fileStatus ;
+         void * pMapping = MAP_FAILED ;
+
+         if ( ( fstat( fileDescriptor , &fileStatus ) == 0 )
+           && ( static_cast< size_t >( fileStatus.st_size ) >= mappingSize ))
+         {
+            pMapping = mmap( NULL , mappingSize , PROT_READ | PROT_WRITE ,
+                             MAP_PRIVATE , fileDescriptor , 0 ) ;
+         } /* if */
+
+         close( fileDescriptor ) ;
+
+         if ( pMapping == MAP_FAILED )
+         {
+            return false ;
+         } /* if */
+
+      pMap->pMapping       = static_cast< char * >( pMapping ) ;
+      pMap->mappingSize    = mappingSize ;
+      pMap->numMappedPages = numMappedPages ;
+
+      return true ;
+
+   } // End of function: VMR !Map segment file
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Set direct I/O
+//    Pages written before the mode changes are written by then, the write
+//    behind queue is drained, hence no transfer is in flight.
+
+   bool VMC_VirtualMemoryRoot ::
+             SetDirectIo( int idSeg , bool isOn )
+   {
+
+      if ( idSeg < 0 )
+      {
+         return false ;
+      } /* if */
+
+      VMC_CleanerLock rootLock ;
+
+      DrainWriteBehind( ) ;
+
+      if ( isOn
+        && ( GetSegmentMap( idSeg )->pMapping != NULL ))
+      {
+         return false ;
+      } /* if */
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+
+      if ( !isOn )
+      {
+         pSegmentPageRun->CloseDirect( idSeg ) ;
+         return false ;
+      } /* if */
+
+      return pSegmentPageRun->OpenDirect( idSeg ) ;
+
+   } // End of function: VMR !Set direct I/O
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Set checksum mode
+//    The write behind queue is drained, hence no page is written with
+//    one mode and recorded with the other.
+
+   void VMC_VirtualMemoryRoot ::
+             SetChecksumMode( VMC_tpChecksumMode mode )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      DrainWriteBehind( ) ;
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+      pSegmentPageRun->SetChecksumMode( mode ) ;
+
+   } // End of function: VMR !Set checksum mode
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Open redo log
+//    Dirty frames are written first, the log then covers every change
+//    not yet in the segments.
+
+   int VMC_VirtualMemoryRoot ::
+             OpenLog( const char * logFileName ,
+                      int checkpointKiB          )
+   {
+
+      CloseLog( ) ;
+
+      VMC_CleanerLock rootLock ;
+
+      if ( checkpointKiB <= 0 )
+      {
+         checkpointKiB = LOG_CHECKPOINT_DEFAULT_KIB ;
+      } else if ( checkpointKiB < LOG_CHECKPOINT_MIN_KIB )
+      {
+         checkpointKiB = LOG_CHECKPOINT_MIN_KIB ;
+      } else if ( checkpointKiB > LOG_CHECKPOINT_MAX_KIB )
+      {
+         checkpointKiB = LOG_CHECKPOINT_MAX_KIB ;
+      } /* if */
+
+      int logFile = open( logFileName , O_RDWR | O_CREAT | O_APPEND , 0644 ) ;
+      if ( logFile < 0 )
+      {
+         return -1 ;
+      } /* if */
+
+      // Read the records left by the previous session
+
+         struct stat logStat ;
+         long long sizeLog = 0 ;
+         if ( fstat( logFile , &logStat ) == 0 )
+         {
+            sizeLog = logStat.st_size ;
+         } /* if */
+
+         char * pLog = new char[ sizeLog > 0 ? sizeLog : 1 ] ;
+         long long sizeRead = 0 ;
+         while ( sizeRead < sizeLog )
+         {
+            ssize_t numRead = pread( logFile , pLog + sizeRead ,
+                      sizeLog - sizeRead , sizeRead ) ;
+            if ( numRead <= 0 )
+            {
+               break ;
+            } /* if */
+            sizeRead += numRead ;
+         } /* while */
+
+      // Redo them and write all dirty pages
+
+         int numRedone = -1 ;
+         try
+         {
+            numRedone = ReplayLog( pLog , sizeRead ) ;
+            if ( numRedone >= 0 )
+            {
+               WriteAllPageFrames( ) ;
+            } /* if */
+         } // end try
+         catch( ... )
+         {
+            delete [ ] pLog ;
+            close( logFile ) ;
+            throw ;
+         } // end try catch
+
+         delete [ ] pLog ;
+
+         bool isSynced = false ;
+         if ( numRedone >= 0 )
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            isSynced = pSegmentPageRun->SyncWrittenSegments( ) ;
+         } /* if */
+
+         if ( !isSynced )
+         {
+            close( logFile ) ;
+            return -1 ;
+         } /* if */
+
+      // Start logging with an empty log
+
+         if ( ( ftruncate( logFile , 0 ) != 0 )
+           || ( fdatasync( logFile ) != 0 ))
+         {
+            close( logFile ) ;
+            return -1 ;
+         } /* if */
+
+         pRedoLog = new VMC_RedoLog( logFile , checkpointKiB * 1024LL , pageSize ) ;
+
+      return numRedone ;
+
+   } // End of function: VMR !Open redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Commit redo log
+
+   bool VMC_VirtualMemoryRoot ::
+             CommitLog( bool isWait )
+   {
+
+      if ( pRedoLog == NULL )
+      {
+         return true ;
+      } /* if */
+
+      bool isDurable = pRedoLog->Commit( isWait ) ;
+
+      if ( pRedoLog->IsCheckpointDue( ))
+      {
+         return CheckpointLog( ) && isDurable ;
+      } /* if */
+
+      return isDurable ;
+
+   } // End of function: VMR !Commit redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Checkpoint redo log
+
+   bool VMC_VirtualMemoryRoot ::
+             CheckpointLog( )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      if ( pRedoLog == NULL )
+      {
+         return true ;
+      } /* if */
+
+      pRedoLog->SetCheckpointing( true ) ;
+
+      bool isSynced = false ;
+      try
+      {
+         WriteAllPageFrames( ) ;
+
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+         isSynced = pSegmentPageRun->SyncWrittenSegments( ) ;
+      } // end try
+      catch( ... )
+      {
+         pRedoLog->SetCheckpointing( false ) ;
+         throw ;
+      } // end try catch
+
+      bool isTruncated = isSynced && pRedoLog->Truncate( ) ;
+
+      pRedoLog->SetCheckpointing( false ) ;
+
+      return isTruncated ;
+
+   } // End of function: VMR !Checkpoint redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Close redo log
+//    If the checkpoint throws the log stays open, its records still
+//    redo the changes not written.
+//    The sequence numbers of the frames restart with the next log.
+
+   void VMC_VirtualMemoryRoot ::
+             CloseLog( )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      if ( pRedoLog == NULL )
+      {
+         return ;
+      } /* if */
+
+      CheckpointLog( ) ;
+
+      delete pRedoLog ;
+      pRedoLog = NULL ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+      {
+         pFrameMetadata->vtPageLsn[ inxFrame ] = 0 ;
+      } /* for */
+
+   } // End of function: VMR !Close redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get redo log counters
+
+   void VMC_VirtualMemoryRoot ::
+             GetLogCounters( int * pNumRecords     ,
+                             int * pNumCommits     ,
+                             int * pNumSyncs       ,
+                             int * pNumCheckpoints  )
+   {
+
+      *pNumRecords     = 0 ;
+      *pNumCommits     = 0 ;
+      *pNumSyncs       = 0 ;
+      *pNumCheckpoints = 0 ;
+
+      if ( pRedoLog != NULL )
+      {
+         long long numBytes ;
+         pRedoLog->GetCounters( pNumRecords , pNumCommits , pNumSyncs ,
+                                pNumCheckpoints , &numBytes ) ;
+      } /* if */
+
+   } // End of function: VMR !Get redo log counters
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Add new page value to end of segment file
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             AddNewPage( int idSeg )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      int idPag ;
+      {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+         idPag = pSegmentPageRun->GetNumPages( idSeg ) ;
+      }
+
+      VMC_PageFrameElement * pPageFrameElem = GetEmptyFrame( idSeg , idPag ) ;
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+      pSegmentPageRun->WriteRun( idSeg , idPag ,
+                pPageFrameElem->pPageFrame->GetPageValue( )) ;
+
+      return pPageFrameElem->pPageFrame ;
+
+   } // End of function: VMR !Add new page value to end of segment file
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get first page frame element
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             GetFirstFrameElement( )
+   {
+
+      return vtPageFrameElem[ 0 ] ;
+
+   } // End of function: VMR !Get first page frame element
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get next page frame element
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             GetNextFrameElement( VMC_PageFrameElement * currentElem )
+   {
+
+
+      if ( currentElem->inxFrameElement + 1 < numPageFrames )
+      {
+         return vtPageFrameElem[ currentElem->inxFrameElement + 1 ] ;
+      } /* if */
+
+      return NULL ;
+
+   } // End of function: VMR !Get next page frame element
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get page frame
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             GetPageFrame( int idSeg ,
+                           int idPag ,
+                           bool inMemory )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      // Access frame already in memory
+
+         VMC_PageFrameElement * pPageFrameElem = SearchRealPage( idSeg , idPag ) ;
+
+         if ( pPageFrameElem != NULL )
+         {
+            if ( pPageFrameElem->frameType == FRAME_TYPE_READING )
+            {
+               FinishPageIn( pPageFrameElem ) ;
+            } /* if */
+
+            totalAccessCounter ++ ;
+            totalHitCounter ++ ;
+            if ( !inMemory )
+            {
+               pReplacementPolicy->OnAccess( pPageFrameElem->pPageFrame ) ;
+
+               if ( pPageFrameElem->isPrefetched )
+               {
+                  pPageFrameElem->isPrefetched = false ;
+                  totalPrefetchHitCounter ++ ;
+
+                  VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
+                  if ( pMap->numReadAhead < READ_AHEAD_MAX_PAGES )
+                  {
+                     pMap->numReadAhead ++ ;
+                  } /* if */
+               } /* if */
+
+               if ( maxReadAhead > 0 )
+               {
+                  ReadAhead( idSeg , idPag , pPageFrameElem->pPageFrame ) ;
+               } /* if */
+            } /* if */
+
+            return pPageFrameElem->pPageFrame ;
+         } /* if */
+
+      // Replace empty frame
+
+         pPageFrameElem = GetFreeFrameElement( ) ;
+         if ( pPageFrameElem != NULL )
+         {
+            ReplacePage( pPageFrameElem , idSeg , idPag , false , false ) ;
+            totalAccessCounter ++ ;
+
+            if ( ( maxReadAhead > 0 )
+              && !inMemory )
+            {
+               ReadAhead( idSeg , idPag , pPageFrameElem->pPageFrame ) ;
+            } /* if */
+
+            return pPageFrameElem->pPageFrame ;
+         } /* if */
+
+      // Replace unpinned frame
+
+         if ( inMemory )
+         {
+            return NULL ;
+         } /* if */
+
+         pPageFrameElem = FindReplaceableFrame( IsRecentlyEvicted( idSeg , idPag )) ;
+         ReplacePage( pPageFrameElem , idSeg , idPag , false , false ) ;
+         totalAccessCounter ++ ;
+
+         if ( maxReadAhead > 0 )
+         {
+            ReadAhead( idSeg , idPag , pPageFrameElem->pPageFrame ) ;
+         } /* if */
+
+         return pPageFrameElem->pPageFrame ;
+
+   } // End of function: VMR !Get page frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get page frame asynchronously
+
+   void VMC_VirtualMemoryRoot ::
+             GetPageFrameAsync( int idSeg ,
+                                int idPag  )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      if ( pPageInQueue == NULL )
+      {
+         GetPageFrame( idSeg , idPag ) ;
+         return ;
+      } /* if */
+
+      if ( SearchRealPage( idSeg , idPag ) != NULL )
+      {
+         return ;
+      } /* if */
+
+      // Reserve a frame
+
+         VMC_PageFrameElement * pPageFrameElem = GetFreeFrameElement( ) ;
+         if ( pPageFrameElem == NULL )
+         {
+            pPageFrameElem = FindReplaceableFrame( IsRecentlyEvicted( idSeg , idPag )) ;
+         } /* if */
+
+         totalAccessCounter ++ ;
+
+         if ( ( ( pWriteBehindQueue != NULL )
+             && pWriteBehindQueue->IsPagePending( idSeg , idPag ))
+           || ( GetMappedValue( idSeg , idPag ) != NULL )
+           || ( ( pCompressedTier != NULL )
+             && pCompressedTier->ContainsPage( ComputePageKey( idSeg , idPag ) , true )))
+         {
+            ReplacePage( pPageFrameElem , idSeg , idPag , false , false ) ;
+            return ;
+         } /* if */
+
+      // Register the page and queue its read
+
+         SchedulePageIn( pPageFrameElem , idSeg , idPag , false ) ;
+
+   } // End of function: VMR !Get page frame asynchronously
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Wait for page frame
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             WaitPageFrame( int idSeg ,
+                            int idPag  )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      VMC_PageFrame * pPageFrame = GetPageFrame( idSeg , idPag ) ;
+      pPageFrame->PinFrame( ) ;
+
+      return pPageFrame ;
+
+   } // End of function: VMR !Wait for page frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Start page in threads
+
+   void VMC_VirtualMemoryRoot ::
+             StartPageInThreads( int numThreads )
+   {
+
+      StopPageInThreads( ) ;
+
+      if ( numThreads <= 0 )
+      {
+         return ;
+      } /* if */
+
+      pPageInQueue = new VMC_PageInQueue( numThreads , maxPageFrames ) ;
+
+   } // End of function: VMR !Start page in threads
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Stop page in threads
+
+   void VMC_VirtualMemoryRoot ::
+             StopPageInThreads( )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      if ( pPageInQueue == NULL )
+      {
+         return ;
+      } /* if */
+
+      FinishAllPageIns( ) ;
+
+      delete pPageInQueue ;
+      pPageInQueue = NULL ;
+
+   } // End of function: VMR !Stop page in threads
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get number page frames
+
+   int VMC_VirtualMemoryRoot ::
+             GetNumPageFrames( )
+   {
+
+      return numPageFrames - numReleasedFrames ;
+
+   } // End of function: VMR !Get number page frames
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get page size
+
+   int VMC_VirtualMemoryRoot ::
+             GetPageSize( )
+   {
+
+      return pageSize ;
+
+   } // End of function: VMR !Get page size
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get total frame accesses
+
+   int VMC_VirtualMemoryRoot :: GetTotalAccesses( )
+   {
+
+      return totalAccessCounter ;
+
+   } // End of function: VMR !Get total frame accesses
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get total frame replaces
+
+   int VMC_VirtualMemoryRoot ::
+             GetTotalReplaces( )
+   {
+
+      return totalReplaceCounter ;
+
+   } // End of function: VMR !Get total frame replaces
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get total hit count
+
+   int VMC_VirtualMemoryRoot ::
+             GetTotalHits( )
+   {
+
+      return totalHitCounter ;
+
+   } // End of function: VMR !Get total hit count
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get number of pinned frames
+
+   int VMC_VirtualMemoryRoot ::
+            GetNumPinnedFrames( )
+   {
+
+      VMC_CleanerLock rootLock ;
+
+      int countPinned = 0 ;
+
+      const int * vtNumPins = pFrameMetadata->vtNumPins ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+      {
+         countPinned += ( vtNumPins[ inxFrame ] != 0 ) ;
+      } /* for */
+
+      return countPinned ;
+
+   } // End of function: VMR !Get number of pinned frames
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get page frame of current element
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             GetPageFrame( VMC_PageFrameElement * currentElem )
+   {
+
+
+      return currentElem->pPageFrame ;
+
+   } // End of function: VMR !Get page frame of current element
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get replacement policy
+
+   VMC_ReplacementPolicy * VMC_VirtualMemoryRoot ::
+             GetReplacementPolicy( )
+   {
+
+      return pReplacementPolicy ;
+
+   } // End of function: VMR !Get replacement policy
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get module lock
+
+   std::recursive_mutex * VMC_VirtualMemoryRoot ::
+             GetModuleLock( )
+   {
+
+      if ( !isCleanerRunning )
+      {
+         return NULL ;
+      } /* if */
+
+      return &cleanerMutex ;
+
+   } // End of function: VMR !Get module lock
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get segment page run
+
+   VMC_SegmentPageRun * VMC_VirtualMemoryRoot ::
+             GetSegmentPageRun( )
+   {
+
+      return pSegmentPageRun ;
+
+   } // End of function: VMR !Get segment page run
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get redo log
+
+   VMC_RedoLog * VMC_VirtualMemoryRoot ::
+             GetRedoLog( )
+   {
+
+      return pRedoLog ;
+
+   } // End of function: VMR !Get redo log
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get frame arena
+
+   VMC_FrameArena * VMC_VirtualMemoryRoot ::
+             GetFrameArena( )
+   {
+
+      return pFrameArena ;
+
+   } // End of function: VMR !Get frame arena
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR !Get opening mode of a segment in memory
+
+   TAL_tpOpeningMode VMC_VirtualMemoryRoot ::
+             GetOpeningMode( int idSeg )
+   {
+
+      return GetSegmentMap( idSeg )->openingMode ;
+
+   } // End of function: VMR !Get opening mode of a segment in memory
+
+//==========================================================================
+//----- Protected method implementations -----
+//==========================================================================
+
+// Class: VMR  Virtual memory root singleton
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR #Virtual memory root constructor
+
+   VMC_VirtualMemoryRoot ::
+             VMC_VirtualMemoryRoot( int minFramesParm ,
+                                    int maxFramesParm ,
+                                    VMC_ReplacementPolicy * pPolicyParm ,
+                                    VMC_tpArenaPages arenaPagesParm ,
+                                    int pageSizeParm )
+   {
+
+      StartUpVirtualMemory( minFramesParm , maxFramesParm , pPolicyParm ,
+                            arenaPagesParm , pageSizeParm ) ;
+
+   } // End of function: VMR #Virtual memory root constructor
+
+////////////////////////////////////////////////////////////////////////////
+// 
+// Method: VMR #Virtual memory root destructor
+
+   VMC_VirtualMemoryRoot :: ~VMC_VirtualMemoryRoot( )
+   {
+
+      StopPageInThreads( ) ;
+      StopTailCleaner( ) ;
+      StopDirtyFlusher( ) ;
+
+      delete pWriteBehindQueue ;
+      pWriteBehindQueue = NULL ;
+
+      delete pRedoLog ;
+      pRedoLog = NULL ;
+
+      delete pCompressedTier ;
+      pCompressedTier = NULL ;
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+      {
+         vtPageFrameBlock[ inxFrame ].~VMC_PageFrame( ) ;
+         vtFrameElemBlock[ inxFrame ].~VMC_PageFrameElement( ) ;
+      } /* for */
+
+      ::operator delete( vtPageFrameBlock ) ;
+      vtPageFrameBlock = NULL ;
+
+      ::operator delete( vtFrameElemBlock ) ;
+      vtFrameElemBlock = NULL ;
+
+      delete [ ] vtPageFrameElem ;
+      vtPageFrameElem = NULL ;
+
+      delete pFrameArena ;
+      pFrameArena = NULL ;
+
+      delete [ ] vtEvictedKey ;
+      vtEvictedKey = NULL ;
+
+      delete [ ] pFrameMetadata->vtIdSegment ;
+      delete [ ] pFrameMetadata->vtIdPage ;
+      delete [ ] pFrameMetadata->vtNumPins ;
+      delete [ ] pFrameMetadata->vtChangeLevel ;
+      delete [ ] pFrameMetadata->vtFrameType ;
+      delete [ ] pFrameMetadata->vtIsPrefetched ;
+      delete [ ] pFrameMetadata->vtInxDirty ;
+      delete [ ] pFrameMetadata->vtDirtyFrame ;
+      delete [ ] pFrameMetadata->vtDirtySince ;
+      delete [ ] pFrameMetadata->vtPageLsn ;
+      delete pFrameMetadata ;
+      pFrameMetadata = NULL ;
+
+      delete [ ] vtPageTableSlot ;
+      vtPageTableSlot = NULL ;
+
+      delete [ ] vtLookaside ;
+      vtLookaside = NULL ;
+
+      for ( int idSeg = 0 ; idSeg < dimSegmentMap ; idSeg++ )
+      {
+         delete [ ] vtSegmentMap[ idSeg ].vtInxFrame ;
+         UnmapSegment( &vtSegmentMap[ idSeg ] ) ;
+      } /* for */
+
+      pSegmentPageRun->CloseAllDirect( ) ;
+      pSegmentPageRun->ForgetAllChecksums( ) ;
+      pSegmentPageRun->ForgetAllWritten( ) ;
+      delete pSegmentPageRun ;
+      pSegmentPageRun = NULL ;
+      delete [ ] vtSegmentMap ;
+      vtSegmentMap = NULL ;
+
+      delete pReplacementPolicy ;
+      pReplacementPolicy = NULL ;
+
+      SEG_SegmentRoot::DestroyRoot( ) ;
+
+   } // End of function: VMR #Virtual memory root destructor
+
+//==========================================================================
+//----- Private method implementations -----
+//==========================================================================
+
+// Class: VMR  Virtual memory root singleton
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Search page frame element of virtual page already in real memory
+//    Returns the pointer to the page frame element that contains the
+//    virtual page
+//    NULL if not found
+//    The lookaside is searched first, pages found elsewhere replace the
+//    lookaside entry of their index.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement *  VMC_VirtualMemoryRoot ::
+             SearchRealPage( int idSeg ,
+                             int idPag  )
+   {
+
+      unsigned long long key = ComputePageKey( idSeg , idPag ) ;
+
+      VMC_LookasideEntry * pEntry = &vtLookaside[ ComputeInxLookaside( idSeg , idPag ) ] ;
+
+      totalLookasideSearches ++ ;
+      if ( pEntry->key == key )
+      {
+         totalLookasideHits ++ ;
+         return pEntry->pPageFrameElem ;
+      } /* if */
+
+      VMC_PageFrameElement * pPageFrameElem = NULL ;
+
+      if ( ( idSeg >= 0 )
+        && ( idSeg < dimSegmentMap )
+        && ( vtSegmentMap[ idSeg ].vtInxFrame != NULL ))
+      {
+         VMC_SegmentPageMap * pMap = &vtSegmentMap[ idSeg ] ;
+         if ( ( idPag >= 0 )
+           && ( idPag < pMap->dimMap )
+           && ( pMap->vtInxFrame[ idPag ] >= 0 ))
+         {
+            pPageFrameElem = vtPageFrameElem[ pMap->vtInxFrame[ idPag ]] ;
+         } /* if */
+      } else
+      {
+         int inxSlot = ComputeInxHash( idSeg , idPag ) ;
+
+         while ( vtPageTableSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
+         {
+            if ( vtPageTableSlot[ inxSlot ].key == key )
+            {
+               pPageFrameElem = vtPageFrameElem[ vtPageTableSlot[ inxSlot ].inxFrameElement ] ;
+               break ;
+            } /* if */
+            inxSlot = ( inxSlot + 1 ) & ( numPageTableSlots - 1 ) ;
+         } /* while */
+      } /* if */
+
+      if ( pPageFrameElem != NULL )
+      {
+         pEntry->key            = key ;
+         pEntry->pPageFrameElem = pPageFrameElem ;
+      } /* if */
+
+      return pPageFrameElem ;
+
+   } // End of function: VMR $Search page frame element of virtual page already in real memory
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Start up virtual memory
+//    Reserves the frame arena, creates the initial page frames and hands
+//    them to the replacement policy
+//    All detected errors throw an exception
+// 
+// Parameters
+//    $P numPageFrames  - numeber of frames to be allocated
+//    $P pPolicyParm    - page replacement policy, NULL selects LRU
+//    $P arenaPagesParm - kind of pages backing the frame arena
+//    $P pageSizeParm   - size of the virtual pages
+// 
+// Returned exceptions
+//    Failure if the minimum number of frames cannot be allocated.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             StartUpVirtualMemory( int minFramesParm ,
+                                   int maxFramesParm ,
+                                   VMC_ReplacementPolicy * pPolicyParm ,
+                                   VMC_tpArenaPages arenaPagesParm ,
+                                   int pageSizeParm )
+   {
+
+      // Clear counters
+
+         totalHitCounter     = 0 ;
+         totalAccessCounter  = 0 ;
+         totalReplaceCounter = 0 ;
+
+         evictionMode        = VMC_EVICT_SYNCHRONOUS ;
+         pWriteBehindQueue   = NULL ;
+         pTailCleaner        = NULL ;
+         pDirtyFlusher       = NULL ;
+         isCleanerRunning    = false ;
+         pRedoLog            = NULL ;
+         pPageInQueue        = NULL ;
+         pCompressedTier     = NULL ;
+
+         pReplacementPolicy  = pPolicyParm ;
+         if ( pReplacementPolicy == NULL )
+         {
+            pReplacementPolicy = VMC_ReplacementPolicy::CreatePolicy( VMC_REPLACE_LRU ) ;
+         } /* if */
+
+      // Set the page size
+      //    It is rounded up to a whole number of segment pages.
+
+         numSegmentPagesPerPage = ( pageSizeParm + TAL_PageSize - 1 ) / TAL_PageSize ;
+         if ( numSegmentPagesPerPage < 1 )
+         {
+            numSegmentPagesPerPage = 1 ;
+         } /* if */
+         if ( numSegmentPagesPerPage > MAX_SEGMENT_PAGES_PER_PAGE )
+         {
+            numSegmentPagesPerPage = MAX_SEGMENT_PAGES_PER_PAGE ;
+         } /* if */
+
+         pageSize = numSegmentPagesPerPage * TAL_PageSize ;
+
+         pSegmentPageRun = new VMC_SegmentPageRun( numSegmentPagesPerPage ) ;
+
+      // Reserve the frame arena
+      //    If the page values of maxFrames frames cannot be reserved,
+      //    those of minFrames frames are tried.
+
+         pFrameArena = new VMC_FrameArena( ) ;
+
+         maxPageFrames = maxFramesParm ;
+         if ( !pFrameArena->Map( maxPageFrames , pageSize , arenaPagesParm ))
+         {
+            maxPageFrames = 0 ;
+            if ( ( minFramesParm < maxFramesParm )
+              && ( pFrameArena->Map( minFramesParm , pageSize , arenaPagesParm )))
+            {
+               maxPageFrames = minFramesParm ;
+            } /* if */
+         } /* if */
+
+         if( maxPageFrames < minFramesParm )
+         {
+            MSG_Message * pMsg = new MSG_Message( VMC_InsufficientFrames ) ;
+            pMsg->AddItem( 0 , new MSG_ItemInteger( maxPageFrames )) ;
+            EXC_USAGE( pMsg , -1 , TAL_NullIdHelp ) ;
+         }
+
+         minPageFrames = minFramesParm ;
+         if ( minPageFrames < numMinFrames )
+         {
+            minPageFrames = numMinFrames ;
+         } /* if */
+         if ( minPageFrames > maxPageFrames )
+         {
+            minPageFrames = maxPageFrames ;
+         } /* if */
+
+      // Allocate frame metadata vectors
+
+         int dimMetadata = maxPageFrames > 0 ? maxPageFrames : 1 ;
+
+         pFrameMetadata = new VMC_FrameMetadata ;
+         pFrameMetadata->pageSize      = pageSize ;
+         pFrameMetadata->vtIdSegment   = new int[ dimMetadata ] ;
+         pFrameMetadata->vtIdPage      = new int[ dimMetadata ] ;
+         pFrameMetadata->vtNumPins     = new int[ dimMetadata ] ;
+         pFrameMetadata->vtChangeLevel = new TAL_tpChangeLevel[ dimMetadata ] ;
+         pFrameMetadata->vtFrameType   = new VMC_tpFrameType[ dimMetadata ] ;
+         pFrameMetadata->vtIsPrefetched = new bool[ dimMetadata ] ;
+         pFrameMetadata->vtInxDirty     = new int[ dimMetadata ] ;
+         pFrameMetadata->vtDirtyFrame   = new int[ dimMetadata ] ;
+         pFrameMetadata->numDirtyFrames = 0 ;
+         pFrameMetadata->numPinnedFrames = 0 ;
+         pFrameMetadata->maxPinnedFrames = 0 ;
+         pFrameMetadata->vtDirtySince   = new unsigned long long[ dimMetadata ] ;
+         pFrameMetadata->dirtyClock     = 0 ;
+         pFrameMetadata->vtPageLsn      = new long long[ dimMetadata ] ;
+
+         for ( int inxFrame = 0 ; inxFrame < dimMetadata ; inxFrame++ )
+         {
+            pFrameMetadata->vtInxDirty[ inxFrame ] = -1 ;
+            pFrameMetadata->vtNumPins[ inxFrame ]  = 0 ;
+            pFrameMetadata->vtPageLsn[ inxFrame ]  = 0 ;
+         } /* for */
+
+      // Allocate page frame storage
+      //    Frames are constructed when the pool grows.
+
+         vtFrameElemBlock = static_cast< VMC_PageFrameElement * >(
+                   ::operator new( dimMetadata * sizeof( VMC_PageFrameElement ))) ;
+         vtPageFrameBlock = static_cast< VMC_PageFrame * >(
+                   ::operator new( dimMetadata * sizeof( VMC_PageFrame ))) ;
+
+         vtPageFrameElem = new VMC_PageFrameElement * [ dimMetadata ] ;
+
+         numPageFrames = 0 ;
+
+         pReleasedListHead   = NULL ;
+         numReleasedFrames   = 0 ;
+         totalGrowCounter    = 0 ;
+         totalReleaseCounter = 0 ;
+
+      // Construct the initial frames and hand them to the replacement policy
+
+         pReplacementPolicy->StartPolicy( maxPageFrames ) ;
+
+         while ( numPageFrames < minPageFrames )
+         {
+            ConstructFrame( numPageFrames ) ;
+            numPageFrames ++ ;
+            pReplacementPolicy->AddFrame( vtPageFrameElem[ numPageFrames - 1 ]->pPageFrame ) ;
+         } /* while */
+
+      // Build the free list
+      //    Frames are inserted in reverse order, hence frame 0 is used first.
+
+         pFreeListHead = NULL ;
+         numFreeFrames = 0 ;
+
+         for ( int inxFrame = numPageFrames - 1 ; inxFrame >= 0 ; inxFrame-- )
+         {
+            InsertFreeFrameElement( vtPageFrameElem[ inxFrame ] ) ;
+         } /* for */
+
+      // Allocate evicted page history
+      //    The history covers as many evictions as frames may be added.
+
+         vtEvictedKey    = NULL ;
+         numEvictedSlots = 0 ;
+
+         if ( maxPageFrames > minPageFrames )
+         {
+            numEvictedSlots = EVICTED_HISTORY_MIN_SLOTS ;
+            while ( numEvictedSlots < maxPageFrames - minPageFrames )
+            {
+               numEvictedSlots *= 2 ;
+            } /* while */
+
+            vtEvictedKey = new unsigned long long[ numEvictedSlots ] ;
+            for ( int inxSlot = 0 ; inxSlot < numEvictedSlots ; inxSlot++ )
+            {
+               vtEvictedKey[ inxSlot ] = EMPTY_PAGE_KEY ;
+            } /* for */
+         } /* if */
+
+      // Allocate page table
+
+         vtSegmentMap    = NULL ;
+         dimSegmentMap   = 0 ;
+         isDirectMapOn   = true ;
+
+         totalFlushPageCounter     = 0 ;
+         totalFlushRunCounter      = 0 ;
+
+         totalMapCounter           = 0 ;
+
+         maxReadAhead              = 0 ;
+         totalPrefetchCounter      = 0 ;
+         totalPrefetchHitCounter   = 0 ;
+         totalPrefetchWasteCounter = 0 ;
+
+         vtPageTableSlot = NULL ;
+         AllocatePageTable( numPageFrames ) ;
+
+         vtLookaside = new VMC_LookasideEntry[ LOOKASIDE_SIZE ] ;
+         for ( int inxEntry = 0 ; inxEntry < LOOKASIDE_SIZE ; inxEntry++ )
+         {
+            vtLookaside[ inxEntry ].key            = EMPTY_PAGE_KEY ;
+            vtLookaside[ inxEntry ].pPageFrameElem = NULL ;
+         } /* for */
+
+         totalLookasideSearches = 0 ;
+         totalLookasideHits     = 0 ;
+
+      // Create the segment root singleton
+
+         SEG_SegmentRoot::CreateRoot( ) ;
+
+   } // End of function: VMR $Start up virtual memory
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Find a replaceable page frame element
+//    Takes a frame from the free list. If the free list is empty the
+//    replacement policy chooses a non pinned frame, whose page is
+//    removed first. In clean first mode the victim is not dirty.
+//    The pool grows instead if the page to be placed is hot, or if all
+//    frames are pinned.
+// 
+// Parameters
+//    $P isHotPage - true if the page to be placed has been evicted
+//                   recently
+// 
+// Return value
+//    Pointer to an empty page frame element, no longer in the free list.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             FindReplaceableFrame( bool isHotPage )
+   {
+
+      if ( ( pFreeListHead == NULL )
+        && isHotPage )
+      {
+         GrowPool( ) ;
+      } /* if */
+
+      if ( ( pFreeListHead == NULL )
+        && ( pPageInQueue != NULL )
+        && ( pFrameMetadata->numPinnedFrames >= numPageFrames - numReleasedFrames ))
+      {
+         FinishAllPageIns( ) ;
+      } /* if */
+
+      if ( pFreeListHead == NULL )
+      {
+         VMC_PageFrame * pPageFrame = NULL ;
+
+         if ( evictionMode == VMC_EVICT_CLEAN_FIRST )
+         {
+            pPageFrame = ChooseCleanVictim( ) ;
+         } else
+         {
+            pPageFrame = pReplacementPolicy->ChooseVictim( ) ;
+         } /* if */
+
+         if ( pPageFrame != NULL )
+         {
+            RememberEvictedPage( pPageFrame ) ;
+            StoreVictimPage( pPageFrame ) ;
+            RemovePageValue( GetFrameElement( pPageFrame )) ;
+
+            if ( pTailCleaner != NULL )
+            {
+               pTailCleaner->Wake( ) ;
+            } /* if */
+
+         } else if ( !GrowPool( ))
+         {
+            MSG_Message * pMsg = new MSG_Message( VMC_NoFreeFrame ) ;
+            EXC_PROGRAM( pMsg , -1 , TAL_NullIdHelp ) ;
+         } /* if */
+      } /* if */
+
+      return GetFreeFrameElement( ) ;
+
+   } // End of function: VMR $Find a replaceable page frame element
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Construct page frame
+//    Constructs frame inxFrame in place, it receives page value buffer
+//    inxFrame of the arena and element inxFrame of the metadata vectors.
+//    The frame is empty and belongs to no list. The controls of its
+//    buffer are set.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             ConstructFrame( int inxFrame )
+   {
+
+      VMC_PageFrameElement * pPageFrameElem = &vtFrameElemBlock[ inxFrame ] ;
+
+      VMC_PageFrame * pPageFrame = new ( &vtPageFrameBlock[ inxFrame ] )
+                VMC_PageFrame( inxFrame , pPageFrameElem ,
+                               pFrameArena->GetPageBuffer( inxFrame ) ,
+                               pFrameMetadata ) ;
+
+      pFrameArena->SetBufferControls( inxFrame ) ;
+
+      vtPageFrameElem[ inxFrame ] = new ( pPageFrameElem )
+                VMC_PageFrameElement( inxFrame , pPageFrame , pFrameMetadata ) ;
+
+      return pPageFrameElem ;
+
+   } // End of function: VMR $Construct page frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Grow frame pool
+//    Inserts one more empty frame into the free list. A released frame
+//    is reused if there is one, otherwise the next frame is constructed
+//    and handed to the replacement policy. The page table grows so that
+//    at most half of its slots may be used.
+// 
+// Return value
+//    false if the pool already has maxFrames frames
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   bool VMC_VirtualMemoryRoot ::
+             GrowPool( )
+   {
+
+      VMC_PageFrameElement * pPageFrameElem = pReleasedListHead ;
+
+      if ( pPageFrameElem != NULL )
+      {
+         pReleasedListHead = pPageFrameElem->nextFreeElem ;
+         pPageFrameElem->nextFreeElem = NULL ;
+         numReleasedFrames -- ;
+
+         pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
+         pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+
+      } else if ( numPageFrames < maxPageFrames )
+      {
+         pPageFrameElem = ConstructFrame( numPageFrames ) ;
+         numPageFrames ++ ;
+
+         pReplacementPolicy->AddFrame( pPageFrameElem->pPageFrame ) ;
+
+         if ( 2 * numPageFrames > numPageTableSlots )
+         {
+            AllocatePageTable( numPageFrames ) ;
+         } /* if */
+
+      } else
+      {
+         return false ;
+      } /* if */
+
+      InsertFreeFrameElement( pPageFrameElem ) ;
+      totalGrowCounter ++ ;
+
+      return true ;
+
+   } // End of function: VMR $Grow frame pool
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Choose releasable victim
+//    Returns the first candidate of the replacement policy that is
+//    neither pinned nor dirty. Policies that do not list their candidates
+//    offer their victim only.
+// 
+// Return value
+//    The chosen frame, NULL if there is none.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             ChooseReleasableVictim( )
+   {
+
+      VMC_PageFrame * vtCandidate[ CLEANER_MAX_SCAN ] ;
+
+      int numCandidates = pReplacementPolicy->GetVictimCandidates(
+                vtCandidate , CLEANER_MAX_SCAN ) ;
+
+      if ( numCandidates <= 0 )
+      {
+         vtCandidate[ 0 ] = pReplacementPolicy->ChooseVictim( ) ;
+         numCandidates    = ( vtCandidate[ 0 ] != NULL ) ? 1 : 0 ;
+      } /* if */
+
+      for ( int inxCandidate = 0 ; inxCandidate < numCandidates ; inxCandidate++ )
+      {
+         VMC_PageFrame * pPageFrame = vtCandidate[ inxCandidate ] ;
+         if ( ( pPageFrame->GetNumPins( ) == 0 )
+           && ( pPageFrame->GetDirtyFlag( ) >= TAL_NOT_CHANGED ))
+         {
+            return pPageFrame ;
+         } /* if */
+      } /* for */
+
+      return NULL ;
+
+   } // End of function: VMR $Choose releasable victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Write page run
+//    Writes the pages of a run of dirty frames holding adjacent pages of
+//    a segment, in page order, holding the segment I/O lock for the
+//    whole run. Must be called holding the module lock.
+//    A run of a segment in direct I/O mode takes one pwritev. If it
+//    cannot, its pages are written one by one.
+//    The redo log is first made durable up to the last record of the
+//    run.
+//    If a write fails the frame is dirty again and the exception is
+//    thrown, unless the change is ignorable. The frames not yet written
+//    remain dirty.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             WritePageRun( const VMC_DirtyFrame * vtDirtyFrame ,
+                           int numFrames )
+   {
+
+      const TAL_tpChangeLevel * vtChangeLevel = pFrameMetadata->vtChangeLevel ;
+
+      if ( pRedoLog != NULL )
+      {
+         long long runLsn = 0 ;
+         int inxLastFrame = vtDirtyFrame[ 0 ].inxFrame ;
+         for ( int inxRun = 0 ; inxRun < numFrames ; inxRun++ )
+         {
+            long long pageLsn = pFrameMetadata->vtPageLsn[ vtDirtyFrame[ inxRun ].inxFrame ] ;
+            if ( pageLsn > runLsn )
+            {
+               runLsn       = pageLsn ;
+               inxLastFrame = vtDirtyFrame[ inxRun ].inxFrame ;
+            } /* if */
+         } /* for */
+         pRedoLog->ForcePage( runLsn ,
+                   pFrameMetadata->vtIdSegment[ inxLastFrame ] ,
+                   pFrameMetadata->vtIdPage[ inxLastFrame ] ) ;
+      } /* if */
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+
+      // Write a direct segment run with one vectored write
+
+         int idSegRun = pFrameMetadata->vtIdSegment[ vtDirtyFrame[ 0 ].inxFrame ] ;
+
+         if ( pSegmentPageRun->IsDirect( idSegRun ))
+         {
+            char ** vtPageValue = new char * [ numFrames ] ;
+            for ( int inxRun = 0 ; inxRun < numFrames ; inxRun++ )
+            {
+               vtPageValue[ inxRun ] = vtPageFrameElem[ vtDirtyFrame[ inxRun ].inxFrame ]->
+                         pPageFrame->GetPageValue( ) ;
+            } /* for */
+
+            bool isWritten = pSegmentPageRun->WriteDirectRuns( idSegRun ,
+                      pFrameMetadata->vtIdPage[ vtDirtyFrame[ 0 ].inxFrame ] ,
+                      vtPageValue , numFrames ) ;
+            delete [ ] vtPageValue ;
+
+            if ( isWritten )
+            {
+               for ( int inxRun = 0 ; inxRun < numFrames ; inxRun++ )
+               {
+                  pFrameMetadata->SetChangeLevel( vtDirtyFrame[ inxRun ].inxFrame ,
+                            TAL_NOT_CHANGED ) ;
+               } /* for */
+
+               totalFlushPageCounter += numFrames ;
+               return ;
+            } /* if */
+         } /* if */
+
+      // Write the pages one by one
+
+         for ( int inxRun = 0 ; inxRun < numFrames ; inxRun++ )
+         {
+            int inxFrame = vtDirtyFrame[ inxRun ].inxFrame ;
+
+            TAL_tpChangeLevel level = vtChangeLevel[ inxFrame ] ;
+            pFrameMetadata->SetChangeLevel( inxFrame , TAL_NOT_CHANGED ) ;
+
+            try
+            {
+               pSegmentPageRun->WriteRun( pFrameMetadata->vtIdSegment[ inxFrame ] ,
+                         pFrameMetadata->vtIdPage[ inxFrame ] ,
+                         vtPageFrameElem[ inxFrame ]->pPageFrame->GetPageValue( )) ;
+            }
+            catch ( EXC_Exception * pExc )
+            {
+               if ( level == TAL_IGNORABLE_CHANGE )
+               {
+                  delete pExc ;
+               } else
+               {
+                  pFrameMetadata->SetChangeLevel( inxFrame , level ) ;
+                  throw pExc ;
+               } /* if */
+            } /* end catch */
+
+            totalFlushPageCounter ++ ;
+         } /* for */
+
+   } // End of function: VMR $Write page run
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Sync all segments written
+//    Syncs every segment written since the last sync, whether buffered
+//    or in direct I/O mode. Throws if a segment cannot be synced, it is
+//    synced again by the next sync.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             SyncAllWrittenSegments( )
+   {
+
+      bool isSynced ;
+      {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+         isSynced = pSegmentPageRun->SyncWrittenSegments( ) ;
+      }
+
+      if ( !isSynced )
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorPageFrame ) , -1 , TAL_NullIdHelp ) ;
+      } /* if */
+
+   } // End of function: VMR $Sync all segments written
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Compare dirty frames
+//    qsort comparison of dirty frame entries by page key, i.e. by segment
+//    and then by page.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   int VMC_VirtualMemoryRoot ::
+             CompareDirtyFrames( const void * pFirst ,
+                                 const void * pSecond )
+   {
+
+      unsigned long long keyFirst  = static_cast< const VMC_DirtyFrame * >( pFirst )->key ;
+      unsigned long long keySecond = static_cast< const VMC_DirtyFrame * >( pSecond )->key ;
+
+      if ( keyFirst < keySecond )
+      {
+         return -1 ;
+      } /* if */
+
+      return ( keyFirst > keySecond ) ? 1 : 0 ;
+
+   } // End of function: VMR $Compare dirty frames
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Read ahead
+//    Follows the accesses to the pages of a segment. Once several
+//    consecutive accesses are the same number of pages apart, the pages
+//    that follow at that stride are read ahead, up to the read ahead
+//    window of the segment beyond the page just accessed.
+// 
+// Parameters
+//    pKeptFrame - frame returned to the caller, it must not be evicted
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             ReadAhead( int idSeg ,
+                        int idPag ,
+                        VMC_PageFrame * pKeptFrame )
+   {
+
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
+
+      if ( pMap->pMapping != NULL )
+      {
+         return ;
+      } /* if */
+
+      int stride = idPag - pMap->lastIdPag ;
+      if ( stride == 0 )
+      {
+         return ;
+      } /* if */
+
+      pMap->lastIdPag = idPag ;
+
+      if ( stride != pMap->stride )
+      {
+         pMap->stride     = stride ;
+         pMap->numStrides = 1 ;
+         pMap->nextIdPag  = idPag + stride ;
+         return ;
+      } /* if */
+
+      pMap->numStrides ++ ;
+      if ( pMap->numStrides < READ_AHEAD_MIN_STRIDES )
+      {
+         return ;
+      } /* if */
+
+      // Read the pages of the window not yet read ahead
+
+         int numWindow = pMap->numReadAhead ;
+         if ( numWindow > maxReadAhead )
+         {
+            numWindow = maxReadAhead ;
+         } /* if */
+
+         int idLastPag = idPag + stride * numWindow ;
+         int numPages ;
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            numPages = pSegmentPageRun->GetNumPages( idSeg ) ;
+         }
+
+         if ( ( stride > 0 ) ? ( pMap->nextIdPag <= idPag )
+                             : ( pMap->nextIdPag >= idPag ))
+         {
+            pMap->nextIdPag = idPag + stride ;
+         } /* if */
+
+         while ( ( pMap->nextIdPag >= 0 )
+              && ( pMap->nextIdPag < numPages )
+              && ( ( stride > 0 ) ? ( pMap->nextIdPag <= idLastPag )
+                                  : ( pMap->nextIdPag >= idLastPag )))
+         {
+            if ( !PrefetchPage( idSeg , pMap->nextIdPag , pKeptFrame ))
+            {
+               break ;
+            } /* if */
+            pMap->nextIdPag += stride ;
+         } /* while */
+
+   } // End of function: VMR $Read ahead
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Prefetch page
+//    Reads a page ahead into a free frame, or into a frame that may be
+//    evicted without writing it. The page is queued to the reader
+//    threads if they run. The replacement policy receives the page at
+//    its cold end.
+// 
+// Return value
+//    false if no frame could be found or the page could not be read,
+//    true otherwise, also if the page is in memory already.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   bool VMC_VirtualMemoryRoot ::
+             PrefetchPage( int idSeg ,
+                           int idPag ,
+                           VMC_PageFrame * pKeptFrame )
+   {
+
+      if ( SearchRealPage( idSeg , idPag ) != NULL )
+      {
+         return true ;
+      } /* if */
+
+      // Find a frame
+
+         VMC_PageFrameElement * pPageFrameElem = GetFreeFrameElement( ) ;
+         if ( pPageFrameElem == NULL )
+         {
+            VMC_PageFrame * pPageFrame = ChoosePrefetchVictim( pKeptFrame ) ;
+            if ( pPageFrame == NULL )
+            {
+               return false ;
+            } /* if */
+
+            RememberEvictedPage( pPageFrame ) ;
+            StoreVictimPage( pPageFrame ) ;
+            RemovePageValue( GetFrameElement( pPageFrame )) ;
+            pPageFrameElem = GetFreeFrameElement( ) ;
+         } /* if */
+
+         totalPrefetchCounter ++ ;
+
+      // Read the page
+
+         if ( ( pPageInQueue != NULL )
+           && ( ( pWriteBehindQueue == NULL )
+             || !pWriteBehindQueue->IsPagePending( idSeg , idPag ))
+           && ( ( pCompressedTier == NULL )
+             || !pCompressedTier->ContainsPage( ComputePageKey( idSeg , idPag ) , true )))
+         {
+            SchedulePageIn( pPageFrameElem , idSeg , idPag , true ) ;
+            return true ;
+         } /* if */
+
+         try
+         {
+            ReplacePage( pPageFrameElem , idSeg , idPag , false , true ) ;
+         } // end try
+         catch ( EXC_Exception * pExc )
+         {
+            delete pExc ;
+            return false ;
+         } /* end catch */
+
+         return true ;
+
+   } // End of function: VMR $Prefetch page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Choose prefetch victim
+//    Chooses among the replacement candidates the first one that is
+//    neither pinned nor dirty, nor a page read ahead and not yet
+//    accessed. Hence read ahead never writes and never evicts the pages
+//    read ahead before. Policies that do not list their candidates read
+//    ahead into free frames only.
+// 
+// Return value
+//    The chosen frame, NULL if there is none.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             ChoosePrefetchVictim( VMC_PageFrame * pKeptFrame )
+   {
+
+      VMC_PageFrame * vtCandidate[ CLEANER_MAX_SCAN ] ;
+
+      int numCandidates = pReplacementPolicy->GetVictimCandidates(
+                vtCandidate , CLEANER_MAX_SCAN ) ;
+
+      for ( int inxCandidate = 0 ; inxCandidate < numCandidates ; inxCandidate++ )
+      {
+         VMC_PageFrame * pPageFrame = vtCandidate[ inxCandidate ] ;
+         if ( ( pPageFrame != pKeptFrame )
+           && ( pPageFrame->GetNumPins( ) == 0 )
+           && ( pPageFrame->GetDirtyFlag( ) >= TAL_NOT_CHANGED )
+           && !GetFrameElement( pPageFrame )->isPrefetched )
+         {
+            return pPageFrame ;
+         } /* if */
+      } /* for */
+
+      return NULL ;
+
+   } // End of function: VMR $Choose prefetch victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Remember evicted page
+//    Records the virtual address of the page of a victim in the evicted
+//    page history, replacing the page recorded in the same slot.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             RememberEvictedPage( VMC_PageFrame * pPageFrame )
+   {
+
+      if ( vtEvictedKey == NULL )
+      {
+         return ;
+      } /* if */
+
+      int idSeg = pPageFrame->GetIdSeg( ) ;
+      int idPag = pPageFrame->GetIdPag( ) ;
+
+      vtEvictedKey[ ( idPag + idSeg * 17 ) & ( numEvictedSlots - 1 ) ] =
+                ComputePageKey( idSeg , idPag ) ;
+
+   } // End of function: VMR $Remember evicted page
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Store victim page in the compressed tier
+//    Only clean copied pages are kept, the tier must hold the value the
+//    page has in its segment. Mapped pages are found in the mapping.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             StoreVictimPage( VMC_PageFrame * pPageFrame )
+   {
+
+      if ( ( pCompressedTier == NULL )
+        || ( pPageFrame->GetDirtyFlag( ) != TAL_NOT_CHANGED )
+        || pPageFrame->IsPageMapped( ))
+      {
+         return ;
+      } /* if */
+
+      pCompressedTier->StorePage( ComputePageKey( pPageFrame->GetIdSeg( ) ,
+                pPageFrame->GetIdPag( )) , pPageFrame->GetPageValue( )) ;
+
+   } // End of function: VMR $Store victim page in the compressed tier
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Redo log records
+//    A first pass finds the end of the intact records and checks that
+//    the segments they name are open, a second one redoes them in order.
+//    Redoing a record whose page was already written rewrites the same
+//    bytes, hence the records of any prefix of the log may be redone.
+// 
+// Return value
+//    Number of data records redone, -1 if a segment is not open.
+//    Throws if a record cannot be redone, the records after it would
+//    otherwise be lost once the log is emptied.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   int VMC_VirtualMemoryRoot ::
+             ReplayLog( const char * pLog , long long sizeLog )
+   {
+
+      const long long sizeHeader = sizeof( VMC_LogRecord ) ;
+      const long long sizeChecksum = sizeof( unsigned int ) ;
+
+      // Find the intact records
+
+         long long sizeIntact = 0 ;
+         int dimLoggedSegment = 0 ;
+
+         while ( sizeIntact + sizeHeader <= sizeLog )
+         {
+            VMC_LogRecord record ;
+            memcpy( &record , pLog + sizeIntact , sizeHeader ) ;
+
+            if ( ( record.sizeData  < 0 )
+              || ( record.idSegment < 0 )
+              || ( record.position  < 0 )
+              || ( sizeIntact + sizeHeader + record.sizeData > sizeLog )
+              || ( ( record.kind != LOG_RECORD_SEGMENT )
+                && ( record.kind != LOG_RECORD_DATA ))
+              || ( record.checksum != pSegmentPageRun->ComputeChecksum(
+                        pLog + sizeIntact + sizeChecksum ,
+                        sizeHeader - sizeChecksum + record.sizeData )))
+            {
+               break ;
+            } /* if */
+
+            if ( record.kind == LOG_RECORD_SEGMENT )
+            {
+               if ( FindLoggedSegment( pLog + sizeIntact + sizeHeader ,
+                                       record.sizeData ) == TAL_NullIdSeg )
+               {
+                  return -1 ;
+               } /* if */
+
+               if ( record.idSegment >= dimLoggedSegment )
+               {
+                  dimLoggedSegment = record.idSegment + 1 ;
+               } /* if */
+            } /* if */
+
+            sizeIntact += sizeHeader + record.sizeData ;
+         } /* while */
+
+      // Redo the data records
+      //    vtIdSegment maps the segment ids of the log to the current ones.
+
+         int * vtIdSegment = new int[ dimLoggedSegment > 0 ? dimLoggedSegment : 1 ] ;
+         for ( int idLogged = 0 ; idLogged < dimLoggedSegment ; idLogged++ )
+         {
+            vtIdSegment[ idLogged ] = TAL_NullIdSeg ;
+         } /* for */
+
+         int numRedone = 0 ;
+         long long inxLog = 0 ;
+
+         while ( inxLog < sizeIntact )
+         {
+            VMC_LogRecord record ;
+            memcpy( &record , pLog + inxLog , sizeHeader ) ;
+            const char * pData = pLog + inxLog + sizeHeader ;
+
+            if ( record.kind == LOG_RECORD_SEGMENT )
+            {
+               vtIdSegment[ record.idSegment ] = FindLoggedSegment( pData ,
+                         record.sizeData ) ;
+            } else if ( ( record.idSegment < dimLoggedSegment )
+                     && ( vtIdSegment[ record.idSegment ] != TAL_NullIdSeg ))
+            {
+               try
+               {
+                  RedoLogData( vtIdSegment[ record.idSegment ] ,
+                               record.position , record.sizeData , pData ) ;
+               }
+               catch ( ... )
+               {
+                  delete [ ] vtIdSegment ;
+                  throw ;
+               } /* end catch */
+               numRedone ++ ;
+            } /* if */
+
+            inxLog += sizeHeader + record.sizeData ;
+         } /* while */
+
+         delete [ ] vtIdSegment ;
+
+      return numRedone ;
+
+   } // End of function: VMR $Redo log records
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Find segment of a log record
+//    Returns TAL_NullIdSeg if no open segment has the full name.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   int VMC_VirtualMemoryRoot ::
+             FindLoggedSegment( const char * pName , int sizeName )
+   {
+
+      std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+
+      int idSeg = pSegRoot->GetNextIdSegment( TAL_NullIdSeg ) ;
+
+      while ( idSeg != TAL_NullIdSeg )
+      {
+         STR_String * pSegName = pSegRoot->GetSegmentFullName( idSeg ) ;
+         bool isFound = ( pSegName->GetLength( ) == sizeName )
+                     && ( memcmp( pSegName->GetString( ) , pName , sizeName ) == 0 ) ;
+         delete pSegName ;
+
+         if ( isFound )
+         {
+            return idSeg ;
+         } /* if */
+
+         idSeg = pSegRoot->GetNextIdSegment( idSeg ) ;
+      } /* while */
+
+      return TAL_NullIdSeg ;
+
+   } // End of function: VMR $Find segment of a log record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Redo data of a log record
+//    The position is split into pages of the current page size, which
+//    need not be the one of the session that logged the record.
+//    Pages beyond the end of the segment are skipped. Throws if a page
+//    cannot be read or set dirty.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             RedoLogData( int idSeg , long long position ,
+                          int sizeData , const char * pData )
+   {
+
+      int numPages ;
+      {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+         numPages = pSegmentPageRun->GetNumPages( idSeg ) ;
+      }
+
+      while ( sizeData > 0 )
+      {
+         long long idPag = position / pageSize ;
+         int offset = static_cast< int >( position % pageSize ) ;
+         int length = pageSize - offset ;
+         if ( length > sizeData )
+         {
+            length = sizeData ;
+         } /* if */
+
+         if ( idPag >= numPages )
+         {
+            return ;
+         } /* if */
+
+         VMC_PageFrame * pPageFrame = GetPageFrame( idSeg , static_cast< int >( idPag )) ;
+         memcpy( pPageFrame->GetPageValue( ) + offset , pData , length ) ;
+         pPageFrame->SetFrameDirty( TAL_CHANGED ) ;
+
+         position += length ;
+         pData    += length ;
+         sizeData -= length ;
+      } /* while */
+
+   } // End of function: VMR $Redo data of a log record
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Was page evicted recently
+//    Returns true if the page is in the evicted page history, and removes
+//    it from there. A page found there would still be in memory if the
+//    pool had about as many more frames as there are history slots.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   bool VMC_VirtualMemoryRoot ::
+             IsRecentlyEvicted( int idSeg , int idPag )
+   {
+
+      if ( vtEvictedKey == NULL )
+      {
+         return false ;
+      } /* if */
+
+      unsigned long long * pKey =
+                &vtEvictedKey[ ( idPag + idSeg * 17 ) & ( numEvictedSlots - 1 ) ] ;
+
+      if ( *pKey != ComputePageKey( idSeg , idPag ))
+      {
+         return false ;
+      } /* if */
+
+      *pKey = EMPTY_PAGE_KEY ;
+      return true ;
+
+   } // End of function: VMR $Was page evicted recently
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Replace page in frame
+//    Places a page read from a given segment into an empty frame.
+//    The frame must have been taken from the free list, it returns
+//    there if the page cannot be read.
+// 
+// Parameters
+//    isNewPage  - true if page is not to be read, but set to undefined chars
+//                 false if should be read
+//    isPrefetch - true if the page is read ahead
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             ReplacePage( VMC_PageFrameElement * pPageFrameElem ,
+                          int  idSeg    ,
+                          int  idPag    ,
+                          bool isNewPage ,
+                          bool isPrefetch )
+   {
+
+      totalReplaceCounter ++ ;
+
+      if ( isNewPage )
+      {
+      #ifdef VMC_RELEASE
+         memset( pFrameArena->GetPageBuffer( pPageFrameElem->inxFrameElement ) ,
+                 VALUE_UNDEFINED , pageSize ) ;
+      #endif
+         pPageFrameElem->pPageFrame->SetIdSeg( idSeg ) ;
+         pPageFrameElem->pPageFrame->SetIdPag( idPag ) ;
+      } else
+
+      if ( ( pWriteBehindQueue != NULL )
+        && ( pWriteBehindQueue->CopyPendingPage( idSeg , idPag ,
+                       pFrameArena->GetPageBuffer( pPageFrameElem->inxFrameElement ))))
+      {
+         pPageFrameElem->pPageFrame->SetIdSeg( idSeg ) ;
+         pPageFrameElem->pPageFrame->SetIdPag( idPag ) ;
+      } else
+
+      if ( GetMappedValue( idSeg , idPag ) != NULL )
+      {
+         pPageFrameElem->pPageFrame->MapPageFrame( idSeg , idPag ,
+                   GetMappedValue( idSeg , idPag )) ;
+         totalMapCounter ++ ;
+      } else
+
+      if ( ( pCompressedTier != NULL )
+        && pCompressedTier->LoadPage( ComputePageKey( idSeg , idPag ) ,
+                       pFrameArena->GetPageBuffer( pPageFrameElem->inxFrameElement )))
+      {
+         pPageFrameElem->pPageFrame->SetIdSeg( idSeg ) ;
+         pPageFrameElem->pPageFrame->SetIdPag( idPag ) ;
+      } else
+
+      {
+         try
+         {
+            pPageFrameElem->pPageFrame->ReadPageFrame( idSeg , idPag ) ;
+         } // end try
+         catch( ... )
+         {
+            pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
+            pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+            InsertFreeFrameElement( pPageFrameElem ) ;
+
+            throw ;
+
+         } // end try catch
+      } /* if */
+
+      pPageFrameElem->frameType = FRAME_TYPE_IN_USE ;
+      InsertPageFrame( pPageFrameElem , isPrefetch ) ;
+
+   } // End of function: VMR $Replace page in frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Insert page frame
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             InsertPageFrame( VMC_PageFrameElement * pPageFrameElem ,
+                              bool isPrefetch )
+   {
+
+      {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+         SEG_SegmentRoot::GetRoot( )->GetSegment( pPageFrameElem->
+                   pPageFrame->GetIdSeg( ))->IncreaseNumOpenPages( ) ;
+      }
+
+      RegisterPage( pPageFrameElem ) ;
+
+      if ( pCompressedTier != NULL )
+      {
+         pCompressedTier->DropPage( ComputePageKey(
+                   pPageFrameElem->pPageFrame->GetIdSeg( ) ,
+                   pPageFrameElem->pPageFrame->GetIdPag( ))) ;
+      } /* if */
+
+      pPageFrameElem->isPrefetched = isPrefetch ;
+      if ( isPrefetch )
+      {
+         pReplacementPolicy->OnPrefetch( pPageFrameElem->pPageFrame ) ;
+      } else
+      {
+         pReplacementPolicy->OnInsert( pPageFrameElem->pPageFrame ) ;
+      } /* if */
+
+   } // End of function: VMR $Insert page frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Schedule page in
+//    Registers the page in an empty frame and queues its read. The frame
+//    is pinned until the read is finished.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             SchedulePageIn( VMC_PageFrameElement * pPageFrameElem ,
+                             int  idSeg ,
+                             int  idPag ,
+                             bool isPrefetch )
+   {
+
+      totalReplaceCounter ++ ;
+
+      VMC_PageFrame * pPageFrame = pPageFrameElem->pPageFrame ;
+      pPageFrame->SetIdSeg( idSeg ) ;
+      pPageFrame->SetIdPag( idPag ) ;
+
+      pPageFrameElem->frameType = FRAME_TYPE_READING ;
+      InsertPageFrame( pPageFrameElem , isPrefetch ) ;
+      pPageFrame->PinFrame( ) ;
+
+      int inxFrame = pPageFrameElem->inxFrameElement ;
+      pPageInQueue->ScheduleRead( inxFrame , idSeg , idPag ,
+                pFrameArena->GetPageBuffer( inxFrame )) ;
+
+   } // End of function: VMR $Schedule page in
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Finish page in
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             FinishPageIn( VMC_PageFrameElement * pPageFrameElem )
+   {
+
+      EXC_Exception * pExc = pPageInQueue->WaitRead(
+                pPageFrameElem->inxFrameElement ) ;
+
+      pPageFrameElem->frameType = FRAME_TYPE_IN_USE ;
+      pPageFrameElem->pPageFrame->UnpinFrame( ) ;
+
+      if ( pExc != NULL )
+      {
+         RemovePageValue( pPageFrameElem ) ;
+         throw pExc ;
+      } /* if */
+
+      if ( pPageFrameElem->isPrefetched
+        && ( pPageFrameElem->pPageFrame->GetNumPins( ) == 0 ))
+      {
+         pReplacementPolicy->OnPrefetch( pPageFrameElem->pPageFrame ) ;
+      } /* if */
+
+   } // End of function: VMR $Finish page in
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Finish all page ins
+//    Waits for all reads in flight. Pages whose read failed are removed.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             FinishAllPageIns( )
+   {
+
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+      {
+         if ( pFrameMetadata->vtFrameType[ inxFrame ] == FRAME_TYPE_READING )
+         {
+            try
+            {
+               FinishPageIn( vtPageFrameElem[ inxFrame ] ) ;
+            }
+            catch ( EXC_Exception * pExc )
+            {
+               delete pExc ;
+            } /* end catch */
+         } /* if */
+      } /* for */
+
+   } // End of function: VMR $Finish all page ins
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Get page frame element of a frame
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             GetFrameElement( VMC_PageFrame * pPageFrame )
+   {
+
+      return vtPageFrameElem[ pPageFrame->GetInxPageFrameElem( ) ] ;
+
+   } // End of function: VMR $Get page frame element of a frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Get empty page frame
+//    Gets a frame without reading it from disk.
+//    This function is used when a new page must be added to the segment.
+//    The page value contained in the frame is set to undefined chars.
+// 
+// Returned exceptions
+//    Enforce - if the page to be added already exists in real memory
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             GetEmptyFrame( int idSeg ,
+                            int idPag  )
+   {
+
+
+      VMC_PageFrameElement * pPageFrameElem = SearchRealPage( idSeg , idPag ) ;
+
+      pPageFrameElem = FindReplaceableFrame( false ) ;
+      ReplacePage( pPageFrameElem , idSeg , idPag , true , false ) ;
+
+      return pPageFrameElem ;
+
+   } // End of function: VMR $Get empty page frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Remove page from frame
+//    Removes the page from the page frame.
+//    After this operation the frame is empty.
+//    If a page has been removed the replacement policy is informed and
+//    the frame is inserted into the free list.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             RemovePageValue( VMC_PageFrameElement * pPageFrameElem )
+   {
+
+      if ( pPageFrameElem->frameType == FRAME_TYPE_READING )
+      {
+         try
+         {
+            FinishPageIn( pPageFrameElem ) ;
+         }
+         catch ( EXC_Exception * pExc )
+         {
+            delete pExc ;
+            return ;
+         } /* end catch */
+      } /* if */
+
+      if ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+      {
+         if ( pPageFrameElem->isPrefetched )
+         {
+            pPageFrameElem->isPrefetched = false ;
+            totalPrefetchWasteCounter ++ ;
+
+            VMC_SegmentPageMap * pMap = GetSegmentMap(
+                      pPageFrameElem->pPageFrame->GetIdSeg( )) ;
+            pMap->numReadAhead /= 2 ;
+            if ( pMap->numReadAhead < READ_AHEAD_MIN_PAGES )
+            {
+               pMap->numReadAhead = READ_AHEAD_MIN_PAGES ;
+            } /* if */
+         } /* if */
+
+         pPageFrameElem->pPageFrame->WritePageFrame( ) ;
+
+         UnregisterPage( pPageFrameElem ) ;
+
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            SEG_SegmentRoot::GetRoot( )->GetSegment( pPageFrameElem->
+                      pPageFrame->GetIdSeg( ))->DecreaseNumOpenPages( ) ;
+         }
+
+         pReplacementPolicy->OnRemove( pPageFrameElem->pPageFrame ) ;
+
+         pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
+         pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+
+         InsertFreeFrameElement( pPageFrameElem ) ;
+         return ;
+      } /* if */
+
+      pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
+      pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+      pPageFrameElem->isPrefetched = false ;
+
+   } // End of function: VMR $Remove page from frame
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Take a page frame element from the free list
+// 
+// Return value
+//    An empty page frame element, NULL if the free list is empty.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
+             GetFreeFrameElement( )
+   {
+
+      VMC_PageFrameElement * pPageFrameElem = pFreeListHead ;
+
+      if ( pPageFrameElem != NULL )
+      {
+         pFreeListHead = pPageFrameElem->nextFreeElem ;
+         pPageFrameElem->nextFreeElem = NULL ;
+         numFreeFrames -- ;
+      } /* if */
+
+      return pPageFrameElem ;
+
+   } // End of function: VMR $Take a page frame element from the free list
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Insert page frame element into the free list
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             InsertFreeFrameElement( VMC_PageFrameElement * pPageFrameElem )
+   {
+
+      pPageFrameElem->nextFreeElem = pFreeListHead ;
+      pFreeListHead = pPageFrameElem ;
+      numFreeFrames ++ ;
+
+   } // End of function: VMR $Insert page frame element into the free list
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Choose clean victim
+//    Inspects the first candidates of the replacement policy and returns
+//    the first one that is not dirty. Dirty candidates inspected are
+//    handed to the write behind queue, they become clean and stay in
+//    memory, hence will be cheap victims later on.
+//    If all candidates were dirty the first one is returned, its page
+//    value now being in the write behind queue.
+// 
+// Return value
+//    A clean non pinned frame, NULL if all frames are pinned.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   VMC_PageFrame * VMC_VirtualMemoryRoot ::
+             ChooseCleanVictim( )
+   {
+
+      VMC_PageFrame * vtCandidate[ WRITE_BEHIND_SCAN ] ;
+
+      int numCandidates = pReplacementPolicy->GetVictimCandidates(
+                vtCandidate , WRITE_BEHIND_SCAN ) ;
+
+      if ( numCandidates <= 0 )
+      {
+         VMC_PageFrame * pPageFrame = pReplacementPolicy->ChooseVictim( ) ;
+         if ( ( pPageFrame != NULL )
+           && ( pPageFrame->GetDirtyFlag( ) < TAL_NOT_CHANGED ))
+         {
+            pWriteBehindQueue->ScheduleWrite( pPageFrame ) ;
+         } /* if */
+
+         return pPageFrame ;
+      } /* if */
+
+      for ( int inxCandidate = 0 ; inxCandidate < numCandidates ; inxCandidate++ )
+      {
+         if ( vtCandidate[ inxCandidate ]->GetDirtyFlag( ) >= TAL_NOT_CHANGED )
+         {
+            return vtCandidate[ inxCandidate ] ;
+         } /* if */
+
+         pWriteBehindQueue->ScheduleWrite( vtCandidate[ inxCandidate ] ) ;
+      } /* for */
+
+      return vtCandidate[ 0 ] ;
+
+   } // End of function: VMR $Choose clean victim
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Wait until all write behind pages are written
+//    Must precede any synchronous page write, otherwise an older copy
+//    of the page still in the queue could overwrite the newer value.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   void VMC_VirtualMemoryRoot ::
+             DrainWriteBehind( )
+   {
 
-//==========================================================================
-//----- Protected method implementations -----
-//==========================================================================
+      if ( pWriteBehindQueue != NULL )
+      {
+         pWriteBehindQueue->Drain( ) ;
+      } /* if */
 
-// Class: VMR  Virtual memory root singleton
+   } // End of function: VMR $Wait until all write behind pages are written
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR #Virtual memory root constructor
+//  Method: VMR $Wait for the write of the tail cleaner
+//    Must be called holding the module lock.
+//    The cleaner and the flusher mark a frame not dirty and take the
+//    segment I/O lock while holding the module lock, hence a write that
+//    has already cleaned a frame ends before the I/O lock can be taken here.
+// 
+////////////////////////////////////////////////////////////////////////////
 
-   VMC_VirtualMemoryRoot ::
-             VMC_VirtualMemoryRoot( int minFramesParm ,
-                                    int maxFramesParm  )
+   void VMC_VirtualMemoryRoot ::
+             WaitCleanerWrite( )
    {
 
-      StartUpVirtualMemory( minFramesParm , maxFramesParm ) ;
+      if ( ( pTailCleaner  != NULL )
+        || ( pDirtyFlusher != NULL ))
+      {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+      } /* if */
 
-   } // End of function: VMR #Virtual memory root constructor
+   } // End of function: VMR $Wait for the write of the tail cleaner
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-// Method: VMR #Virtual memory root destructor
+//  Method: VMR $Compute hash index
+//    Computes the home slot of a virtual address in the page table.
+//    The key is mixed by the 64 bit finalizer of MurmurHash3, hence
+//    consecutive pages of a segment are spread over the whole table.
+// 
+////////////////////////////////////////////////////////////////////////////
 
-   VMC_VirtualMemoryRoot :: ~VMC_VirtualMemoryRoot( )
+   int VMC_VirtualMemoryRoot ::
+             ComputeInxHash( int idSeg , int idPag )
    {
 
-      VMC_PageFrameElement * nextPageFrameElem = NULL ;
-      VMC_PageFrameElement * pPageFrameElem    = lruListHead ;
-      while ( pPageFrameElem != NULL )
-      {
-         nextPageFrameElem = pPageFrameElem->nextLruElem ;
-         delete pPageFrameElem ;
-         pPageFrameElem = nextPageFrameElem ;
-      } /* while */
-
-      SEG_SegmentRoot::DestroyRoot( ) ;
+      unsigned long long key = ComputePageKey( idSeg , idPag ) ;
 
-   } // End of function: VMR #Virtual memory root destructor
+      key ^= key >> 33 ;
+      key *= 0xff51afd7ed558ccdULL ;
+      key ^= key >> 33 ;
+      key *= 0xc4ceb9fe1a85ec53ULL ;
+      key ^= key >> 33 ;
 
-//==========================================================================
-//----- Private method implementations -----
-//==========================================================================
+      return static_cast< int >( key & ( numPageTableSlots - 1 )) ;
 
-// Class: VMR  Virtual memory root singleton
+   } // End of function: VMR $Compute hash index
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Search page frame element of virtual page already in real memory
-//    Returns the pointer to the page frame element that contains the
-//    virtual page
-//    NULL if not found
+//  Method: VMR $Compute lookaside index
+//    Pages close to one another receive different entries.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
-   VMC_PageFrameElement *  VMC_VirtualMemoryRoot ::
-             SearchRealPage( int idSeg ,
-                             int idPag  )
+   int VMC_VirtualMemoryRoot ::
+             ComputeInxLookaside( int idSeg , int idPag )
    {
 
-      int inxHash = ComputeInxHash( idSeg , idPag ) ;
+      return ( idPag + idSeg * 17 ) & ( LOOKASIDE_SIZE - 1 ) ;
 
-      VMC_PageFrameElement * pPageFrameElem = vtColision[ inxHash ] ;
+   } // End of function: VMR $Compute lookaside index
 
-      while ( pPageFrameElem != NULL )
-      {
-         if ( ( pPageFrameElem->pPageFrame->GetIdSeg( ) == idSeg )
-           && ( pPageFrameElem->pPageFrame->GetIdPag( ) == idPag ))
-         {
-            return pPageFrameElem ;
-         } /* if */
-         pPageFrameElem = pPageFrameElem->nextColisionElem ;
-      } /* while */
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Compute page table key
+// 
+////////////////////////////////////////////////////////////////////////////
 
-      return NULL ;
+   unsigned long long VMC_VirtualMemoryRoot ::
+             ComputePageKey( int idSeg , int idPag )
+   {
 
-   } // End of function: VMR $Search page frame element of virtual page already in real memory
+      return ( static_cast< unsigned long long >( static_cast< unsigned int >( idSeg )) << 32 )
+           | static_cast< unsigned int >( idPag ) ;
+
+   } // End of function: VMR $Compute page table key
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Start up virtual memory
-//    Creates the LRU and write-page list heads
-//    All detected errors throw an exception
-// 
-// Parameters
-//    $P numPageFrames  - numeber of frames to be allocated
-// 
-// Returned exceptions
-//    Failure if the minimum number of frames cannot be allocated.
+//  Method: VMR $Allocate page table
+//    Allocates a page table with at least twice numEntries slots and
+//    registers in it all frames in use.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             StartUpVirtualMemory( int minFramesParm ,
-                                   int maxFramesParm  )
+             AllocatePageTable( int numEntries )
    {
 
-      // Clear counters
-
-         totalHitCounter     = 0 ;
-         totalAccessCounter  = 0 ;
-         totalReplaceCounter = 0 ;
+      int numSlots = PAGE_TABLE_MIN_SLOTS ;
+      while ( numSlots < 2 * numEntries )
+      {
+         numSlots *= 2 ;
+      } /* while */
 
-      // Allocate page frames
+      delete [ ] vtPageTableSlot ;
 
-         VMC_PageFrameElement * pPageFrameElem ;
+      vtPageTableSlot     = new VMC_PageTableSlot[ numSlots ] ;
+      numPageTableSlots   = numSlots ;
+      numPageTableEntries = 0 ;
 
-         lruListHead = NULL ;
-         lruListTail = NULL ;
+      for ( int inxSlot = 0 ; inxSlot < numSlots ; inxSlot++ )
+      {
+         vtPageTableSlot[ inxSlot ].key             = EMPTY_PAGE_KEY ;
+         vtPageTableSlot[ inxSlot ].inxFrameElement = -1 ;
+      } /* for */
 
-         int countFrames  ;
-         for ( countFrames = 0 ; countFrames < maxFramesParm ; countFrames++ )
+      for ( int inxFrame = 0 ; inxFrame < numPageFrames ; inxFrame++ )
+      {
+         VMC_PageFrameElement * pPageFrameElem = vtPageFrameElem[ inxFrame ] ;
+         if ( ( ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+             || ( pPageFrameElem->frameType == FRAME_TYPE_READING ))
+           && ( GetSegmentMap( pPageFrameElem->pPageFrame->GetIdSeg( ))->
+                      vtInxFrame == NULL ))
          {
-            try
-            {
-               pPageFrameElem = new VMC_PageFrameElement( countFrames ) ;
-               if ( pPageFrameElem == NULL )        // instrumentation catch
-               {
-                  break ;
-               } /* if */
-
-               pPageFrameElem->frameType   = FRAME_TYPE_FREE ;
-
-               if ( countFrames == 0 )
-               {
-                  lruListTail = pPageFrameElem ;
-               } else
-               {
-                  lruListHead->prevLruElem = pPageFrameElem ;
-               } /* if */
+            InsertPageTableEntry( pPageFrameElem ) ;
+         } /* if */
+      } /* for */
 
-               pPageFrameElem->nextLruElem = lruListHead ;
-               lruListHead                 = pPageFrameElem ;
+   } // End of function: VMR $Allocate page table
 
-            } // end try
-            catch( ... )
-            {
-               break ;          // out of memory
-            } // end try catch
-         }
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR $Get segment page map
+//    Grows the vector of maps if idSeg is beyond its end.
+// 
+////////////////////////////////////////////////////////////////////////////
 
-         numPageFrames = countFrames ;
+   VMC_SegmentPageMap * VMC_VirtualMemoryRoot ::
+             GetSegmentMap( int idSeg )
+   {
 
-         if( numPageFrames < minFramesParm )
+      if ( idSeg >= dimSegmentMap )
+      {
+         int dimMap = ( dimSegmentMap > 0 ) ? 2 * dimSegmentMap : 8 ;
+         while ( dimMap <= idSeg )
          {
-            MSG_Message * pMsg = new MSG_Message( VMC_InsufficientFrames ) ;
-            pMsg->AddItem( 0 , new MSG_ItemInteger( numPageFrames )) ;
-            EXC_USAGE( pMsg , -1 , TAL_NullIdHelp ) ;
-         }
-
-      // Clean hash vector
+            dimMap *= 2 ;
+         } /* while */
 
-         for ( int i = 0 ; i < TAL_dimColision ; i++ )
+         VMC_SegmentPageMap * vtMap = new VMC_SegmentPageMap[ dimMap ] ;
+         for ( int inxMap = 0 ; inxMap < dimMap ; inxMap++ )
          {
-            vtColision[ i ] = NULL ;
+            if ( inxMap < dimSegmentMap )
+            {
+               vtMap[ inxMap ] = vtSegmentMap[ inxMap ] ;
+            } else
+            {
+               vtMap[ inxMap ].vtInxFrame     = NULL ;
+               vtMap[ inxMap ].dimMap         = 0 ;
+               vtMap[ inxMap ].numResident    = 0 ;
+               vtMap[ inxMap ].openingMode    = TAL_OpeningModeRead ;
+               vtMap[ inxMap ].pMapping       = NULL ;
+               vtMap[ inxMap ].mappingSize    = 0 ;
+               vtMap[ inxMap ].numMappedPages = 0 ;
+               ResetReadAhead( &vtMap[ inxMap ] ) ;
+            } /* if */
          } /* for */
 
-      // Create the segment root singleton
+         delete [ ] vtSegmentMap ;
+         vtSegmentMap  = vtMap ;
+         dimSegmentMap = dimMap ;
+      } /* if */
 
-         SEG_SegmentRoot::CreateRoot( ) ;
+      return &vtSegmentMap[ idSeg ] ;
 
-   } // End of function: VMR $Start up virtual memory
+   } // End of function: VMR $Get segment page map
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Find a replaceable page frame element
-//    Searches for a non pinned frame from tail to head of LRU
-// 
-// Return value
-//    Pointer to a replaceable page frame found.
+//  Method: VMR $Reset read ahead state
 // 
 ////////////////////////////////////////////////////////////////////////////
 
-   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
-             FindReplaceableFrame( )
+   void VMC_VirtualMemoryRoot ::
+             ResetReadAhead( VMC_SegmentPageMap * pMap )
    {
 
-      VMC_PageFrameElement * pPageFrameElem = lruListTail ;
+      pMap->lastIdPag    = -1 ;
+      pMap->stride       = 0 ;
+      pMap->numStrides   = 0 ;
+      pMap->nextIdPag    = 0 ;
+      pMap->numReadAhead = READ_AHEAD_MIN_PAGES ;
 
-      while ( pPageFrameElem != NULL )
-      {
-         if ( pPageFrameElem->pPageFrame->GetNumPins( ) == 0 )
-         {
-            return pPageFrameElem ;
-         } /* if */
-         pPageFrameElem = pPageFrameElem->prevLruElem ;
-      } /* while */
-
-      MSG_Message * pMsg = new MSG_Message( VMC_NoFreeFrame ) ;
-      EXC_PROGRAM( pMsg , -1 , TAL_NullIdHelp ) ;
-
-   } // End of function: VMR $Find a replaceable page frame element
+   } // End of function: VMR $Reset read ahead state
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Move to LRU head the page frame element
-//    pPageFrameElem - element to be moved
+//  Method: VMR $Unmap segment file
+//    The pages of the segment must have left their frames.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             MoveElemLruHead( VMC_PageFrameElement * pPageFrameElem )
+             UnmapSegment( VMC_SegmentPageMap * pMap )
    {
 
-
-      if ( pPageFrameElem->prevLruElem != NULL )
+      if ( pMap->pMapping != NULL )
       {
+         munmap( pMap->pMapping , pMap->mappingSize ) ;
+         pMap->pMapping       = NULL ;
+         pMap->mappingSize    = 0 ;
+         pMap->numMappedPages = 0 ;
+      } /* if */
 
-         pPageFrameElem->prevLruElem->nextLruElem =
-                   pPageFrameElem->nextLruElem ;
-         if ( pPageFrameElem->nextLruElem != NULL )
-         {
-            pPageFrameElem->nextLruElem->prevLruElem =
-                      pPageFrameElem->prevLruElem ;
-         } else
-         {
-            lruListTail = pPageFrameElem->prevLruElem ;
-         } /* if */
-
-         pPageFrameElem->prevLruElem = NULL ;
-         pPageFrameElem->nextLruElem = lruListHead ;
-         lruListHead->prevLruElem = pPageFrameElem ;
-         lruListHead = pPageFrameElem ;
-
-      } // end selection: Root of VMR $Move to LRU head the page frame element
-
-   } // End of function: VMR $Move to LRU head the page frame element
+   } // End of function: VMR $Unmap segment file
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Move to LRU tail the page frame element
+//  Method: VMR $Get mapped page value
+//    Returns NULL if the page is not mapped.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
-   void VMC_VirtualMemoryRoot ::
-             MoveElemLruTail( VMC_PageFrameElement * pPageFrameElem )
+   char * VMC_VirtualMemoryRoot ::
+             GetMappedValue( int idSeg , int idPag )
    {
 
-      if ( pPageFrameElem->nextLruElem != NULL )
+      if ( ( idSeg < 0 )
+        || ( idSeg >= dimSegmentMap )
+        || ( idPag < 0 )
+        || ( idPag >= vtSegmentMap[ idSeg ].numMappedPages ))
       {
+         return NULL ;
+      } /* if */
 
-         pPageFrameElem->nextLruElem->prevLruElem =
-                   pPageFrameElem->prevLruElem ;
-         if ( pPageFrameElem->prevLruElem != NULL )
-         {
-            pPageFrameElem->prevLruElem->nextLruElem =
-                      pPageFrameElem->nextLruElem ;
-         } else
-         {
-            lruListHead = pPageFrameElem->nextLruElem ;
-         } /* if */
-
-         pPageFrameElem->nextLruElem = NULL ;
-         pPageFrameElem->prevLruElem = lruListTail ;
-         lruListTail->nextLruElem    = pPageFrameElem ;
-         lruListTail = pPageFrameElem ;
-
-      } // end selection: Root of VMR $Move to LRU tail the page frame element
+      return vtSegmentMap[ idSeg ].pMapping +
+                static_cast< size_t >( idPag ) * pageSize ;
 
-   } // End of function: VMR $Move to LRU tail the page frame element
+   } // End of function: VMR $Get mapped page value
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Replace page in frame
-//    Replaces the page contained in the frame by another one read from
-//    a given segment.
-// 
-// Parameters
-//    isNewPage - true if page is not to be read, but set to undefined chars
-//                false if should be read
+//  Method: VMR $Register page of a frame
+//    Registers the page in the direct page map of its segment, or in the
+//    page table if the segment has none.
+//    The direct page map is created when the first page of a segment
+//    is registered, provided the segment is not too large. A page beyond
+//    the end of the map makes it grow, or returns the segment to the
+//    page table if the new dimension would be too large.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             ReplacePage( VMC_PageFrameElement * pPageFrameElem ,
-                          int  idSeg    ,
-                          int  idPag    ,
-                          bool isNewPage )
+             RegisterPage( VMC_PageFrameElement * pPageFrameElem )
    {
 
-      totalReplaceCounter ++ ;
+      int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
+      int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
 
-      RemovePageValue( pPageFrameElem ) ;
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
 
-      if ( isNewPage )
+      int maxMapPages = DIRECT_MAP_PAGES_PER_FRAME * numPageFrames ;
+      if ( maxMapPages < DIRECT_MAP_MIN_PAGES )
       {
-         pPageFrameElem->pPageFrame->SetIdSeg( idSeg ) ;
-         pPageFrameElem->pPageFrame->SetIdPag( idPag ) ;
-      } else
+         maxMapPages = DIRECT_MAP_MIN_PAGES ;
+      } /* if */
 
-      {
-         try
-         {
-            pPageFrameElem->pPageFrame->ReadPageFrame( idSeg , idPag ) ;
-         } // end try
-         catch( ... )
-         {
-            pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
-            pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+      // Keep the opening mode of the segment
 
-            throw ;
+         if ( pMap->numResident == 0 )
+         {
+            std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+            pMap->openingMode = SEG_SegmentRoot::GetRoot( )->GetSegmentOpeningMode( idSeg ) ;
+         } /* if */
 
-         } // end try catch
-      } /* if */
+      // Create direct page map
 
-      pPageFrameElem->frameType = FRAME_TYPE_IN_USE ;
-      SEG_SegmentRoot::GetRoot( )->GetSegment( idSeg )->
-                 IncreaseNumOpenPages( ) ;
+         if ( ( pMap->vtInxFrame  == NULL )
+           && ( pMap->numResident == 0 )
+           && isDirectMapOn )
+         {
+            int numPages ;
+            {
+               std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
+               numPages = pSegmentPageRun->GetNumPages( idSeg ) ;
+            }
+            if ( numPages <= idPag )
+            {
+               numPages = idPag + 1 ;
+            } /* if */
 
-      LinkColisionList( pPageFrameElem ) ;
-      MoveElemLruHead(  pPageFrameElem ) ;
+            if ( numPages <= maxMapPages )
+            {
+               pMap->vtInxFrame = new int[ numPages ] ;
+               pMap->dimMap     = numPages ;
+               for ( int inxPag = 0 ; inxPag < numPages ; inxPag++ )
+               {
+                  pMap->vtInxFrame[ inxPag ] = -1 ;
+               } /* for */
+            } /* if */
+         } /* if */
 
-   } // End of function: VMR $Replace page in frame
+      // Grow direct page map
 
-////////////////////////////////////////////////////////////////////////////
-// 
-//  Method: VMR $Get empty page frame
-//    Gets a frame without reading it from disk.
-//    This function is used when a new page must be added to the segment.
-//    The page value contained in the frame is set to undefined chars.
-// 
-// Returned exceptions
-//    Enforce - if the page to be added already exists in real memory
-// 
-////////////////////////////////////////////////////////////////////////////
+         if ( ( pMap->vtInxFrame != NULL )
+           && ( idPag >= pMap->dimMap ))
+         {
+            int dimMap = 2 * pMap->dimMap ;
+            if ( dimMap <= idPag )
+            {
+               dimMap = idPag + 1 ;
+            } /* if */
+            if ( dimMap > maxMapPages )
+            {
+               dimMap = maxMapPages ;
+            } /* if */
 
-   VMC_PageFrameElement * VMC_VirtualMemoryRoot ::
-             GetEmptyFrame( int idSeg ,
-                            int idPag  )
-   {
+            if ( dimMap <= idPag )
+            {
+               ReleaseSegmentMap( idSeg ) ;
+            } else
+            {
+               int * vtInxFrame = new int[ dimMap ] ;
+               memcpy( vtInxFrame , pMap->vtInxFrame , pMap->dimMap * sizeof( int )) ;
+               for ( int inxPag = pMap->dimMap ; inxPag < dimMap ; inxPag++ )
+               {
+                  vtInxFrame[ inxPag ] = -1 ;
+               } /* for */
 
+               delete [ ] pMap->vtInxFrame ;
+               pMap->vtInxFrame = vtInxFrame ;
+               pMap->dimMap     = dimMap ;
+            } /* if */
+         } /* if */
 
-      VMC_PageFrameElement * pPageFrameElem = SearchRealPage( idSeg , idPag ) ;
+      // Register the page
 
-      pPageFrameElem = FindReplaceableFrame( ) ;
-      ReplacePage( pPageFrameElem , idSeg , idPag , true ) ;
+         if ( pMap->vtInxFrame != NULL )
+         {
+            pMap->vtInxFrame[ idPag ] = pPageFrameElem->inxFrameElement ;
+            pPageFrameElem->inxHash   = -1 ;
+         } else
+         {
+            InsertPageTableEntry( pPageFrameElem ) ;
+         } /* if */
 
-      return pPageFrameElem ;
+         pMap->numResident ++ ;
 
-   } // End of function: VMR $Get empty page frame
+   } // End of function: VMR $Register page of a frame
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Remove page from frame
-//    Removes the page from the page frame.
-//    After this operation the frame is empty.
-//    The LRU list is not changed.
+//  Method: VMR $Unregister page of a frame
+//    Also removes the page from the lookaside.
+//    The direct page map is kept when the segment has no page left in
+//    memory, it is deleted by RemoveSegment.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             RemovePageValue( VMC_PageFrameElement * pPageFrameElem )
+             UnregisterPage( VMC_PageFrameElement * pPageFrameElem )
    {
 
-      if ( pPageFrameElem->frameType == FRAME_TYPE_IN_USE )
+      int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
+      int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
+
+      VMC_LookasideEntry * pEntry = &vtLookaside[ ComputeInxLookaside( idSeg , idPag ) ] ;
+      if ( pEntry->pPageFrameElem == pPageFrameElem )
       {
-         pPageFrameElem->pPageFrame->WritePageFrame( ) ;
+         pEntry->key            = EMPTY_PAGE_KEY ;
+         pEntry->pPageFrameElem = NULL ;
+      } /* if */
 
-         UnlinkColisionList( pPageFrameElem ) ;
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
 
-         SEG_SegmentRoot::GetRoot( )->GetSegment( pPageFrameElem->
-                   pPageFrame->GetIdSeg( ))->DecreaseNumOpenPages( ) ;
+      if ( pMap->vtInxFrame != NULL )
+      {
+         pMap->vtInxFrame[ idPag ] = -1 ;
+      } else
+      {
+         RemovePageTableEntry( pPageFrameElem ) ;
       } /* if */
 
-      pPageFrameElem->pPageFrame->SetFrameEmpty( ) ;
-      pPageFrameElem->frameType = FRAME_TYPE_FREE ;
+      pMap->numResident -- ;
 
-   } // End of function: VMR $Remove page from frame
+   } // End of function: VMR $Unregister page of a frame
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Compute hash index
-//    Computes the hash index of a virtual address.
-//    This index is used by the hash table that searches for pages
-//    already i memory.
+//  Method: VMR $Release direct page map
+//    Moves the pages of the segment in memory to the page table and
+//    deletes its direct page map.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
-   int VMC_VirtualMemoryRoot ::
-             ComputeInxHash( int idSeg , int idPag )
+   void VMC_VirtualMemoryRoot ::
+             ReleaseSegmentMap( int idSeg )
    {
 
+      VMC_SegmentPageMap * pMap = GetSegmentMap( idSeg ) ;
+
+      if ( pMap->vtInxFrame == NULL )
+      {
+         return ;
+      } /* if */
+
+      int * vtInxFrame = pMap->vtInxFrame ;
+      int   dimMap     = pMap->dimMap ;
 
-      return static_cast< int >
-                (( idSeg * 2083 + idPag ) % TAL_dimColision ) ;
+      pMap->vtInxFrame = NULL ;
+      pMap->dimMap     = 0 ;
 
-   } // End of function: VMR $Compute hash index
+      for ( int idPag = 0 ; idPag < dimMap ; idPag++ )
+      {
+         if ( vtInxFrame[ idPag ] >= 0 )
+         {
+            InsertPageTableEntry( vtPageFrameElem[ vtInxFrame[ idPag ]] ) ;
+         } /* if */
+      } /* for */
+
+      delete [ ] vtInxFrame ;
+
+   } // End of function: VMR $Release direct page map
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Link page frame into colision list
+//  Method: VMR $Insert page frame into page table
+//    The page must not be in the table.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             LinkColisionList( VMC_PageFrameElement * pPageFrameElem )
+             InsertPageTableEntry( VMC_PageFrameElement * pPageFrameElem )
    {
 
       int idSeg = pPageFrameElem->pPageFrame->GetIdSeg( ) ;
       int idPag = pPageFrameElem->pPageFrame->GetIdPag( ) ;
-      pPageFrameElem->inxHash = ComputeInxHash( idSeg , idPag ) ;
 
-      pPageFrameElem->nextColisionElem = vtColision[ pPageFrameElem->inxHash ] ;
-      pPageFrameElem->prevColisionElem = NULL ;
-      vtColision[ pPageFrameElem->inxHash ] = pPageFrameElem ;
+      int inxSlot = ComputeInxHash( idSeg , idPag ) ;
 
-      if ( pPageFrameElem->nextColisionElem != NULL )
+      while ( vtPageTableSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
       {
-         pPageFrameElem->nextColisionElem->prevColisionElem = pPageFrameElem ;
-      } /* if */
+         inxSlot = ( inxSlot + 1 ) & ( numPageTableSlots - 1 ) ;
+      } /* while */
+
+      vtPageTableSlot[ inxSlot ].key             = ComputePageKey( idSeg , idPag ) ;
+      vtPageTableSlot[ inxSlot ].inxFrameElement = pPageFrameElem->inxFrameElement ;
+
+      pPageFrameElem->inxHash = inxSlot ;
+      numPageTableEntries ++ ;
 
-   } // End of function: VMR $Link page frame into colision list
+   } // End of function: VMR $Insert page frame into page table
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR $Unlink page frame from colision list
+//  Method: VMR $Remove page frame from page table
+//    Entries following the freed slot are shifted back whenever their
+//    home slot permits, hence no deleted slot markers are needed and
+//    searches stop at the first empty slot.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    void VMC_VirtualMemoryRoot ::
-             UnlinkColisionList( VMC_PageFrameElement * pPageFrameElem )
+             RemovePageTableEntry( VMC_PageFrameElement * pPageFrameElem )
    {
 
+      if ( pPageFrameElem->inxHash < 0 )
+      {
+         return ;
+      } /* if */
+
+      int mask    = numPageTableSlots - 1 ;
+      int inxHole = pPageFrameElem->inxHash ;
 
-      if ( pPageFrameElem->inxHash >= 0 )
+      vtPageTableSlot[ inxHole ].key             = EMPTY_PAGE_KEY ;
+      vtPageTableSlot[ inxHole ].inxFrameElement = -1 ;
+
+      int inxSlot = ( inxHole + 1 ) & mask ;
+
+      while ( vtPageTableSlot[ inxSlot ].key != EMPTY_PAGE_KEY )
       {
+         unsigned long long key = vtPageTableSlot[ inxSlot ].key ;
+         int inxHome = ComputeInxHash( static_cast< int >( key >> 32 ) ,
+                                       static_cast< int >( key & 0xFFFFFFFFULL )) ;
 
-         if ( pPageFrameElem->nextColisionElem != NULL )
-         {
-            pPageFrameElem->nextColisionElem->prevColisionElem =
-                      pPageFrameElem->prevColisionElem ;
-         } /* if */
-         if ( pPageFrameElem->prevColisionElem != NULL )
+         if ( (( inxSlot - inxHome ) & mask ) >= (( inxSlot - inxHole ) & mask ))
          {
-            pPageFrameElem->prevColisionElem->nextColisionElem =
-                      pPageFrameElem->nextColisionElem ;
-         } else
-         {
-            vtColision[ pPageFrameElem->inxHash ] =
-                      pPageFrameElem->nextColisionElem ;
+            vtPageTableSlot[ inxHole ] = vtPageTableSlot[ inxSlot ] ;
+            vtPageFrameElem[ vtPageTableSlot[ inxHole ].inxFrameElement ]->
+                      inxHash = inxHole ;
+
+            vtPageTableSlot[ inxSlot ].key             = EMPTY_PAGE_KEY ;
+            vtPageTableSlot[ inxSlot ].inxFrameElement = -1 ;
+            inxHole = inxSlot ;
          } /* if */
 
-         pPageFrameElem->nextColisionElem = NULL ;
-         pPageFrameElem->prevColisionElem = NULL ;
-         pPageFrameElem->inxHash = -1 ;
+         inxSlot = ( inxSlot + 1 ) & mask ;
+      } /* while */
 
-      } // end selection: Root of VMR $Unlink page frame from colision list
+      pPageFrameElem->inxHash = -1 ;
+      numPageTableEntries -- ;
 
-   } // End of function: VMR $Unlink page frame from colision list
+   } // End of function: VMR $Remove page frame from page table
 
 ////////////////////////////////////////////////////////////////////////////
 // 
@@ -1947,6 +5781,7 @@
 
       if ( VerifyOpenPages( TAL_VerifyLog ) != 0 )
       {
+         std::lock_guard< std::mutex > ioLock( segmentIoMutex ) ;
          SEG_SegmentRoot::GetRoot( )->ResetOpenPages( ) ;
          return 1 ;
       } /* if */
@@ -33,7 +33,8 @@
 //       idSegment - identifies the segment containing the page
 //                   see module Segment for details.
 //       idPage    - identifies the page within the segment
-//                    all pages are of the same size: TAL_PageSize
+//                    all pages are of the same size, the page size of
+//                    the virtual memory root
 //       offset    - is the first byte (char) of the data within the page.
 //    
 //    The virtual memory control provides real memory access to virtual pages,
@@ -55,24 +56,84 @@
 //    
 //    See module Segment for more details.
 //    
+//    The page size is chosen when the root is created. It is a multiple
+//    of TAL_PageSize, the size of the pages of segment files. A virtual
+//    page of the root is a run of consecutive segment pages, virtual page
+//    idPage holds segment pages idPage * n to idPage * n + n - 1, where
+//    n is the page size divided by TAL_PageSize. Large pages favour
+//    sequential access, small ones random access.
+//    
 //    To access the contents of a virtual page it must first be paged in
 //    into a page frame.
 //    Page frames reside in real memory and contain a copy of the virtual
 //    page value that is currently bound to it.
+//    
+//    Segments that are mostly read may be mapped with MapSegment. The
+//    frames of their pages then point into a private mapping of the
+//    segment file instead of holding a copy, pages are neither read nor
+//    copied. Pinning, replacement and dirty pages work as for copied
+//    pages. A changed page becomes a private copy of the process, it
+//    reaches the file only when it is written through the segment module,
+//    and the copy is dropped when the page leaves its frame.
+//    
+//    Segments whose pages are only cached by the frames may be set to
+//    direct I/O with SetDirectIo. Pages are then read and written with
+//    O_DIRECT, one transfer per virtual page, and do not occupy the
+//    kernel page cache. Frame buffers and write behind buffers are
+//    aligned for it. Transfers the file system refuses, appends, writes
+//    to read only segments and unaligned buffers go through the segment
+//    module, hence it alone grows segments and refuses writes. Both modes
+//    require segment page i at byte i * TAL_PageSize of the file, a
+//    segment whose first or last page read through the segment module
+//    differs from those file bytes is neither mapped nor set to direct
+//    I/O. The segment module does not count direct transfers, the direct
+//    I/O counters do.
+//    
+//    SetChecksumMode makes every page transfer compute the CRC32C of the
+//    page. The checksum of a page is recorded when it is written or first
+//    read, and a later read of a different value is a mismatch. A first
+//    read has nothing to be verified against, it is counted as unverified
+//    in the statistics: a page corrupted before it is accepted. Mismatches
+//    are counted, or in VMC_CHECKSUM_FAIL mode the page is read once more
+//    and an exception is thrown if it still differs. The checksums of a
+//    segment are saved when they are forgotten, as the segment is removed,
+//    checksums are turned off or the root is destroyed, in a checksum file
+//    named by the segment full name followed by ".crc". They are loaded
+//    when a page of the segment is first transferred, unless the segment
+//    file changed size or modification time since. The segment file
+//    format is unchanged.
+//    Pages of mapped segments are not verified, they are not transferred.
+//    
+//    OpenLog starts a redo log. Every SetPageData of a TAL_CHANGED level
+//    then appends the segment position and the bytes set to the log, and
+//    a dirty page is written to its segment only once the log is durable
+//    up to its last change. If a write to the log failed, writing such a
+//    page throws and the page stays dirty until a checkpoint writes it
+//    and empties the log. CommitLog makes the changes made so far
+//    durable without writing their pages, the log is synced once for all
+//    the records appended since the previous sync, and commits that do
+//    not wait share the next sync. When the log grows beyond its limit a
+//    commit checkpoints: the dirty pages are written and the log is
+//    emptied. Opening a log left by a session that did not close it
+//    first redoes its changes, the segments it names must be open.
+//    Changes made through the page value pointer are not logged. Before
+//    the log is emptied every segment written since the previous
+//    checkpoint is reopened by its full name and synced.
 //    Page frames identify the segment and page of the page value, as well as
 //    whether the page value has been changed and not yet written (dirty),
 //    and whether it is pinned, i.e. may not be used when replacing pages.
 //    
-//    All page frames are members of a LRU (least recently used) list.
-//    The head of this list is kept in the virtual memory root.
+//    All page frames are ordered by a replacement policy object owned by
+//    the virtual memory root.
+//    The default policy keeps a LRU (least recently used) list.
 //    The list is ordered in order of recently used.
 //    Most recently accessed page frames are at the beginning of the list,
-//    empty frames and old page frames are at the tail of the list.
+//    old page frames are at the tail of the list.
 //    Page frames are moved within the list when they are accessed
 //    by the VMC_GetPageFrame( idSeg, idPag ) function.
 //    
 //    When accessing the content of page values bound to some page frame
-//    directly by a pointer they are not moved within the LRU list.
+//    directly by a pointer the policy is not informed of the access.
 //    This may lead frames bound to pointed to pages being slowly moved
 //    towards the end of the LRU list.
 //    To prevent such pages to be removed, they should be pinned, i.e.
@@ -83,15 +144,134 @@
 //    not following these rules may lead to "out of frame exceptions",
 //    which are not recoverable.
 //    
+//    Empty page frames are kept in a free list by the virtual memory root.
 //    When a page is required first empty frames will be selected.
 //    If none exists, the oldest non pinned page will be replaced by the
 //    requested one.
+//    In VMC_EVICT_CLEAN_FIRST mode the few frames closest to eviction are
+//    inspected and the first clean one is chosen. Dirty frames met on the
+//    way are copied to a write behind queue and become clean, a background
+//    thread writes them to their segments. Pages in the queue are read
+//    from the queue, never from the segment. Thus a miss costs at most one
+//    page read.
+//    WriteAllPageFrames and RemoveSegment wait for the queue to be empty.
+//    
+//    Optionally a tail cleaner thread keeps the frames closest to eviction
+//    clean. It inspects the last replacement candidates and, whenever less
+//    than a low watermark of them are clean, writes dirty ones with
+//    WritePageFrame until a high watermark of them are clean. Thus misses
+//    seldom have to write. While the cleaner runs, the root and frame
+//    operations of this module are serialized by a module lock, which is
+//    released while the cleaner writes.
+//    
+//    Optionally a dirty flusher thread bounds the number of dirty frames.
+//    When more than a high watermark percentage of the frames are dirty it
+//    writes the frames that became dirty longest ago, at most a given
+//    number of pages per second, until no more than a low watermark
+//    percentage are dirty. Thus changes reach the segments steadily
+//    instead of piling up until the next WriteAllPageFrames. The flusher
+//    shares the module lock with the tail cleaner.
+//    
+//    The policy is informed when a frame receives its first pin and when
+//    it loses its last one. The built in policies take pinned frames out
+//    of their replacement candidates, hence the victim is found in
+//    constant time, and a pool where all frames are pinned is detected
+//    without inspecting the frames.
+//    
+//    The replacement policy is chosen when the root is created, either
+//    by naming a built in policy or by passing a VMC_ReplacementPolicy
+//    object.
+//    VMC_REPLACE_LRU moves a frame to the head of the LRU list on every
+//    access, VMC_REPLACE_CLOCK only sets the reference bit of the frame.
+//    In the latter mode the victim is found by sweeping a clock hand over
+//    the ring of non pinned frames, giving referenced frames a second chance.
+//    
+//    VMC_REPLACE_2Q resists sequential scans of large segments.
+//    Pages read for the first time enter the A1in FIFO queue, hits
+//    within this queue do not move them.
+//    When A1in exceeds a quarter of the frames its oldest page is evicted
+//    and its address is remembered in the A1out ghost queue.
+//    Only pages referenced again while in the ghost queue are admitted to
+//    the LRU list, which thus keeps the frequently reused pages.
+//    
+//    Page frames in use, i.e. those that contain a page, are registered
+//    in the page table, which finds the page frame containing the page
+//    corresponding to a given virtual page address.
+//    The page table is an open addressing hash table with linear probing.
+//    Each slot holds the virtual address, packed in 64 bits, and the
+//    index of the frame, hence a search usually touches a single cache
+//    line. The table is sized when the root is created so that at most
+//    half of its slots are used.
+//    Pages of segments that are not too large relative to the number of
+//    frames are registered instead in a direct page map of the segment,
+//    a vector of frame indexes indexed by the page id. The map is created
+//    when the first page of the segment is brought into memory, grows with
+//    the segment, and is returned to the page table if the segment
+//    becomes too large.
+//    In front of both a small direct mapped lookaside remembers the frames
+//    of the most recently found pages, hence repeated accesses to a few
+//    hot pages cost a couple of compares.
+//    
+//    The page values of all frames are kept in a single frame arena,
+//    mapped when the root is created. Page values are contiguous and
+//    aligned to 4 KiB, hence they may be transferred by direct I/O.
+//    The arena may be backed by transparent or explicit 2 MiB huge
+//    pages, reducing TLB misses when scanning large pools. Frame objects
+//    are allocated from a separate vector, thus frame metadata is not
+//    interleaved with page values.
+//    The segment id, page id, number of pins, change level and type of
+//    every frame are kept in dense vectors indexed by the frame index.
+//    Operations that scan the whole pool, e.g. counting pinned frames,
+//    read these vectors and touch only the frames they must act upon.
+//    Dirty frames are also kept in a set indexed by frame, updated when
+//    the change level of a frame changes, hence writing all dirty frames
+//    costs in proportion to the number of dirty frames, not of frames.
+//    
+//    The pool of frames is elastic. The root starts with minFrames frames
+//    and adds frames, up to maxFrames, when a miss would evict a hot page,
+//    i.e. when the missing page has been evicted a short while ago, or
+//    when all frames are pinned. The addresses of recently evicted pages
+//    are kept in a small history for this purpose. ReleaseFrames returns
+//    the memory of clean not pinned frames to the system, such frames are
+//    reused first when the pool grows again.
+//    
+//    Pages may be paged in asynchronously. StartPageInThreads starts a
+//    pool of reader threads. GetPageFrameAsync then reserves a frame for
+//    a missing page, registers the page and queues its read, without
+//    waiting for it. WaitPageFrame, or any access to the page, waits for
+//    the read to complete. Hence the caller may issue several independent
+//    misses and work while they are read. The frame is pinned while it is
+//    read. When no other frame may be evicted the reads in flight are
+//    finished, and their frames become candidates again.
+//    
+//    SetReadAhead turns on read ahead. GetPageFrame then follows the
+//    pages accessed in each segment. When consecutive accesses are a
+//    constant number of pages apart, sequential or strided, the next pages
+//    at that stride are read ahead, queued to the reader threads if they
+//    run. Pages read ahead go to free frames or replace clean, not pinned
+//    candidates, and the policy receives them at its cold end, thus they
+//    do not displace hot pages. The window of a segment grows by a page
+//    whenever a page read ahead is accessed and halves whenever one is
+//    evicted before being accessed. Mapped segments are not read ahead,
+//    the kernel reads ahead within the mapping.
+//    
+//    SetCompressedTier adds a compressed tier behind the frames. Clean
+//    pages evicted from their frames are compressed into a bounded
+//    arena, and a miss looks for the page there before reading it from
+//    its segment. Pages compressing well, about 3:1, let the same memory
+//    hold several times more of the working set. A page found in the
+//    tier leaves it, hence a page is never both in a frame and in the
+//    tier. When the arena is full the pages stored first are dropped.
 //    
-//    Page frames in use, i.e. those that contain a page, are kept in a
-//    colision lists.
-//    These lists are used by a search table to find the page frame
-//    containing the page corresponding to a given virtual page address.
-//    The heads of the colision lists are kept in a hash table.
+//    Two build options trade checking for speed.
+//    VMC_RELEASE leaves emptied frames as they are, instead of filling
+//    them with undefined chars, and drops the patterns that control
+//    overruns of each page value, together with the gap they need
+//    between the buffers. New pages are still filled.
+//    VMC_HARDENED also protects the guard pages around the arena, hence
+//    an overrun of the arena traps at once at no cost for the accesses.
+//    Explicit huge pages cannot be protected piecewise, their arena is
+//    not guarded.
 //    
 //    Whenever the contents of a page value are changed, the page frame
 //    must be marked dirty.
@@ -108,7 +288,9 @@
 // Public methods of class VMC_PageFrame
 // 
 //    VMC_PageFrame( int inxPageFrameElemParm ,
-//                   VMC_PageFrameElement * pFrameElementParm )
+//                   VMC_PageFrameElement * pFrameElementParm ,
+//                   char * pPageValueParm ,
+//                   VMC_FrameMetadata * pMetadataParm )
 // 
 //    ~VMC_PageFrame( )
 // 
@@ -125,6 +307,12 @@
 //    void ReadPageFrame( int idSeg ,
 //                        int idPag  )
 // 
+//    void MapPageFrame( int idSeg ,
+//                       int idPag ,
+//                       char * pMappedValue )
+// 
+//    bool IsPageMapped( )
+// 
 //    void WritePageFrame( )
 // 
 //    void PinFrame( )
@@ -162,16 +350,64 @@
 // 
 //    int GetNumPins( )
 // 
+//    TAL_tpChangeLevel DetachPageValue( char * pBuffer )
+// 
 //    TAL_tpChangeLevel GetDirtyFlag( )
 // 
+//    long long GetPageLsn( )
+// 
 //    STR_String * GetSegmentFileName( )
 // 
 //    STR_String * GetSegmentFullName( )
 // 
+// Public methods of class VMC_ReplacementPolicy
+// 
+//    VMC_ReplacementPolicy( )
+// 
+//    ~VMC_ReplacementPolicy( )
+// 
+//    VMC_ReplacementPolicy * CreatePolicy( VMC_tpReplacementPolicy policy )
+// 
+//    void StartPolicy( int numFrames )
+// 
+//    void AddFrame( VMC_PageFrame * pPageFrame )
+// 
+//    void OnAccess( VMC_PageFrame * pPageFrame )
+// 
+//    void OnInsert( VMC_PageFrame * pPageFrame )
+// 
+//    void OnPrefetch( VMC_PageFrame * pPageFrame )
+// 
+//    void OnRemove( VMC_PageFrame * pPageFrame )
+// 
+//    void OnPin( VMC_PageFrame * pPageFrame )
+// 
+//    void OnUnpin( VMC_PageFrame * pPageFrame )
+// 
+//    VMC_PageFrame * ChooseVictim( )
+// 
+//    int GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+//                             int maxCandidates )
+// 
+//    void ForgetSegment( int idSeg )
+// 
+//    int VerifyPolicy( TAL_tpVerifyMode verifyMode )
+// 
+//    void DisplayStatistics( LOG_Logger * pLogger )
+// 
 // Public methods of class VMC_VirtualMemoryRoot
 // 
 //    void CreateRoot( int minFrames ,
-//                     int maxFrames  )
+//                     int maxFrames ,
+//                     VMC_tpReplacementPolicy policy = VMC_REPLACE_LRU ,
+//                     VMC_tpArenaPages arenaPages = VMC_ARENA_BASE_PAGES ,
+//                     int pageSize = TAL_PageSize )
+// 
+//    void CreateRoot( int minFrames ,
+//                     int maxFrames ,
+//                     VMC_ReplacementPolicy * pPolicy ,
+//                     VMC_tpArenaPages arenaPages = VMC_ARENA_BASE_PAGES ,
+//                     int pageSize = TAL_PageSize )
 // 
 //    void DestroyRoot( )
 // 
@@ -190,22 +426,107 @@
 // 
 //    void DisplayPinnedFrameList( )
 // 
-//    void WriteAllPageFrames( )
+//    void WriteAllPageFrames( bool isSync = false )
+// 
+//    void SetEvictionMode( VMC_tpEvictionMode mode )
+// 
+//    void SetDirectPageMaps( bool isOn )
+// 
+//    void SetReadAhead( int maxPages )
+// 
+//    void SetCompressedTier( int sizeKiB )
+// 
+//    void GetCompressedTierCounters( int * pNumHits    ,
+//                                    int * pNumMisses  ,
+//                                    int * pNumStored  ,
+//                                    int * pNumDropped  )
+// 
+//    VMC_tpEvictionMode GetEvictionMode( )
+// 
+//    int ReleaseFrames( int numFrames )
+// 
+//    void StartTailCleaner( int numScanFrames ,
+//                           int lowWatermark  ,
+//                           int highWatermark  )
+// 
+//    void StopTailCleaner( )
+// 
+//    int CleanTailFrames( int numScanFrames ,
+//                         int lowWatermark  ,
+//                         int highWatermark ,
+//                         int * pNumFailures )
+// 
+//    void GetCleanerCounters( int * pNumScans     ,
+//                             int * pNumCleanings ,
+//                             int * pNumWrites    ,
+//                             int * pNumFailures   )
+// 
+//    void StartDirtyFlusher( int highWatermark ,
+//                            int lowWatermark  ,
+//                            int maxPagesPerSecond )
+// 
+//    void StopDirtyFlusher( )
+// 
+//    int FlushDirtyFrames( int highWatermark ,
+//                          int lowWatermark  ,
+//                          int maxPages      ,
+//                          bool * pIsFlushing ,
+//                          int * pNumFailures )
+// 
+//    void GetFlusherCounters( int * pNumPasses   ,
+//                             int * pNumFlushes  ,
+//                             int * pNumWrites   ,
+//                             int * pNumFailures  )
+// 
+//    int GetNumDirtyFrames( )
 // 
 //    void RemoveSegment( int idSeg )
 // 
+//    bool MapSegment( int idSeg )
+// 
+//    bool SetDirectIo( int idSeg ,
+//                      bool isOn  )
+// 
+//    void SetChecksumMode( VMC_tpChecksumMode mode )
+// 
+//    int OpenLog( const char * logFileName ,
+//                 int checkpointKiB          )
+// 
+//    bool CommitLog( bool isWait = true )
+// 
+//    bool CheckpointLog( )
+// 
+//    void CloseLog( )
+// 
+//    void GetLogCounters( int * pNumRecords     ,
+//                         int * pNumCommits     ,
+//                         int * pNumSyncs       ,
+//                         int * pNumCheckpoints  )
+// 
 //    VMC_PageFrame * AddNewPage( int idSeg )
 // 
-//    VMC_PageFrameElement * GetLruListHead( )
+//    VMC_PageFrameElement * GetFirstFrameElement( )
 // 
-//    VMC_PageFrameElement * GetNextLruListElement( VMC_PageFrameElement * currentElem )
+//    VMC_PageFrameElement * GetNextFrameElement( VMC_PageFrameElement * currentElem )
 // 
 //    VMC_PageFrame * GetPageFrame( int  idSeg ,
 //                                  int  idPag ,
 //                                  bool inMemory = false )
 // 
+//    void GetPageFrameAsync( int idSeg ,
+//                            int idPag  )
+// 
+//    VMC_PageFrame * WaitPageFrame( int idSeg ,
+//                                   int idPag  )
+// 
+//    void StartPageInThreads( int numThreads )
+// 
+//    void StopPageInThreads( )
+// 
 //    int GetNumPageFrames( )
 // 
+//    int GetPageSize( )
+// 
 //    int GetTotalAccesses( )
 // 
 //    int GetTotalReplaces( )
@@ -216,6 +537,18 @@
 // 
 //    VMC_PageFrame * GetPageFrame( VMC_PageFrameElement * currentElem )
 // 
+//    VMC_ReplacementPolicy * GetReplacementPolicy( )
+// 
+//    std::recursive_mutex * GetModuleLock( )
+// 
+//    VMC_SegmentPageRun * GetSegmentPageRun( )
+// 
+//    VMC_RedoLog * GetRedoLog( )
+// 
+//    VMC_FrameArena * GetFrameArena( )
+// 
+//    TAL_tpOpeningMode GetOpeningMode( int idSeg )
+// 
 // 
 // -------------------------------------------------------------------------
 // Protected methods of class VMC_PageFrame
@@ -224,7 +557,10 @@
 // Protected methods of class VMC_VirtualMemoryRoot
 // 
 //    VMC_VirtualMemoryRoot( int minFramesParm ,
-//                           int maxFramesParm  )
+//                           int maxFramesParm ,
+//                           VMC_ReplacementPolicy * pPolicyParm ,
+//                           VMC_tpArenaPages arenaPagesParm ,
+//                           int pageSizeParm )
 // 
 //    ~VMC_VirtualMemoryRoot( )
 // 
@@ -254,26 +590,17 @@
 //     1 - null root object pointer
 //     2 - incorrect root object pointer
 //     3 - segment control is not open
-//     4 - colision list refers to frame element that is not in use
-//     5 - colision list element contains incorrect hash index
-//     6 - colision list page frame contains negative segment id
-//     7 - colision list page frame contains negative page id
-//     8 - colision list element contains incorrect virtual address
-//     9 - colision list element contains incorrect forward pointer
-//    10 - colision list element contains incorrect backward pointer
+//     4 - page table slot refers to frame element that is not in use
+//         nor being read
+//     5 - page table slot index differs from the frame element hash index
+//     6 - page table frame contains negative segment id
+//     7 - page table frame contains negative page id
+//     8 - page table slot contains incorrect virtual address
+//     9 - page table entry cannot be reached from its home slot
+//    10 - incorrect number of page table entries
 //    11 - number of page frames less than minimum required
-//    12 - first LRU list element contains backward refernce
-//    13 - incorrect LRU list head
-//    14 - last LRU list element contains forward refernce
-//    15 - incorrect LRU list tail
-//    16 - incorrect next LRU list pointer
-//    17 - incorrect sucessor frame index
-//    18 - last LRU element is not LRU list tail
-//    19 - last LRU element index is not 0
-//    20 - incorrect backward LRU list pointer
-//    21 - incorrect predecessor frame index
-//    22 - first LRU element is not LRU list head
-//    23 - first LRU element index is not last frame element index
+//    12 .. 23 - not used, were the checks of the LRU list now kept by
+//         the replacement policy, see VMP !Verify replacement policy
 //    24 - page frame element in use contains negative hash index
 //    25 - page frame element in use contains too large hash index
 //    26 - page frame element in use contains incorrect hash index
@@ -285,6 +612,34 @@
 //    32 - page frame object is incorrect
 //    33 - incorrect number of open pages upon entry
 //    34 - incorrect number of open pages upon exit
+//    36 - frame vector does not refer to the page frame element
+//    37 - direct page map does not refer to the frame
+//    38 - incorrect number of pages in a direct page map
+//    41 - incorrect number of pinned frames
+//    42 - replacement policy structure is incorrect
+//    43 - free list element is not free
+//    44 - incorrect number of free list elements
+//    45 - released list element is not released
+//    46 - incorrect number of released frames
+//    47 - free page frame element is marked as read ahead
+//    48 - dirty frame set is incorrect
+//    49 - mapped page value is not the mapped page of the frame
+//    60 - compressed tier structure is incorrect
+//    61 - page in a frame is also in the compressed tier
+//
+// Method VMP !Verify replacement policy
+// 
+// Error log codes
+//    70 - incorrect list head
+//    71 - incorrect list tail
+//    72 - incorrect next list pointer
+//    73 - incorrect backward list pointer
+//    74 - list element is not registered in its list
+//    75 - incorrect number of list elements
+//    76 - policy refers to an incorrect page frame
+//    77 - frame is not in the list corresponding to its state
+//         e.g. a pinned frame is among the replacement candidates
+//    78 - not all frames are known to the policy
 //
 ////////////////////////////////////////////////////////////////////////////
 
@@ -293,6 +648,7 @@
 //==========================================================================
 
    #include <stdio.h>
+   #include <mutex>
    #include "talisman_constants.inc"
    #include "segment.hpp"
    #include "logger.hpp"
@@ -301,8 +657,128 @@
 //----- Exported declarations -----
 //==========================================================================
 
-   enum   VMC_tpFrameType  ;
    struct VMC_PageFrameElement ;
+   struct VMC_PageTableSlot ;
+   struct VMC_SegmentPageMap ;
+   struct VMC_LookasideEntry ;
+   struct VMC_DirtyFrame ;
+   class  VMC_FrameArena ;
+   struct VMC_FrameMetadata ;
+   class  VMC_WriteBehindQueue ;
+   class  VMC_TailCleaner ;
+   class  VMC_DirtyFlusher ;
+   class  VMC_PageInQueue ;
+   class  VMC_CompressedTier ;
+   class  VMC_SegmentPageRun ;
+   class  VMC_RedoLog ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Page replacement policies
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   enum VMC_tpReplacementPolicy
+   {
+
+   // VMR Least recently used
+   //    Every access moves the frame to the head of the LRU list.
+
+      VMC_REPLACE_LRU ,
+
+   // VMR Clock, second chance
+   //    An access only sets the reference bit of the frame.
+
+      VMC_REPLACE_CLOCK ,
+
+   // VMR 2Q, scan resistant
+   //    First accesses go to the A1in FIFO, re-references to the LRU list.
+
+      VMC_REPLACE_2Q
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Eviction modes
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   enum VMC_tpEvictionMode
+   {
+
+   // VMR Synchronous write
+   //    A dirty victim is written before its frame receives the new page.
+
+      VMC_EVICT_SYNCHRONOUS ,
+
+   // VMR Clean first
+   //    Clean frames near the tail of the replacement order are chosen
+   //    first. Dirty victims are copied to the write behind queue, which
+   //    is written by a background thread.
+
+      VMC_EVICT_CLEAN_FIRST
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Checksum modes
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   enum VMC_tpChecksumMode
+   {
+
+   // VMR No checksums
+   //    Pages are transferred unchecked, recorded checksums are dropped.
+
+      VMC_CHECKSUM_OFF ,
+
+   // VMR Count mismatches
+   //    A page read with a checksum differing from the recorded one is
+   //    counted, and its new checksum recorded.
+
+      VMC_CHECKSUM_COUNT ,
+
+   // VMR Fail on mismatch
+   //    A page read with a differing checksum is read once more. If it
+   //    still differs the read throws.
+
+      VMC_CHECKSUM_FAIL
+
+   }  ;
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Data type: VMR Frame arena pages
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   enum VMC_tpArenaPages
+   {
+
+   // VMR Base pages of the system
+
+      VMC_ARENA_BASE_PAGES ,
+
+   // VMR Transparent huge pages
+   //    The arena is aligned to 2 MiB and the kernel is advised to back it
+   //    by huge pages. Base pages are used if the advice is refused.
+
+      VMC_ARENA_TRANSPARENT_HUGE_PAGES ,
+
+   // VMR Explicit huge pages
+   //    The arena is mapped from the huge page pool of the system.
+   //    Transparent huge pages are used if the pool is too small.
+
+      VMC_ARENA_HUGE_PAGES
+
+   }  ;
 
 
 //==========================================================================
@@ -347,11 +823,19 @@ class VMC_PageFrame
 // Description
 //    Should only be used by the virtual memory components.
 // 
+// Parameters
+//    $P pPageValueParm - page value buffer of the frame, page size bytes
+//                        within the frame arena
+//    $P pMetadataParm  - metadata vectors of the root, the state of the
+//                        frame is kept in their element inxPageFrameElemParm
+// 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
       VMC_PageFrame( int inxPageFrameElemParm ,
-                     VMC_PageFrameElement * pFrameElementParm )  ;
+                     VMC_PageFrameElement * pFrameElementParm ,
+                     char * pPageValueParm ,
+                     VMC_FrameMetadata * pMetadataParm )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
@@ -431,6 +915,35 @@ class VMC_PageFrame
       void ReadPageFrame( int idSeg ,
                           int idPag  )  ;
 
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMF !Map page value into frame
+// 
+// Description
+//    Should only be used by the virtual memory components.
+//    Binds the page to the frame with the page value at pMappedValue,
+//    within the mapping of its segment file. Nothing is read.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void MapPageFrame( int idSeg ,
+                         int idPag ,
+                         char * pMappedValue )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMF !Is page value mapped
+// 
+// Return value
+//    true  if the page value is within the mapping of the segment file
+//    false if the page value is the buffer of the frame
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool IsPageMapped( )  ;
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 //  Method: VMF !Write page value contained in frame
@@ -439,6 +952,9 @@ class VMC_PageFrame
 //    Writes the page contained in the page frame.
 //    The page will be written only if it is dirty.
 //    The page to be written must be one already existing in the segment.
+//    The frame is marked not dirty before the write starts, hence changes
+//    made while it is written by the tail cleaner are not lost. If the
+//    write fails the change level is restored.
 // 
 // Returned exceptions
 //    EXC_Error - may occur when attempting to write on a read only file,
@@ -461,6 +977,8 @@ class VMC_PageFrame
 //    
 //    Page values in a pinned page frame cannot be removed when searching
 //    for page frame to recieve a replacement page.
+//    The first pin and the removal of the last pin are reported to the
+//    replacement policy, which then stops or resumes considering the frame.
 //    
 //    Virtual memory does not assure that pages remain at the same
 //    physical memory location over some period of time.
@@ -477,8 +995,8 @@ class VMC_PageFrame
 //    If pins are used in int transactions, crashes may occur due to
 //    unavailable page frames for page replacements.
 //    
-//    numPinnedFrames keeps a statistic of the maximum number of
-//    simultaneously pinned frames during a virtual memory usage session.
+//    The root counts the pinned frames, and keeps a statistic of the
+//    maximum number of simultaneously pinned frames since it was created.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -517,6 +1035,8 @@ class VMC_PageFrame
 // 
 // Description
 //    Should only be used by the virtual memory components.
+//    The page value is filled with undefined chars unless the module is
+//    built with VMC_RELEASE.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -565,8 +1085,9 @@ class VMC_PageFrame
 //  Method: VMF !Set frame dirty
 // 
 // Description
-//    Inserts the frame in the list of pages to be written.
-//    Only pages belonging to dirty frames list are written to a file.
+//    Inserts the frame in the dirty frame set when it first becomes
+//    dirty, the frame leaves the set when its page is written.
+//    Only pages belonging to the dirty frame set are written to a file.
 //    Workspaces are not set to dirty.
 // 
 // Parameters
@@ -663,6 +1184,27 @@ class VMC_PageFrame
    public:
       int GetNumPins( )  ;
 
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMF !Detach page value
+// 
+// Description
+//    If the frame is dirty copies the page value to a buffer and marks the
+//    frame not dirty. The buffer must then be written to the segment.
+//    Should only be used by the virtual memory components.
+// 
+// Parameters
+//    $P pBuffer - receives page size bytes
+// 
+// Return value
+//    The change level of the frame before the operation.
+//    If it is TAL_NOT_CHANGED nothing has been copied.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      TAL_tpChangeLevel DetachPageValue( char * pBuffer )  ;
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 //  Method: VMF !Get dirty flag
@@ -672,6 +1214,20 @@ class VMC_PageFrame
    public:
       TAL_tpChangeLevel GetDirtyFlag( )  ;
 
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMF !Get page log sequence number
+// 
+// Description
+//    Returns the position in the redo log of the last change logged for
+//    the page of the frame, 0 if none.
+//    Should only be used by the virtual memory components.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      long long GetPageLsn( )  ;
+
 ////////////////////////////////////////////////////////////////////////////
 // 
 //  Method: VMF !Get segment file name
@@ -703,32 +1259,29 @@ class VMC_PageFrame
    private: 
       VMC_PageFrameElement * pFrameElement ;
 
-// VMF Page value underflow control
-//    protctionBefore and protectionAfter control possible buffer overrun
-//    that might occur when transferring data to a page.
-//    The control has a very slight chance of not working, depending
-//    on the data that is transferred into the page.
-
-   private: 
-      static const int PROTECTION_SIZE = 4 ;
-      char protectionBefore[ PROTECTION_SIZE ] ;
-
 // VMF Page value copy of the virtual page
 //    This space contains the value of the virtual page.
 //    Its value might different from the one in the corresponding segment,
 //    up to the moment the page is written out to the segment.
 //    To assure that it will be written, page frames must be marked dirty
 //    whenever the page contents is changed.
+//    The space belongs to the frame arena of the root, the arena controls
+//    buffer overruns at its borders.
 
    private: 
-      char pageValue[ TAL_PageSize ] ;
+      char * pageValue ;
 
-// VMF Page value overflow control
+// VMF Page value buffer of the frame
+//    pageValue points to this buffer of the frame arena, unless the page
+//    is mapped. An empty frame always uses its buffer.
 
    private: 
-      char protectionAfter[ PROTECTION_SIZE ] ;
+      char * bufferValue ;
 
 // VMF Segment identifier
+//    The state items below are elements of the frame metadata vectors
+//    of the root.
+//    
 //    This identifier is generated by the segment module.
 //    Its value is ephemeral in the sense that different usage sessions
 //    may yield different identifiers for a same segment file.
@@ -736,7 +1289,7 @@ class VMC_PageFrame
 //    If the page frame is empty the identifier should be NULL_SEGMENT
 
    private: 
-      int idSegment ;
+      int & idSegment ;
 
 // VMF Page identifier
 //    This identifier is the index of the page within the segment file.
@@ -744,12 +1297,19 @@ class VMC_PageFrame
 //    If the page frame is empty the identifier should be NULL_PAGE
 
    private: 
-      int idPage ;
+      int & idPage ;
 
 // VMF Change level
 
    private: 
-      TAL_tpChangeLevel changeLevel ;
+      TAL_tpChangeLevel & changeLevel ;
+
+// VMF Frame metadata
+//    Metadata vectors of the root, changes of the change level are
+//    made through them to keep the dirty frame set current.
+
+   private: 
+      VMC_FrameMetadata * pMetadata ;
 
 // VMF Number of pins
 //    Whenever a page frame is pinned, this counter is increased.
@@ -761,7 +1321,7 @@ class VMC_PageFrame
 //    active.
 
    private: 
-      int numPins ;
+      int & numPins ;
 
 } ; // End of class declaration: VMF  Page frame
 
@@ -773,309 +1333,1243 @@ class VMC_PageFrame
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Class: VMR  Virtual memory root singleton
+//  Class: VMP  Page replacement policy
 // 
 // Description
-//    The virtual memory root singleton is responsible for all
-//    page frame access operations.
+//    A replacement policy decides which page frame receives a page that
+//    is not in memory.
+//    The virtual memory root informs the policy of every event that may
+//    change this decision, and asks it for a free frame or for a victim.
 //    
-//    The root class contains the roots to the lists of page frames.
+//    Frames are identified by their page frame element index,
+//    0 <= GetInxPageFrameElem( ) < numFrames, hence policies may keep
+//    their own data in vectors indexed by it.
+//    A frame is empty if its segment id is negative.
+//    
+//    The policy object is owned by the virtual memory root and is
+//    destroyed together with it.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
-class VMC_VirtualMemoryRoot
+class VMC_ReplacementPolicy
 {
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !:Virtual memory root create
-// 
-// Description
-//    This function creates the singleton.
-// 
-// Parameters
-//    $P minFrames - is the minimum number of frames that must be allocated.
-//    $P maxFrames - is the maximum number of frames that may  be allocated.
-// 
-// Returned exceptions
-//    Assertion - if the singleton exists
+//  Method: VMP !Replacement policy constructor
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      static void CreateRoot( int minFrames ,
-                              int maxFrames  )  ;
+      VMC_ReplacementPolicy( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !:Virtual memory root delete
+//  Virtual Method: VMP !Replacement policy destructor
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      static void DestroyRoot( )  ;
+      virtual ~VMC_ReplacementPolicy( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Inline Method: VMR !:Get virtual memory root
-// 
-// Returned exceptions
-//    Assert - if the singleton has not been created
+//  Method: VMP !:Create built in replacement policy
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      static inline VMC_VirtualMemoryRoot * VMC_VirtualMemoryRoot :: GetRoot( )
-      {
-
-         return pVirtualMemoryRoot ;
-
-      } // End : Root of VMR !:Get virtual memory root
+      static VMC_ReplacementPolicy * CreatePolicy( VMC_tpReplacementPolicy policy )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Is page in memory
+//  Virtual Method: VMP !Start policy
 // 
 // Description
-//    Returns true if the page is already in memory, or if there is
-//    an empty frame that could receive the virtual memory
+//    Called once, before any frame is added.
+//    numFrames is the maximum number of frames, frames are added later
+//    in increasing index order, also while the pool grows.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      bool IsPageInMemory( int idSeg ,
-                           int idPag  )  ;
+      virtual void StartPolicy( int numFrames ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Verify virtual memory root object
+//  Virtual Method: VMP !Add empty frame
 // 
 // Description
-//    Verifies all frames that are registered in the LRU list.
-// 
-// Parameters
-//    $P ModeParm - TAL_VerifyLog   - generates a log of all errors found
-//                  TAL_VerifyNoLog - returns upon finding the first error
-// 
-// Return value
-//    true  - if the virtual memory structure is correct
-//    false - if it is corrupted
+//    Called once for each frame allocated by the virtual memory root,
+//    when the root is created and whenever the pool grows.
+//    Frames are empty when added. Empty frames are kept in the free list
+//    of the root, the policy only orders frames that contain a page.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int VerifyVirtualMemory( TAL_tpVerifyMode verifyMode )  ;
+      virtual void AddFrame( VMC_PageFrame * pPageFrame ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Verify number of open pages
+//  Virtual Method: VMP !On access
 // 
 // Description
-//    Counts open pages of a given segment paged in to the LRU list
+//    The page contained in the frame has been accessed by GetPageFrame.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int CountOpenPages( int idSeg )  ;
+      virtual void OnAccess( VMC_PageFrame * pPageFrame ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Verify all open pages
+//  Virtual Method: VMP !On insert
+// 
+// Description
+//    A page has been placed into the frame, the frame is no longer empty.
+//    From now on the frame is a replacement candidate.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int VerifyOpenPages( TAL_tpVerifyMode verifyMode )  ;
+      virtual void OnInsert( VMC_PageFrame * pPageFrame ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Display virtual memory usage statistics
+//  Virtual Method: VMP !On prefetch
+// 
+// Description
+//    A page read ahead has been placed into the frame, as with OnInsert,
+//    or such a page has been read by a reader thread and lost its pin.
+//    The page has not been accessed yet, policies should place it where
+//    it is replaced before the pages that have been accessed.
+//    The default calls OnInsert.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      void DisplayStatistics( )  ;
+      virtual void OnPrefetch( VMC_PageFrame * pPageFrame )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Display list of pinned frames
+//  Virtual Method: VMP !On remove
+// 
+// Description
+//    The page is being removed from the frame, the frame still holds its
+//    virtual address. Afterwards the frame is empty and returns to the
+//    free list of the root, it must no longer be chosen as a victim.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      void DisplayPinnedFrameList( )  ;
+      virtual void OnRemove( VMC_PageFrame * pPageFrame ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Write all dirty frames
+//  Virtual Method: VMP !On pin
 // 
 // Description
-//    Writes all dirty pages to their corresponding virtual page.
-//    After writing all pages are not dirty.
+//    The frame has received its first pin.
+//    Policies may take the frame out of their replacement candidates.
+//    The default does nothing, ChooseVictim must then skip pinned frames.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      void WriteAllPageFrames( )  ;
+      virtual void OnPin( VMC_PageFrame * pPageFrame )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Remove all pages of a given segment
+//  Virtual Method: VMP !On unpin
 // 
 // Description
-//    Removes all pages that belong to a given segment.
-//    This method should be used before deleting a segment.
+//    The frame has lost its last pin and may be replaced again.
+//    Not called when the pins vanish because the page is removed from
+//    the frame, OnRemove is called instead.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      void RemoveSegment( int idSeg )  ;
+      virtual void OnUnpin( VMC_PageFrame * pPageFrame )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Add new page value to end of segment file
+//  Virtual Method: VMP !Choose victim
 // 
 // Description
-//    This function gets a frame containing a new empty page added to the end
-//    of the segment file.
+//    Chooses the page to be removed when the free list of the root is
+//    empty. Pinned frames must never be chosen.
+// 
+// Return value
+//    The chosen frame, NULL if all frames are pinned.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      VMC_PageFrame * AddNewPage( int idSeg )  ;
+      virtual VMC_PageFrame * ChooseVictim( ) = 0 ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get LRU list head
+//  Virtual Method: VMP !Get victim candidates
 // 
 // Description
-//    Should only be used by the virtual memory components.
+//    Lists the frames that would be chosen as victims, in the order they
+//    would be chosen, without changing the policy state.
+//    Used by the clean first eviction mode and by read ahead.
+//    The default lists none, the root then relies on ChooseVictim only,
+//    and reads ahead into free frames only.
+// 
+// Parameters
+//    $P vtCandidate   - receives the candidate frames
+//    $P maxCandidates - dimension of vtCandidate
+// 
+// Return value
+//    Number of candidates stored in vtCandidate
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      virtual int GetVictimCandidates( VMC_PageFrame ** vtCandidate ,
+                                       int maxCandidates )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Virtual Method: VMP !Forget segment
+// 
+// Description
+//    All pages of the segment have been removed and its id may be reused.
+//    Policies that remember evicted pages must forget those of the segment.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      virtual void ForgetSegment( int idSeg )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Virtual Method: VMP !Verify replacement policy
+// 
+// Return value
+//    Number of errors found, 0 if the policy structure is correct
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      virtual int VerifyPolicy( TAL_tpVerifyMode verifyMode )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Virtual Method: VMP !Display policy statistics
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      virtual void DisplayStatistics( LOG_Logger * pLogger )  ;
+
+} ; // End of class declaration: VMP  Page replacement policy
+
+
+//==========================================================================
+//----- Class declaration -----
+//==========================================================================
+
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Class: VMR  Virtual memory root singleton
+// 
+// Description
+//    The virtual memory root singleton is responsible for all
+//    page frame access operations.
+//    
+//    The root class contains the roots to the lists of page frames.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+class VMC_VirtualMemoryRoot
+{
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !:Virtual memory root create
+// 
+// Description
+//    This function creates the singleton.
+// 
+// Parameters
+//    $P minFrames  - is the minimum number of frames that must be allocated.
+//                    The pool starts with this many frames, at least 5.
+//    $P maxFrames  - is the maximum number of frames that may  be allocated.
+//                    The frame arena is reserved for maxFrames frames, if
+//                    this fails it is reserved for minFrames frames.
+//                    Memory is used only by frames actually allocated.
+//    $P policy     - is the page replacement policy to be used.
+//    $P arenaPages - is the kind of pages backing the frame arena.
+//    $P pageSize   - is the size of the virtual pages. It is rounded up to
+//                    a multiple of TAL_PageSize, it is at most 64 times
+//                    TAL_PageSize.
+// 
+// Returned exceptions
+//    Assertion - if the singleton exists
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      static void CreateRoot( int minFrames ,
+                              int maxFrames ,
+                              VMC_tpReplacementPolicy policy = VMC_REPLACE_LRU ,
+                              VMC_tpArenaPages arenaPages = VMC_ARENA_BASE_PAGES ,
+                              int pageSize = TAL_PageSize )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !:Virtual memory root create with a given policy object
+// 
+// Parameters
+//    $P pPolicy   - the replacement policy object, the root becomes its
+//                   owner. If NULL the LRU policy is used.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      static void CreateRoot( int minFrames ,
+                              int maxFrames ,
+                              VMC_ReplacementPolicy * pPolicy ,
+                              VMC_tpArenaPages arenaPages = VMC_ARENA_BASE_PAGES ,
+                              int pageSize = TAL_PageSize )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !:Virtual memory root delete
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      static void DestroyRoot( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Inline Method: VMR !:Get virtual memory root
+// 
+// Returned exceptions
+//    Assert - if the singleton has not been created
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      static inline VMC_VirtualMemoryRoot * VMC_VirtualMemoryRoot :: GetRoot( )
+      {
+
+         return pVirtualMemoryRoot ;
+
+      } // End : Root of VMR !:Get virtual memory root
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Is page in memory
+// 
+// Description
+//    Returns true if the page is already in memory, or if there is
+//    an empty frame that could receive the virtual memory
+//    The pool does not grow.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool IsPageInMemory( int idSeg ,
+                           int idPag  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Verify virtual memory root object
+// 
+// Description
+//    Verifies all frames that are registered in the LRU list.
+// 
+// Parameters
+//    $P ModeParm - TAL_VerifyLog   - generates a log of all errors found
+//                  TAL_VerifyNoLog - returns upon finding the first error
+// 
+// Return value
+//    true  - if the virtual memory structure is correct
+//    false - if it is corrupted
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int VerifyVirtualMemory( TAL_tpVerifyMode verifyMode )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Verify number of open pages
+// 
+// Description
+//    Counts open pages of a given segment paged in to the LRU list
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int CountOpenPages( int idSeg )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Verify all open pages
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int VerifyOpenPages( TAL_tpVerifyMode verifyMode )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Display virtual memory usage statistics
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void DisplayStatistics( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Display list of pinned frames
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void DisplayPinnedFrameList( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Write all dirty frames
+// 
+// Description
+//    Writes all dirty pages to their corresponding virtual page.
+//    The pages are taken from the dirty frame set, the pool is not scanned.
+//    After writing all pages are not dirty.
+//    Waits first until the write behind queue is empty.
+//    Pages are written sorted by segment and page, each run of adjacent
+//    pages while holding the segment I/O lock once, hence the segments
+//    receive their pages in file order.
+//    A run of a segment in direct I/O mode is written with one vectored
+//    write, and the segment is synced once after all its runs.
+//    Throws if a page cannot be written, or if such a segment cannot be
+//    synced.
+// 
+// Parameters
+//    $P isSync - if true, every segment written since the last sync,
+//                buffered or in direct I/O mode, is synced once after
+//                all pages are written. Throws if one cannot be synced.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void WriteAllPageFrames( bool isSync = false )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set eviction mode
+// 
+// Description
+//    Selecting VMC_EVICT_CLEAN_FIRST starts the write behind thread.
+//    Selecting VMC_EVICT_SYNCHRONOUS waits until all queued pages have
+//    been written and stops the thread.
+// 
+// Returned exceptions
+//    The exception raised by a failed write behind, if any.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void SetEvictionMode( VMC_tpEvictionMode mode )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get eviction mode
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_tpEvictionMode GetEvictionMode( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set direct page maps
+// 
+// Description
+//    Direct page maps are used by default.
+//    Turning them off returns all pages to the page table, turning them
+//    on affects segments that have no page in memory.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void SetDirectPageMaps( bool isOn )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set read ahead
+// 
+// Description
+//    Read ahead is off by default.
+// 
+// Parameters
+//    $P maxPages - maximum read ahead window in pages, 0 turns read
+//                  ahead off. Clamped to 0 .. 64.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void SetReadAhead( int maxPages )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set compressed tier
+// 
+// Description
+//    The compressed tier is off by default, see the module description.
+//    Setting a size replaces the tier, the pages it held are dropped.
+// 
+// Parameters
+//    $P sizeKiB - size of the arena of the tier in KiB, 0 turns the tier
+//                 off. Clamped to 0 .. 1 GiB, and raised to hold at least
+//                 4 uncompressed pages.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void SetCompressedTier( int sizeKiB )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get compressed tier counters
+// 
+// Description
+//    Counts the misses served by the compressed tier (hits), the misses
+//    read from the segments while the tier is on (misses), the victims
+//    stored in the tier and the pages dropped to make room.
+//    All counters are 0 while the tier is off, and restart with a new
+//    tier.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void GetCompressedTierCounters( int * pNumHits    ,
+                                      int * pNumMisses  ,
+                                      int * pNumStored  ,
+                                      int * pNumDropped  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Release frames
+// 
+// Description
+//    Returns the page value memory of clean, not pinned frames to the
+//    system, e.g. when the host is under memory pressure.
+//    Empty frames are released first, then the frames closest to
+//    eviction that are not dirty. Their pages are removed from memory.
+//    The pool never shrinks below the number of frames it started with.
+//    Released frames are reused first when the pool grows again.
+// 
+// Parameters
+//    $P numFrames - maximum number of frames to be released
+// 
+// Return value
+//    Number of frames released
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int ReleaseFrames( int numFrames )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Start tail cleaner
+// 
+// Description
+//    Starts the background thread that keeps the frames closest to
+//    eviction clean. The thread wakes up periodically and whenever a
+//    miss has to evict a page.
+//    A running cleaner is stopped first, its counters are lost.
+//    Policies that do not list their victim candidates are not cleaned.
+// 
+// Parameters
+//    $P numScanFrames - number of candidates inspected, from the tail
+//    $P lowWatermark  - cleaning starts when less candidates are clean
+//    $P highWatermark - cleaning stops when this many candidates are clean
+//                       Watermarks are limited to numScanFrames, the low
+//                       one to the high one.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StartTailCleaner( int numScanFrames ,
+                             int lowWatermark  ,
+                             int highWatermark  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Stop tail cleaner
+// 
+// Description
+//    Waits for the write in progress, if any, and stops the thread.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StopTailCleaner( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Clean tail frames
+// 
+// Description
+//    Should only be used by the virtual memory components.
+//    Performs one pass of the tail cleaner, see StartTailCleaner.
+//    Each frame written is pinned while it is written.
+// 
+// Parameters
+//    $P pNumFailures - is increased by the number of failed writes,
+//                      failed frames remain dirty
+// 
+// Return value
+//    Number of pages written
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int CleanTailFrames( int numScanFrames ,
+                           int lowWatermark  ,
+                           int highWatermark ,
+                           int * pNumFailures )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get tail cleaner counters
+// 
+// Description
+//    All counters are 0 if the cleaner is not running.
+// 
+// Parameters
+//    $P pNumScans     - number of passes over the tail
+//    $P pNumCleanings - number of passes that found the tail below the
+//                       low watermark and wrote or tried to write pages
+//    $P pNumWrites    - number of pages written
+//    $P pNumFailures  - number of failed writes
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void GetCleanerCounters( int * pNumScans     ,
+                               int * pNumCleanings ,
+                               int * pNumWrites    ,
+                               int * pNumFailures   )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Start dirty flusher
+// 
+// Description
+//    Starts the background thread that writes the oldest dirty frames
+//    whenever too many frames are dirty. The thread wakes up periodically.
+//    A running flusher is stopped first, its counters are lost.
+// 
+// Parameters
+//    $P highWatermark     - flushing starts when more than this percentage
+//                           of the frames are dirty, the flusher is not
+//                           started if it is not positive
+//    $P lowWatermark      - flushing stops when no more than this
+//                           percentage of the frames are dirty
+//                           Watermarks are limited to 100, the low one
+//                           to the high one.
+//    $P maxPagesPerSecond - maximum write rate, 0 for no limit
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StartDirtyFlusher( int highWatermark ,
+                              int lowWatermark  ,
+                              int maxPagesPerSecond )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Stop dirty flusher
+// 
+// Description
+//    Waits for the write in progress, if any, and stops the thread.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StopDirtyFlusher( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Flush dirty frames
+// 
+// Description
+//    Should only be used by the virtual memory components.
+//    Performs one pass of the dirty flusher, see StartDirtyFlusher.
+//    Each frame written is pinned while it is written.
+// 
+// Parameters
+//    $P maxPages     - maximum number of pages written
+//    $P pIsFlushing  - true if the previous pass stopped above the low
+//                      watermark, is set to whether this pass stops above it
+//    $P pNumFailures - is increased by the number of failed writes,
+//                      failed frames remain dirty
+// 
+// Return value
+//    Number of pages written
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int FlushDirtyFrames( int highWatermark ,
+                            int lowWatermark  ,
+                            int maxPages      ,
+                            bool * pIsFlushing ,
+                            int * pNumFailures )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get dirty flusher counters
+// 
+// Description
+//    All counters are 0 if the flusher is not running.
+// 
+// Parameters
+//    $P pNumPasses   - number of passes
+//    $P pNumFlushes  - number of times the high watermark was passed
+//    $P pNumWrites   - number of pages written
+//    $P pNumFailures - number of failed writes
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void GetFlusherCounters( int * pNumPasses   ,
+                               int * pNumFlushes  ,
+                               int * pNumWrites   ,
+                               int * pNumFailures  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get number of dirty frames
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int GetNumDirtyFrames( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Remove all pages of a given segment
+// 
+// Description
+//    Removes all pages that belong to a given segment.
+//    This method should be used before deleting a segment.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void RemoveSegment( int idSeg )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Map segment file
+// 
+// Description
+//    Maps the file of the segment, from then on pages of the segment are
+//    bound to their frames without being read or copied, see the module
+//    description. Pages added after the segment has been mapped are
+//    copied. Pages already in memory stay copies until they leave their
+//    frames. The mapping ends when the segment is removed.
+//    The segment file must hold segment page i at byte i * TAL_PageSize,
+//    and the segment module must write through to the file. The first
+//    and the last page are read through the segment module and compared
+//    with the file bytes before the file is mapped.
+// 
+// Return value
+//    true  if the segment is mapped
+//    false if the file cannot be mapped, the segment is empty or in
+//          direct I/O mode, or the pages compared differ from the file
+//          bytes, its pages are then copied as usual
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool MapSegment( int idSeg )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set direct I/O
+// 
+// Description
+//    Turns direct I/O for the pages of a segment on or off, see the
+//    module description. Direct I/O ends when the segment is removed.
+//    The segment file must hold segment page i at byte i * TAL_PageSize,
+//    and the segment module must not keep pages of its own.
+// 
+// Return value
+//    true  if the segment is in direct I/O mode
+//    false if it is not, either because it was turned off, or because
+//          the segment is mapped, the file cannot be opened, is not laid
+//          out as the segment module reads it, or the file system
+//          refuses O_DIRECT
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool SetDirectIo( int idSeg ,
+                        bool isOn  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Set checksum mode
+// 
+// Description
+//    Selects whether page transfers are checked with CRC32C checksums,
+//    see the module description. The CRC instructions of the processor
+//    are used when present. Turning checksums off saves and forgets the
+//    recorded checksums, they are loaded again when turned on if the
+//    segment file has not changed meanwhile.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void SetChecksumMode( VMC_tpChecksumMode mode )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Open redo log
+// 
+// Description
+//    Starts logging the changes made with SetPageData, see the module
+//    description. A log already open is closed first.
+//    If the file holds records, the changes they describe are redone
+//    up to the first damaged record, the pages are written and the log
+//    is emptied. Records of pages that no longer exist are skipped.
+// 
+// Parameters
+//    $P logFileName   - name of the log file, created if it does not exist
+//    $P checkpointKiB - log size beyond which CommitLog checkpoints,
+//                       0 selects 64 MiB. Clamped to 64 KiB .. 16 GiB.
+// 
+// Return value
+//    Number of records redone
+//    -1 if the file cannot be opened, if it names a segment that is not
+//       open or if a segment written cannot be synced, in which case
+//       the file is left as it is and no log is open
+// 
+// Returned exceptions
+//    If a record cannot be redone or a page cannot be written the
+//    exception is passed on, the file is left as it is and no log is
+//    open.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int OpenLog( const char * logFileName ,
+                   int checkpointKiB          )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Commit redo log
+// 
+// Description
+//    Makes the changes logged so far durable. Commits that do not wait
+//    return at once and share the sync of the next batch. Checkpoints if
+//    the log has grown beyond its limit.
+// 
+// Return value
+//    false if a write to the log failed, the changes logged since the
+//          last checkpoint are then not durable
+//    true  otherwise, also if no log is open
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool CommitLog( bool isWait = true )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Checkpoint redo log
+// 
+// Description
+//    Writes all dirty frames and empties the redo log.
+//    Throws as WriteAllPageFrames if a page cannot be written.
+// 
+// Return value
+//    false if a write to the log failed, or if a segment written cannot
+//          be synced, in which case the log is not emptied
+//    true  otherwise, also if no log is open
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      bool CheckpointLog( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Close redo log
+// 
+// Description
+//    Checkpoints and stops logging. Does nothing if no log is open.
+//    DestroyRoot closes the log.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void CloseLog( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get redo log counters
+// 
+// Description
+//    Counts the records logged, the commits, the syncs of the log and
+//    the checkpoints. Fewer syncs than commits show commits grouped.
+//    All counters are 0 while no log is open, and restart with a new log.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void GetLogCounters( int * pNumRecords     ,
+                           int * pNumCommits     ,
+                           int * pNumSyncs       ,
+                           int * pNumCheckpoints  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Add new page value to end of segment file
+// 
+// Description
+//    This function gets a frame containing a new empty page added to the end
+//    of the segment file.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_PageFrame * AddNewPage( int idSeg )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get first page frame element
+// 
+// Description
+//    Should only be used by the virtual memory components.
+//    Returns the first page frame element of the frame vector.
+//    Elements are enumerated in vector order, empty frames included.
+//    The replacement order is private to the policy, see
+//    VMC_ReplacementPolicy.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_PageFrameElement * GetFirstFrameElement( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get next page frame element
+// 
+// Description
+//    Should only be used by the virtual memory components.
+//    Returns the element following currentElem in the frame vector,
+//    NULL after the last one.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_PageFrameElement * GetNextFrameElement( VMC_PageFrameElement * currentElem )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get page frame
+// 
+// Description
+//    This method returns the page frame where a copy of the virtual pages
+//    can be found.
+//    Only one copy of the virtual page may existe in real memory.
+//    Hence, all simmultaneously existing references to a same
+//    virtual address will map onto the same page frame.
+//    The location of virtual pages is ephemeral, if a page frame is not
+//    pinned it might be selected to be paged out. Hence, on the next
+//    access to the virtual page probably the page frame holding the
+//    virtual page will be a different one.
+//    An exception is generated if no repleceable frame can be found.
+//    This occurs if all page frames are pinned.
+//    
+//    Certain methods restrict access to pages that are already in memory.
+//    To satisfy this restriction use  inMemory == true.
+//    When accessing virtual pages that must be in memory, following
+//    rules hold:
+//    - if the virtual page is already in memory, its page frame
+//      is returned, but the page is not moved to the head of the
+//      LRU list.
+//    - if the virtual page is not in memory, but the free list is not
+//      empty, the virtual page is read into a free page frame, which
+//      is handed to the replacement policy.
+//    - if none of these conditions hold, NULL is returned
+// 
+// Parameters
+//    $P idSeg
+//    $P idPag - virtual address of the virtual page to be placed
+//               in real memory
+//    $P inMemory - if true only virtual pages already in memory
+//                  or copied into a free frame are accessed
+//                - if false replaces least recently used pages whenever
+//                  necessary.
+// 
+// Return value
+//    Pointer to the page frame containing a copy of the virtual page.
+// 
+// Returned exceptions
+//    EXC_Error if page does not exist.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_PageFrame * GetPageFrame( int  idSeg ,
+                                    int  idPag ,
+                                    bool inMemory = false )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get page frame asynchronously
+// 
+// Description
+//    Starts paging in the virtual page and returns without waiting for
+//    its read. A frame is reserved, evicting a page if necessary, and the
+//    page is registered, hence later accesses find it. The frame is
+//    pinned until the read completes.
+//    Does nothing if the page is in memory or being read.
+//    Pages whose write is pending in the write behind queue are copied at
+//    once. Without reader threads the page is read at once.
+// 
+// Parameters
+//    $P idSeg
+//    $P idPag - virtual address of the virtual page to be read
+// 
+// Returned exceptions
+//    As GetPageFrame, a failed read is reported by the access that
+//    completes it.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void GetPageFrameAsync( int idSeg ,
+                              int idPag  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Wait for page frame
+// 
+// Description
+//    Waits for the read of the virtual page, if one is in flight, and
+//    returns its page frame pinned. The page is read at once if it is
+//    not in memory. The caller must unpin the frame.
+// 
+// Parameters
+//    $P idSeg
+//    $P idPag - virtual address of the virtual page
+// 
+// Return value
+//    Pointer to the pinned page frame containing the virtual page.
+// 
+// Returned exceptions
+//    As GetPageFrame, including the failure of an asynchronous read.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      VMC_PageFrame * WaitPageFrame( int idSeg ,
+                                     int idPag  )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Start page in threads
+// 
+// Description
+//    Starts the pool of threads reading pages for GetPageFrameAsync.
+//    A running pool is stopped first.
+// 
+// Parameters
+//    $P numThreads - number of reader threads, if not positive no
+//                    pool is started
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StartPageInThreads( int numThreads )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Stop page in threads
+// 
+// Description
+//    Completes all reads in flight and stops the threads. Pages whose
+//    read fails are removed from memory.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      void StopPageInThreads( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get number page frames
+// 
+// Description
+//    Returns the number of frames able to hold pages, released frames
+//    excluded.
+// 
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int GetNumPageFrames( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get page size
+// 
+// Return value
+//    The number of bytes of the virtual pages, a multiple of TAL_PageSize
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      VMC_PageFrameElement * GetLruListHead( )  ;
+      int GetPageSize( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get next LRU list element
+//  Method: VMR !Get total frame accesses
 // 
-// Description
-//    Should only be used by the virtual memory components.
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int GetTotalAccesses( )  ;
+
+////////////////////////////////////////////////////////////////////////////
+// 
+//  Method: VMR !Get total frame replaces
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      VMC_PageFrameElement * GetNextLruListElement( VMC_PageFrameElement * currentElem )  ;
+      int GetTotalReplaces( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get page frame
+//  Method: VMR !Get total hit count
 // 
-// Description
-//    This method returns the page frame where a copy of the virtual pages
-//    can be found.
-//    Only one copy of the virtual page may existe in real memory.
-//    Hence, all simmultaneously existing references to a same
-//    virtual address will map onto the same page frame.
-//    The location of virtual pages is ephemeral, if a page frame is not
-//    pinned it might be selected to be paged out. Hence, on the next
-//    access to the virtual page probably the page frame holding the
-//    virtual page will be a different one.
-//    An exception is generated if no repleceable frame can be found.
-//    This occurs if all page frames are pinned.
-//    
-//    Certain methods restrict access to pages that are already in memory.
-//    To satisfy this restriction use  inMemory == true.
-//    When accessing virtual pages that must be in memory, following
-//    rules hold:
-//    - if the virtual page is already in memory, its page frame
-//      is returned, but the page is not moved to the head of the
-//      LRU list.
-//    - if the virtual page is not in memory, but the last element
-//      of the LRU list is a free page, the virtual page is read into
-//      the corresponding and the page frame is moved to the head of
-//      the LRU list.
-//    - if none of these conditions hold, NULL is returned
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int GetTotalHits( )  ;
+
+////////////////////////////////////////////////////////////////////////////
 // 
-// Parameters
-//    $P idSeg
-//    $P idPag - virtual address of the virtual page to be placed
-//               in real memory
-//    $P inMemory - if true only virtual pages already in memory
-//                  or copied into a free frame are accessed
-//                - if false replaces least recently used pages whenever
-//                  necessary.
+//  Method: VMR !Get number of pinned frames
 // 
-// Return value
-//    Pointer to the page frame containing a copy of the virtual page.
+////////////////////////////////////////////////////////////////////////////
+
+   public:
+      int GetNumPinnedFrames( )  ;
+
+////////////////////////////////////////////////////////////////////////////
 // 
-// Returned exceptions
-//    EXC_Error if page does not exist.
+//  Method: VMR !Get page frame of current element
+// 
+// Description
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      VMC_PageFrame * GetPageFrame( int  idSeg ,
-                                    int  idPag ,
-                                    bool inMemory = false )  ;
+      VMC_PageFrame * GetPageFrame( VMC_PageFrameElement * currentElem )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get number page frames
+//  Method: VMR !Get replacement policy
+// 
+// Description
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int GetNumPageFrames( )  ;
+      VMC_ReplacementPolicy * GetReplacementPolicy( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get total frame accesses
+//  Method: VMR !Get module lock
+// 
+// Description
+//    Returns the lock guarding the root and the frame states while the
+//    tail cleaner or the dirty flusher runs, NULL if neither runs.
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int GetTotalAccesses( )  ;
+      std::recursive_mutex * GetModuleLock( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get total frame replaces
+//  Method: VMR !Get segment page run
+// 
+// Description
+//    Returns the object transferring the pages of the root to and from
+//    the segments.
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int GetTotalReplaces( )  ;
+      VMC_SegmentPageRun * GetSegmentPageRun( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get total hit count
+//  Method: VMR !Get redo log
+// 
+// Description
+//    Returns the redo log, NULL if it is not open.
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int GetTotalHits( )  ;
+      VMC_RedoLog * GetRedoLog( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get number of pinned frames
+//  Method: VMR !Get frame arena
+// 
+// Description
+//    Returns the arena containing the page value buffers of the frames.
+//    Should only be used by the virtual memory components.
 // 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      int GetNumPinnedFrames( )  ;
+      VMC_FrameArena * GetFrameArena( )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
-//  Method: VMR !Get page frame of current element
+//  Method: VMR !Get opening mode of a segment in memory
 // 
 // Description
+//    Returns the opening mode the segment had when its first page in
+//    memory was registered, without calling the segment module.
 //    Should only be used by the virtual memory components.
 // 
+// Parameters
+//    $P idSeg - segment having at least one page in memory
+// 
 ////////////////////////////////////////////////////////////////////////////
 
    public:
-      VMC_PageFrame * GetPageFrame( VMC_PageFrameElement * currentElem )  ;
+      TAL_tpOpeningMode GetOpeningMode( int idSeg )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 
@@ -1087,7 +2581,10 @@ class VMC_VirtualMemoryRoot
 
    protected:
       VMC_VirtualMemoryRoot( int minFramesParm ,
-                             int maxFramesParm  )  ;
+                             int maxFramesParm ,
+                             VMC_ReplacementPolicy * pPolicyParm ,
+                             VMC_tpArenaPages arenaPagesParm ,
+                             int pageSizeParm )  ;
 
 ////////////////////////////////////////////////////////////////////////////
 // 
@@ -1106,26 +2603,106 @@ class VMC_VirtualMemoryRoot
       VMC_PageFrameElement * SearchRealPage( int idSeg ,
                                          int idPag  )  ;
 
+//  Method: VMR $Compute lookaside index
+
+   private:
+      int ComputeInxLookaside( int idSeg , int idPag )  ;
+
 //  Method: VMR $Start up virtual memory
 
    private:
       void StartUpVirtualMemory( int minFramesParm ,
-                      int maxFramesParm  )  ;
+                      int maxFramesParm ,
+                      VMC_ReplacementPolicy * pPolicyParm ,
+                      VMC_tpArenaPages arenaPagesParm ,
+                      int pageSizeParm )  ;
 
 //  Method: VMR $Find a replaceable page frame element
 
    private:
-      VMC_PageFrameElement * FindReplaceableFrame( )  ;
+      VMC_PageFrameElement * FindReplaceableFrame( bool isHotPage )  ;
+
+//  Method: VMR $Construct page frame
+
+   private:
+      VMC_PageFrameElement * ConstructFrame( int inxFrame )  ;
+
+//  Method: VMR $Grow frame pool
+
+   private:
+      bool GrowPool( )  ;
+
+//  Method: VMR $Choose releasable victim
+
+   private:
+      VMC_PageFrame * ChooseReleasableVictim( )  ;
+
+//  Method: VMR $Remember evicted page
+
+   private:
+      void RememberEvictedPage( VMC_PageFrame * pPageFrame )  ;
+
+//  Method: VMR $Store victim page in the compressed tier
+
+   private:
+      void StoreVictimPage( VMC_PageFrame * pPageFrame )  ;
+
+//  Method: VMR $Redo log records
+
+   private:
+      int ReplayLog( const char * pLog , long long sizeLog )  ;
+
+//  Method: VMR $Find segment of a log record
+
+   private:
+      int FindLoggedSegment( const char * pName , int sizeName )  ;
+
+//  Method: VMR $Redo data of a log record
+
+   private:
+      void RedoLogData( int idSeg , long long position ,
+                        int sizeData , const char * pData )  ;
+
+//  Method: VMR $Was page evicted recently
+
+   private:
+      bool IsRecentlyEvicted( int idSeg , int idPag )  ;
+
+//  Method: VMR $Write page run
+
+   private:
+      void WritePageRun( const VMC_DirtyFrame * vtDirtyFrame ,
+                         int numFrames )  ;
+
+//  Method: VMR $Sync all segments written
+
+   private:
+      void SyncAllWrittenSegments( )  ;
+
+//  Method: VMR $Compare dirty frames
+
+   private:
+      static int CompareDirtyFrames( const void * pFirst ,
+                                     const void * pSecond )  ;
 
-//  Method: VMR $Move to LRU head the page frame element
+//  Method: VMR $Read ahead
 
    private:
-      void MoveElemLruHead( VMC_PageFrameElement * pPageFrameElem )  ;
+      void ReadAhead( int idSeg ,
+                      int idPag ,
+                      VMC_PageFrame * pKeptFrame )  ;
 
-//  Method: VMR $Move to LRU tail the page frame element
+//  Method: VMR $Prefetch page
 
    private:
-      void MoveElemLruTail( VMC_PageFrameElement * pPageFrameElem )  ;
+      bool PrefetchPage( int idSeg ,
+                         int idPag ,
+                         VMC_PageFrame * pKeptFrame )  ;
+
+//  Method: VMR $Choose prefetch victim
+
+   private:
+      VMC_PageFrame * ChoosePrefetchVictim( VMC_PageFrame * pKeptFrame )  ;
 
 //  Method: VMR $Replace page in frame
 
@@ -1133,7 +2710,42 @@ class VMC_VirtualMemoryRoot
       void ReplacePage( VMC_PageFrameElement * pPageFrameElem ,
                         int  idSeg    ,
                         int  idPag    ,
-                        bool isNewPage )  ;
+                        bool isNewPage ,
+                        bool isPrefetch )  ;
+
+//  Method: VMR $Insert page frame
+//    Hands a frame that has just received a page to the page table and
+//    the replacement policy.
+
+   private:
+      void InsertPageFrame( VMC_PageFrameElement * pPageFrameElem ,
+                            bool isPrefetch )  ;
+
+//  Method: VMR $Schedule page in
+
+   private:
+      void SchedulePageIn( VMC_PageFrameElement * pPageFrameElem ,
+                           int  idSeg ,
+                           int  idPag ,
+                           bool isPrefetch )  ;
+
+//  Method: VMR $Finish page in
+//    Waits for the read into the frame, which then becomes in use and
+//    loses the pin of the read. If the read failed the page is removed
+//    and the exception of the read is thrown.
+
+   private:
+      void FinishPageIn( VMC_PageFrameElement * pPageFrameElem )  ;
+
+//  Method: VMR $Finish all page ins
+
+   private:
+      void FinishAllPageIns( )  ;
+
+//  Method: VMR $Get page frame element of a frame
+
+   private:
+      VMC_PageFrameElement * GetFrameElement( VMC_PageFrame * pPageFrame )  ;
 
 //  Method: VMR $Get empty page frame
 
@@ -1151,15 +2763,85 @@ class VMC_VirtualMemoryRoot
    private:
       int ComputeInxHash( int idSeg , int idPag )  ;
 
-//  Method: VMR $Link page frame into colision list
+//  Method: VMR $Compute page table key
+
+   private:
+      unsigned long long ComputePageKey( int idSeg , int idPag )  ;
+
+//  Method: VMR $Allocate page table
+
+   private:
+      void AllocatePageTable( int numEntries )  ;
+
+//  Method: VMR $Get segment page map
+
+   private:
+      VMC_SegmentPageMap * GetSegmentMap( int idSeg )  ;
+
+//  Method: VMR $Reset read ahead state
+
+   private:
+      void ResetReadAhead( VMC_SegmentPageMap * pMap )  ;
+
+//  Method: VMR $Unmap segment file
+
+   private:
+      void UnmapSegment( VMC_SegmentPageMap * pMap )  ;
+
+//  Method: VMR $Get mapped page value
+
+   private:
+      char * GetMappedValue( int idSeg , int idPag )  ;
+
+//  Method: VMR $Register page of a frame
+
+   private:
+      void RegisterPage( VMC_PageFrameElement * pPageFrameElem )  ;
+
+//  Method: VMR $Unregister page of a frame
+
+   private:
+      void UnregisterPage( VMC_PageFrameElement * pPageFrameElem )  ;
+
+//  Method: VMR $Release direct page map
+
+   private:
+      void ReleaseSegmentMap( int idSeg )  ;
+
+//  Method: VMR $Insert page frame into page table
+
+   private:
+      void InsertPageTableEntry( VMC_PageFrameElement * pPageFrameElem )  ;
+
+//  Method: VMR $Take a page frame element from the free list
+
+   private:
+      VMC_PageFrameElement * GetFreeFrameElement( )  ;
+
+//  Method: VMR $Insert page frame element into the free list
+
+   private:
+      void InsertFreeFrameElement( VMC_PageFrameElement * pPageFrameElem )  ;
+
+//  Method: VMR $Choose clean victim
+
+   private:
+      VMC_PageFrame * ChooseCleanVictim( )  ;
+
+//  Method: VMR $Wait until all write behind pages are written
+
+   private:
+      void DrainWriteBehind( )  ;
+
+//  Method: VMR $Wait for the write of the tail cleaner
 
    private:
-      void LinkColisionList( VMC_PageFrameElement * pPageFrameElem )  ;
+      void WaitCleanerWrite( )  ;
 
-//  Method: VMR $Unlink page frame from colision list
+//  Method: VMR $Remove page frame from page table
 
    private:
-      void UnlinkColisionList( VMC_PageFrameElement * pPageFrameElem )  ;
+      void RemovePageTableEntry( VMC_PageFrameElement * pPageFrameElem )  ;
 
 //  Method: VMR $Verify and correct all page counters
 
@@ -1183,21 +2865,163 @@ class VMC_VirtualMemoryRoot
    private: 
       int totalReplaceCounter ;
 
-// VMR LRU list anchor
+// VMR Page replacement policy
+
+   private: 
+      VMC_ReplacementPolicy * pReplacementPolicy ;
+
+// VMR Vector of all page frame elements
+//    Indexed by inxFrameElement.
+
+   private: 
+      VMC_PageFrameElement ** vtPageFrameElem ;
+
+// VMR Frame storage
+//    Page frame elements and page frames are constructed in place in
+//    two vectors, page values reside in the frame arena.
+
+   private: 
+      VMC_PageFrameElement * vtFrameElemBlock ;
+      VMC_PageFrame * vtPageFrameBlock ;
+      VMC_FrameArena * pFrameArena ;
+
+// VMR Frame metadata vectors
+
+   private: 
+      VMC_FrameMetadata * pFrameMetadata ;
+
+// VMR Free frame list
+//    Singly linked list of all empty page frame elements.
+
+   private: 
+      VMC_PageFrameElement * pFreeListHead ;
+      int numFreeFrames ;
+
+// VMR Eviction mode and write behind queue
+//    The queue exists only in VMC_EVICT_CLEAN_FIRST mode.
+
+   private: 
+      VMC_tpEvictionMode evictionMode ;
+      VMC_WriteBehindQueue * pWriteBehindQueue ;
+
+// VMR Tail cleaner, NULL if not running
+
+   private: 
+      VMC_TailCleaner * pTailCleaner ;
+
+// VMR Dirty flusher, NULL if not running
+
+   private: 
+      VMC_DirtyFlusher * pDirtyFlusher ;
+
+// VMR Module lock and whether the tail cleaner or the dirty flusher runs
+//    The lock is taken before segmentIoMutex whenever both are held.
+//    isCleanerRunning is only changed by the foreground while neither
+//    thread is running.
+
+   private: 
+      std::recursive_mutex cleanerMutex ;
+      bool isCleanerRunning ;
+
+// VMR Page in queue, NULL if no reader threads run
+
+   private: 
+      VMC_PageInQueue * pPageInQueue ;
+
+// VMR Compressed tier, NULL if off
+
+   private: 
+      VMC_CompressedTier * pCompressedTier ;
+
+// VMR Redo log, NULL if not open
+//    Only changed under the module lock with the write behind queue
+//    drained, hence the writer threads see it as the foreground does.
+
+   private: 
+      VMC_RedoLog * pRedoLog ;
+
+// VMR Page table
+//    numPageTableSlots is a power of 2.
+
+   private: 
+      VMC_PageTableSlot * vtPageTableSlot ;
+      int numPageTableSlots ;
+      int numPageTableEntries ;
+
+// VMR Segment page maps
+//    Indexed by segment id, grows when larger ids are used.
+
+   private: 
+      VMC_SegmentPageMap * vtSegmentMap ;
+      int dimSegmentMap ;
+      bool isDirectMapOn ;
+
+// VMR Lookaside of recently found pages and its counters
+
+   private: 
+      VMC_LookasideEntry * vtLookaside ;
+      int totalLookasideSearches ;
+      int totalLookasideHits ;
+
+// VMR Pages written by WriteAllPageFrames and runs of adjacent pages
+
+   private: 
+      int totalFlushPageCounter ;
+      int totalFlushRunCounter ;
+
+// VMR Pages bound to frames within the mapping of their segment file
 
    private: 
-      VMC_PageFrameElement * lruListHead ;
-      VMC_PageFrameElement * lruListTail ;
+      int totalMapCounter ;
 
-// VMR Hash table colision lists array
+// VMR Maximum read ahead window, 0 if read ahead is off, and counters
+//    of the pages read ahead, of those later accessed and of those
+//    evicted before being accessed.
 
    private: 
-      VMC_PageFrameElement * vtColision[ TAL_dimColision ] ;
+      int maxReadAhead ;
+      int totalPrefetchCounter ;
+      int totalPrefetchHitCounter ;
+      int totalPrefetchWasteCounter ;
 
-// VMR Number of available frames
+// VMR Number of constructed frames
+//    Frames numPageFrames up to maxPageFrames - 1 have not been
+//    constructed yet, their page value memory has never been touched.
 
    private: 
       int numPageFrames ;
+      int minPageFrames ;
+      int maxPageFrames ;
+
+// VMR Released frame list
+//    Singly linked list of the frames whose page value memory has been
+//    returned to the system.
+
+   private: 
+      VMC_PageFrameElement * pReleasedListHead ;
+      int numReleasedFrames ;
+
+// VMR Evicted page history
+//    Direct mapped page keys of recently evicted pages.
+//    NULL if the pool cannot grow.
+
+   private: 
+      unsigned long long * vtEvictedKey ;
+      int numEvictedSlots ;
+
+// VMR Page size, a whole number of segment pages, and the object
+//    transferring the pages as runs of segment pages
+
+   private: 
+      int pageSize ;
+      int numSegmentPagesPerPage ;
+      VMC_SegmentPageRun * pSegmentPageRun ;
+
+// VMR Pool growth and release counters
+
+   private: 
+      int totalGrowCounter ;
+      int totalReleaseCounter ;
 
 // VMR Virtual memory root pointer
 
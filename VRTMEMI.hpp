@@ -0,0 +1,67 @@
+#ifndef _VRTMEMI_
+   #define _VRTMEMI_
+
+////////////////////////////////////////////////////////////////////////////
+//
+// Definition module: VMC  VRTMEMI Virtual memory control internals
+//
+// Generated file:    VRTMEMI.HPP
+//
+// Module identification letters: VMC
+// Module identification number:  455
+//
+// Repository name:      Virtual memory
+// Repository file name: Z:\TALISMAN\REPOSIT\BSW\VRTMEM.BSW
+//
+// Owning organization:    LES/DI/PUC-Rio
+// Project:                Talisman
+// -------------------------------------------------------------------------
+// Specification
+//    Declarations shared by the components of the virtual memory control.
+//    Only the implementation modules of the virtual memory control
+//    include this module.
+//    Belongs to module VRTMEM, whose identification and repository file
+//    it shares.
+//
+////////////////////////////////////////////////////////////////////////////
+
+//==========================================================================
+//----- Required includes -----
+//==========================================================================
+
+   #include  <mutex>
+
+//==========================================================================
+//----- Exported data items -----
+//==========================================================================
+
+
+// VMR Dimension of a statistics line
+//    Fits the longest statistics format with every number at its widest.
+
+   static const int DIM_STAT_LINE = 256 ;
+
+// VMR Undefined page value character
+
+   static const char VALUE_UNDEFINED = '+' ;  //  '\xFA' ;
+
+// VMR Empty page table slot key
+//    Segment ids of pages in memory are never negative.
+
+   static const unsigned long long EMPTY_PAGE_KEY = ~0ULL ;
+
+// VMS Alignment of direct I/O buffers, offsets and lengths
+
+   static const int DIRECT_IO_ALIGNMENT = 4096 ;
+
+// VMW Segment I/O lock
+//    Serializes page transfers between the foreground and the write
+//    behind thread. The segment module is not thread safe, every call to
+//    it holds this lock.
+
+   extern std::mutex segmentIoMutex ;
+
+
+#endif 
+
+////// End of definition module: VMC  VRTMEMI Virtual memory control internals ////
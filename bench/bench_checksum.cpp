@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Benchmark: VMS  Page checksum cost
+//
+//  Pages are read through a memory of few frames, every access is a
+//  miss, then all pages are changed and written, with and without
+//  checksums. The segment is kept in memory, where the transfer is a
+//  copy, or in a file. Reported per segment and page size: time per
+//  page transfer without checksums, and the cost checksums add to it.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <unistd.h>
+   #include  <chrono>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES    = 16 ;
+   static const int SEGMENT_PAGES = 4096 ;
+   static const int NUM_PASSES    = 4 ;
+
+   static const char FILE_NAME[ ] = "/tmp/vmc_bench_checksum.seg" ;
+
+   static volatile long checkSum = 0 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static double TransferPages( const char * pName , int numSegmentPages ,
+                                VMC_tpChecksumMode mode )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , VMC_REPLACE_LRU ,
+                                         VMC_ARENA_BASE_PAGES ,
+                                         numSegmentPages * TAL_PageSize ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( pName , SEGMENT_PAGES ) ;
+      pRoot->SetChecksumMode( mode ) ;
+
+      int numPages = SEGMENT_PAGES / numSegmentPages ;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( ) ;
+
+      for ( int inxPass = 0 ; inxPass < NUM_PASSES ; inxPass++ )
+      {
+         for ( int idPag = 0 ; idPag < numPages ; idPag++ )
+         {
+            VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idSeg , idPag ) ;
+            checkSum = checkSum + pPageFrame->GetPageValue( )[ 1 ] ;
+            if ( inxPass == NUM_PASSES - 1 )
+            {
+               char value = static_cast< char >( inxPass ) ;
+               pPageFrame->SetPageData( 0 , 1 , &value ) ;
+            } /* if */
+         } /* for */
+      } /* for */
+      pRoot->WriteAllPageFrames( ) ;
+
+      std::chrono::duration< double > elapsed = std::chrono::steady_clock::now( ) - start ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+      return elapsed.count( ) * 1e9 / ( NUM_PASSES + 1 ) / numPages ;
+   }
+
+//==========================================================================
+//----- Benchmark driver -----
+//==========================================================================
+
+   int main( )
+   {
+      printf( "%d frames, segment of %d KiB, %d read passes and one write pass\n" ,
+              NUM_FRAMES , SEGMENT_PAGES * ( TAL_PageSize / 1024 ) , NUM_PASSES ) ;
+      printf( "segment  page size  transfer ns/page  checksum ns/page  checksum share\n" ) ;
+
+      const char * vtName[ ] = { "memory" , FILE_NAME } ;
+
+      for ( int inxName = 0 ; inxName < 2 ; inxName++ )
+      {
+         for ( int numSegmentPages = 1 ; numSegmentPages <= 16 ; numSegmentPages *= 4 )
+         {
+            double timeOff   = TransferPages( vtName[ inxName ] , numSegmentPages ,
+                                              VMC_CHECKSUM_OFF ) ;
+            double timeCount = TransferPages( vtName[ inxName ] , numSegmentPages ,
+                                              VMC_CHECKSUM_COUNT ) ;
+            printf( "%-7s  %9d  %16.0f  %16.0f  %13.1f%%\n" ,
+                    inxName == 0 ? "memory" : "file" , numSegmentPages * TAL_PageSize ,
+                    timeOff , timeCount - timeOff ,
+                    ( timeCount - timeOff ) * 100.0 / timeOff ) ;
+         } /* for */
+      } /* for */
+
+      unlink( FILE_NAME ) ;
+      return 0 ;
+   }
@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Benchmark: VMR  Virtual page sizes
+//
+//  For every page size the frames share the same memory budget. A
+//  segment of 8 times the budget is read sequentially, then at random.
+//  Reported per page size: frames, throughput of both access orders in
+//  MiB per second, and the resident memory growth of the process less
+//  the fake segment, that is the frames and the bookkeeping.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <stdlib.h>
+   #include  <unistd.h>
+   #include  <chrono>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int BUDGET_BYTES  = 8 << 20 ;
+   static const int SEGMENT_PAGES = BUDGET_BYTES * 8 / TAL_PageSize ;
+   static const int NUM_ACCESSES  = 40000 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static long GetResidentKiB( )
+   {
+      long sizeProgram  = 0 ;
+      long sizeResident = 0 ;
+      FILE * pFile = fopen( "/proc/self/statm" , "r" ) ;
+      if ( pFile != NULL )
+      {
+         if ( fscanf( pFile , "%ld %ld" , &sizeProgram , &sizeResident ) != 2 )
+         {
+            sizeResident = 0 ;
+         } /* if */
+         fclose( pFile ) ;
+      } /* if */
+      return sizeResident * ( sysconf( _SC_PAGESIZE ) / 1024 ) ;
+   }
+
+   static double ReadPages( int idSeg , int numPages , bool isRandom , long * pCheckSum )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int pageSize = pRoot->GetPageSize( ) ;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( ) ;
+
+      for ( int inxAccess = 0 ; inxAccess < NUM_ACCESSES ; inxAccess++ )
+      {
+         int idPag = isRandom ? rand( ) % numPages : inxAccess % numPages ;
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         *pCheckSum += pValue[ 0 ] + pValue[ pageSize - 1 ] ;
+      } /* for */
+
+      std::chrono::duration< double > elapsed = std::chrono::steady_clock::now( ) - start ;
+      return ( double ) NUM_ACCESSES * pageSize / elapsed.count( ) / ( 1 << 20 ) ;
+   }
+
+//==========================================================================
+//----- Benchmark driver -----
+//==========================================================================
+
+   int main( )
+   {
+      printf( "memory budget %d KiB, segment %d KiB, %d accesses\n" ,
+              BUDGET_BYTES / 1024 , SEGMENT_PAGES * ( TAL_PageSize / 1024 ) , NUM_ACCESSES ) ;
+      printf( "page size  frames  sequential MiB/s  random MiB/s  resident KiB\n" ) ;
+
+      srand( 17 ) ;
+      long checkSum = 0 ;
+
+      for ( int numSegmentPages = 1 ; numSegmentPages <= 64 ; numSegmentPages *= 2 )
+      {
+         int pageSize  = numSegmentPages * TAL_PageSize ;
+         int numFrames = BUDGET_BYTES / pageSize ;
+
+         long residentBefore = GetResidentKiB( ) ;
+         VMC_VirtualMemoryRoot::CreateRoot( numFrames , numFrames , VMC_REPLACE_LRU ,
+                                            VMC_ARENA_BASE_PAGES , pageSize ) ;
+         int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "bench" , SEGMENT_PAGES ) ;
+
+         int numPages = SEGMENT_PAGES / numSegmentPages ;
+         double sequential = ReadPages( idSeg , numPages , false , &checkSum ) ;
+         double random     = ReadPages( idSeg , numPages , true  , &checkSum ) ;
+         long residentAfter = GetResidentKiB( ) ;
+
+         printf( "%9d  %6d  %16.1f  %12.1f  %12ld\n" ,
+                 pageSize , VMC_VirtualMemoryRoot::GetRoot( )->GetNumPageFrames( ) ,
+                 sequential , random ,
+                 residentAfter - residentBefore - SEGMENT_PAGES * ( TAL_PageSize / 1024 )) ;
+
+         VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+      } /* for */
+
+      printf( "check sum %ld\n" , checkSum ) ;
+      return 0 ;
+   }
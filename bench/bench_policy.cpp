@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Benchmark: VMP  Replacement policies against LRU
+//
+//  Workloads
+//     hot   - random accesses to a hot set of 3/4 of the frames
+//     scan  - sequential scans of a segment 16 times the frames
+//     mixed - hot set accesses interleaved with scans, 8 hot accesses
+//             per scanned page
+//  Reported per policy and workload: hit rate and time per access.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <stdlib.h>
+   #include  <chrono>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES   = 256 ;
+   static const int NUM_PAGES    = NUM_FRAMES * 16 ;
+   static const int NUM_HOT      = NUM_FRAMES * 3 / 4 ;
+   static const int NUM_ACCESSES = 400000 ;
+
+   enum tpWorkload
+   {
+      WORKLOAD_HOT ,
+      WORKLOAD_SCAN ,
+      WORKLOAD_MIXED
+   }  ;
+
+   static const char * vtWorkloadName[ ] = { "hot" , "scan" , "mixed" } ;
+   static const char * vtPolicyName[ ]   = { "LRU" , "clock" , "2Q" } ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void RunWorkload( VMC_tpReplacementPolicy policy , tpWorkload workload )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , policy ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "bench" , NUM_PAGES ) ;
+
+      srand( 17 ) ;
+      int idScanPag = NUM_HOT ;
+      long checkSum = 0 ;
+
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( ) ;
+
+      for ( int inxAccess = 0 ; inxAccess < NUM_ACCESSES ; inxAccess++ )
+      {
+         int idPag = 0 ;
+         bool isScan = workload == WORKLOAD_SCAN ||
+                       ( workload == WORKLOAD_MIXED && inxAccess % 9 == 8 ) ;
+         if ( isScan )
+         {
+            idPag = idScanPag ;
+            idScanPag = idScanPag + 1 < NUM_PAGES ? idScanPag + 1 : NUM_HOT ;
+         } else
+         {
+            idPag = rand( ) % NUM_HOT ;
+         } /* if */
+         checkSum += pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( )[ 0 ] ;
+      } /* for */
+
+      std::chrono::duration< double > elapsed = std::chrono::steady_clock::now( ) - start ;
+
+      double hitRate = pRoot->GetTotalHits( ) * 100.0 / pRoot->GetTotalAccesses( ) ;
+      printf( "%-6s %-6s %8.2f%% %10.1f ns/access   (%ld)\n" ,
+              vtPolicyName[ policy ] , vtWorkloadName[ workload ] , hitRate ,
+              elapsed.count( ) * 1e9 / NUM_ACCESSES , checkSum ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Benchmark driver -----
+//==========================================================================
+
+   int main( )
+   {
+      printf( "%d frames, %d pages, hot set %d pages, %d accesses\n" ,
+              NUM_FRAMES , NUM_PAGES , NUM_HOT , NUM_ACCESSES ) ;
+      printf( "policy workload  hit rate       time\n" ) ;
+
+      VMC_tpReplacementPolicy vtPolicy[ ] = { VMC_REPLACE_LRU , VMC_REPLACE_CLOCK ,
+                                              VMC_REPLACE_2Q } ;
+      for ( int inxWorkload = WORKLOAD_HOT ; inxWorkload <= WORKLOAD_MIXED ; inxWorkload++ )
+      {
+         for ( int inxPolicy = 0 ; inxPolicy < 3 ; inxPolicy++ )
+         {
+            RunWorkload( vtPolicy[ inxPolicy ] , static_cast< tpWorkload >( inxWorkload )) ;
+         } /* for */
+      } /* for */
+      return 0 ;
+   }
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: EXC exceptions
+//    Exceptions are thrown as pointers, as in Talisman. EXC_LOG counts
+//    the logged verification failures.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _EXCEPTN_
+#define _EXCEPTN_
+
+   #include "message.hpp"
+
+   enum EXC_tpKind
+   {
+      EXC_KindProgram ,
+      EXC_KindUsage ,
+      EXC_KindError
+   }  ;
+
+   class EXC_Exception
+   {
+      public:
+         EXC_Exception( MSG_Message * pMsgParm , EXC_tpKind kindParm )
+                   : pMsg( pMsgParm ) , kind( kindParm ) { }
+         virtual ~EXC_Exception( ) { delete pMsg ; }
+         int GetIdMsg( ) { return pMsg != 0 ? pMsg->GetIdMsg( ) : 0 ; }
+         EXC_tpKind GetKind( ) { return kind ; }
+      private:
+         MSG_Message * pMsg ;
+         EXC_tpKind kind ;
+   }  ;
+
+   class EXC_Error : public EXC_Exception
+   {
+      public:
+         EXC_Error( MSG_Message * pMsgParm ) : EXC_Exception( pMsgParm , EXC_KindError ) { }
+   }  ;
+
+   void EXC_LogFn( MSG_Message * pMsg , int idCode ) ;
+
+   #define EXC_PROGRAM( pMsg , idCode , idHelp ) \
+      throw new EXC_Exception( pMsg , EXC_KindProgram )
+   #define EXC_USAGE( pMsg , idCode , idHelp ) \
+      throw new EXC_Exception( pMsg , EXC_KindUsage )
+   #define EXC_ERROR( pMsg , idCode , idHelp ) \
+      throw new EXC_Error( pMsg )
+   #define EXC_LOG( pMsg , idCode ) \
+      EXC_LogFn( pMsg , idCode )
+
+#endif
@@ -0,0 +1,532 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: implementation of the Talisman services used by the
+//             virtual memory module
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <stdlib.h>
+   #include  <string.h>
+   #include  <unistd.h>
+   #include  <fcntl.h>
+
+   #include  <thread>
+   #include  <chrono>
+
+   #include "segment.hpp"
+   #include "logger.hpp"
+   #include "global.hpp"
+   #include "exceptn.hpp"
+   #include "str_vmc.inc"
+
+   #include "fake.hpp"
+
+//==========================================================================
+//----- Test counters -----
+//==========================================================================
+
+   int FAK_NumLoggedErrors = 0 ;
+   int FAK_LastLoggedCode  = 0 ;
+   int FAK_NumOverlaps     = 0 ;
+
+   std::string FAK_LogText ;
+
+   static SEG_SegmentRoot * pSegmentRoot = NULL ;
+
+   static GLB_Global theGlobal ;
+   static LOG_Logger theLogger ;
+
+//==========================================================================
+//----- Call overlap detection -----
+//==========================================================================
+
+   struct CallGuard
+   {
+      SEG_SegmentRoot * pRoot ;
+      CallGuard( SEG_SegmentRoot * pRootParm ) : pRoot( pRootParm )
+      {
+         if ( pRoot->numInCall.fetch_add( 1 ) != 0 )
+         {
+            pRoot->numOverlaps ++ ;
+         } /* if */
+      }
+     ~CallGuard( )
+      {
+         pRoot->numInCall -- ;
+      }
+   }  ;
+
+//==========================================================================
+//----- Segments -----
+//==========================================================================
+
+   void SEG_Segment :: IncreaseNumOpenPages( )
+   {
+      CallGuard guard( SEG_SegmentRoot::GetRoot( )) ;
+      numOpenPages ++ ;
+   }
+
+   void SEG_Segment :: DecreaseNumOpenPages( )
+   {
+      CallGuard guard( SEG_SegmentRoot::GetRoot( )) ;
+      numOpenPages -- ;
+   }
+
+   void SEG_SegmentRoot :: CreateRoot( )
+   {
+      if ( pSegmentRoot == NULL )
+      {
+         pSegmentRoot = new SEG_SegmentRoot ;
+         pSegmentRoot->numInCall    = 0 ;
+         pSegmentRoot->numOverlaps  = 0 ;
+         pSegmentRoot->transferDelay = 0 ;
+         pSegmentRoot->totalRead    = 0 ;
+         pSegmentRoot->totalWritten = 0 ;
+         pSegmentRoot->totalAdded   = 0 ;
+      } /* if */
+   }
+
+   void SEG_SegmentRoot :: DestroyRoot( )
+   {
+      if ( pSegmentRoot != NULL )
+      {
+         FAK_NumOverlaps += pSegmentRoot->numOverlaps ;
+         for ( std::map< int , SEG_Segment * >::iterator it =
+                     pSegmentRoot->mapSegment.begin( ) ;
+               it != pSegmentRoot->mapSegment.end( ) ; it++ )
+         {
+            delete it->second ;
+         } /* for */
+         delete pSegmentRoot ;
+         pSegmentRoot = NULL ;
+      } /* if */
+   }
+
+   SEG_SegmentRoot * SEG_SegmentRoot :: GetRoot( )
+   {
+      return pSegmentRoot ;
+   }
+
+   static SEG_Segment * FindSegment( int idSeg )
+   {
+      std::map< int , SEG_Segment * >::iterator it =
+                pSegmentRoot->mapSegment.find( idSeg ) ;
+      if ( it == pSegmentRoot->mapSegment.end( ))
+      {
+         EXC_PROGRAM( new MSG_Message( VMC_NullSegment ) , 1 , TAL_NullIdHelp ) ;
+      } /* if */
+      return it->second ;
+   }
+
+   static bool IsFileSegment( SEG_Segment * pSeg )
+   {
+      return pSeg->name[ 0 ] == '/' ;
+   }
+
+   static void TransferFilePage( SEG_Segment * pSeg , int idPag , void * pValue ,
+                                 bool isWrite )
+   {
+      int hFile = open( pSeg->name.c_str( ) , isWrite ? O_RDWR : O_RDONLY ) ;
+      if ( hFile < 0 )
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorOpening ) , 2 , TAL_NullIdHelp ) ;
+      } /* if */
+      off_t offset = pSeg->fileOffset + ( off_t ) idPag * TAL_PageSize ;
+      ssize_t size = isWrite ? pwrite( hFile , pValue , TAL_PageSize , offset )
+                             : pread(  hFile , pValue , TAL_PageSize , offset ) ;
+      if ( isWrite )
+      {
+         fdatasync( hFile ) ;
+      } /* if */
+      close( hFile ) ;
+      if ( size != TAL_PageSize )
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorOpening ) , 3 , TAL_NullIdHelp ) ;
+      } /* if */
+   }
+
+   void SEG_SegmentRoot :: ReadPage( int idSeg , int idPag , void * pValue )
+   {
+      CallGuard guard( this ) ;
+      SEG_Segment * pSeg = FindSegment( idSeg ) ;
+      if ( transferDelay > 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::microseconds( transferDelay )) ;
+      } /* if */
+      if ( pSeg->isReadFailing || idPag < 0 ||
+           idPag >= static_cast< int >( pSeg->vtPage.size( )))
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorPageFrame ) , 4 , TAL_NullIdHelp ) ;
+      } /* if */
+      if ( IsFileSegment( pSeg ))
+      {
+         TransferFilePage( pSeg , idPag , pValue , false ) ;
+      } else
+      {
+         memcpy( pValue , &pSeg->vtPage[ idPag ][ 0 ] , TAL_PageSize ) ;
+      } /* if */
+      totalRead ++ ;
+   }
+
+   void SEG_SegmentRoot :: WritePage( int idSeg , int idPag , void * pValue )
+   {
+      CallGuard guard( this ) ;
+      SEG_Segment * pSeg = FindSegment( idSeg ) ;
+      if ( transferDelay > 0 )
+      {
+         std::this_thread::sleep_for( std::chrono::microseconds( transferDelay )) ;
+      } /* if */
+      if ( pSeg->mode == TAL_OpeningModeRead || idPag < 0 ||
+           idPag >= static_cast< int >( pSeg->vtPage.size( )))
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorReadOnly ) , 5 , TAL_NullIdHelp ) ;
+      } /* if */
+      memcpy( &pSeg->vtPage[ idPag ][ 0 ] , pValue , TAL_PageSize ) ;
+      if ( IsFileSegment( pSeg ))
+      {
+         TransferFilePage( pSeg , idPag , pValue , true ) ;
+      } /* if */
+      totalWritten ++ ;
+   }
+
+   void SEG_SegmentRoot :: AddPage( int idSeg , void * pValue )
+   {
+      CallGuard guard( this ) ;
+      SEG_Segment * pSeg = FindSegment( idSeg ) ;
+      if ( pSeg->mode == TAL_OpeningModeRead )
+      {
+         EXC_ERROR( new MSG_Message( VMC_ErrorReadOnly ) , 6 , TAL_NullIdHelp ) ;
+      } /* if */
+      const char * pBytes = static_cast< const char * >( pValue ) ;
+      pSeg->vtPage.push_back( std::vector< char >( pBytes , pBytes + TAL_PageSize )) ;
+      if ( IsFileSegment( pSeg ))
+      {
+         TransferFilePage( pSeg , static_cast< int >( pSeg->vtPage.size( )) - 1 ,
+                           pValue , true ) ;
+      } /* if */
+      totalAdded ++ ;
+   }
+
+   void SEG_SegmentRoot :: CloseSegment( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      std::map< int , SEG_Segment * >::iterator it = mapSegment.find( idSeg ) ;
+      if ( it != mapSegment.end( ))
+      {
+         delete it->second ;
+         mapSegment.erase( it ) ;
+      } /* if */
+   }
+
+   int SEG_SegmentRoot :: GetNextIdSegment( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      std::map< int , SEG_Segment * >::iterator it = mapSegment.upper_bound( idSeg ) ;
+      return it == mapSegment.end( ) ? TAL_NullIdSeg : it->first ;
+   }
+
+   SEG_Segment * SEG_SegmentRoot :: GetSegment( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return FindSegment( idSeg ) ;
+   }
+
+   STR_String * SEG_SegmentRoot :: GetSegmentFileName( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      std::string name = FindSegment( idSeg )->name ;
+      size_t inxSlash = name.rfind( '/' ) ;
+      return new STR_String( inxSlash == std::string::npos ? name.c_str( )
+                                       : name.c_str( ) + inxSlash + 1 ) ;
+   }
+
+   STR_String * SEG_SegmentRoot :: GetSegmentFullName( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return new STR_String( FindSegment( idSeg )->name.c_str( )) ;
+   }
+
+   int SEG_SegmentRoot :: GetSegmentNumPages( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return static_cast< int >( FindSegment( idSeg )->vtPage.size( )) ;
+   }
+
+   TAL_tpOpeningMode SEG_SegmentRoot :: GetSegmentOpeningMode( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return FindSegment( idSeg )->mode ;
+   }
+
+   bool SEG_SegmentRoot :: VerifyIdSeg( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return mapSegment.find( idSeg ) != mapSegment.end( ) ;
+   }
+
+   int SEG_SegmentRoot :: GetTotalPagesRead( )
+   {
+      return totalRead ;
+   }
+
+   int SEG_SegmentRoot :: GetTotalPagesWritten( )
+   {
+      return totalWritten ;
+   }
+
+   int SEG_SegmentRoot :: GetTotalPagesAdded( )
+   {
+      return totalAdded ;
+   }
+
+   void SEG_SegmentRoot :: StartOpenPageCounter( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      FindSegment( idSeg )->openPageCounter = 0 ;
+   }
+
+   void SEG_SegmentRoot :: CountOpenPage( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      FindSegment( idSeg )->openPageCounter ++ ;
+   }
+
+   int SEG_SegmentRoot :: GetOpenPageCounter( int idSeg )
+   {
+      CallGuard guard( this ) ;
+      return FindSegment( idSeg )->openPageCounter ;
+   }
+
+   void SEG_SegmentRoot :: StartAllCounters( )
+   {
+      CallGuard guard( this ) ;
+      for ( std::map< int , SEG_Segment * >::iterator it = mapSegment.begin( ) ;
+            it != mapSegment.end( ) ; it++ )
+      {
+         it->second->openPageCounter = 0 ;
+      } /* for */
+   }
+
+   int SEG_SegmentRoot :: VerifyOpenPageCounters( TAL_tpVerifyMode verifyMode )
+   {
+      CallGuard guard( this ) ;
+      int numErrors = 0 ;
+      for ( std::map< int , SEG_Segment * >::iterator it = mapSegment.begin( ) ;
+            it != mapSegment.end( ) ; it++ )
+      {
+         if ( it->second->openPageCounter != it->second->numOpenPages )
+         {
+            numErrors ++ ;
+         } /* if */
+      } /* for */
+      return numErrors ;
+   }
+
+   void SEG_SegmentRoot :: ResetOpenPages( )
+   {
+      CallGuard guard( this ) ;
+      for ( std::map< int , SEG_Segment * >::iterator it = mapSegment.begin( ) ;
+            it != mapSegment.end( ) ; it++ )
+      {
+         it->second->numOpenPages = 0 ;
+      } /* for */
+   }
+
+//==========================================================================
+//----- Test only segment operations -----
+//==========================================================================
+
+   char SEG_SegmentRoot :: GetInitialByte( int idSeg , int idPag , int inxByte )
+   {
+      return static_cast< char >( idSeg * 31 + idPag * 7 + inxByte ) ;
+   }
+
+   int SEG_SegmentRoot :: OpenSegment( const char * name , int numPages ,
+                                       TAL_tpOpeningMode mode , long fileOffset )
+   {
+      int idSeg = mapSegment.empty( ) ? 1 : mapSegment.rbegin( )->first + 1 ;
+
+      SEG_Segment * pSeg = new SEG_Segment ;
+      pSeg->name            = name ;
+      pSeg->mode            = mode ;
+      pSeg->fileOffset      = fileOffset ;
+      pSeg->numOpenPages    = 0 ;
+      pSeg->openPageCounter = 0 ;
+      pSeg->isReadFailing   = false ;
+
+      for ( int idPag = 0 ; idPag < numPages ; idPag++ )
+      {
+         std::vector< char > vtValue( TAL_PageSize ) ;
+         for ( int inxByte = 0 ; inxByte < TAL_PageSize ; inxByte++ )
+         {
+            vtValue[ inxByte ] = GetInitialByte( idSeg , idPag , inxByte ) ;
+         } /* for */
+         pSeg->vtPage.push_back( vtValue ) ;
+      } /* for */
+
+      if ( name[ 0 ] == '/' )
+      {
+         int hFile = open( name , O_RDWR | O_CREAT | O_TRUNC , 0644 ) ;
+         if ( hFile < 0 )
+         {
+            delete pSeg ;
+            return TAL_NullIdSeg ;
+         } /* if */
+         std::vector< char > vtHeader( fileOffset + 1 , 'H' ) ;
+         if ( fileOffset > 0 )
+         {
+            pwrite( hFile , &vtHeader[ 0 ] , fileOffset , 0 ) ;
+         } /* if */
+         for ( int idPag = 0 ; idPag < numPages ; idPag++ )
+         {
+            pwrite( hFile , &pSeg->vtPage[ idPag ][ 0 ] , TAL_PageSize ,
+                    fileOffset + ( off_t ) idPag * TAL_PageSize ) ;
+         } /* for */
+         close( hFile ) ;
+      } /* if */
+
+      mapSegment[ idSeg ] = pSeg ;
+      return idSeg ;
+   }
+
+   char * SEG_SegmentRoot :: GetPageBytes( int idSeg , int idPag )
+   {
+      SEG_Segment * pSeg = FindSegment( idSeg ) ;
+      if ( IsFileSegment( pSeg ))
+      {
+         TransferFilePage( pSeg , idPag , &pSeg->vtPage[ idPag ][ 0 ] , false ) ;
+      } /* if */
+      return &pSeg->vtPage[ idPag ][ 0 ] ;
+   }
+
+   void SEG_SegmentRoot :: SetReadFailing( int idSeg , bool isFailing )
+   {
+      FindSegment( idSeg )->isReadFailing = isFailing ;
+   }
+
+   void SEG_SegmentRoot :: SetTransferDelay( int delayMicroseconds )
+   {
+      transferDelay = delayMicroseconds ;
+   }
+
+   int SEG_SegmentRoot :: GetNumOverlaps( )
+   {
+      return numOverlaps ;
+   }
+
+//==========================================================================
+//----- Strings, logger and exceptions -----
+//==========================================================================
+
+   struct StringEntry
+   {
+      int idString ;
+      const char * pText ;
+   }  ;
+
+   static const StringEntry vtString[ ] =
+   {
+      { VMC_ErrorOpening          , "Error opening file" } ,
+      { VMC_ErrorLogFailed        , "Redo log failed, page not written" } ,
+      { VMC_ErrorPageFrame        , "Page frame error" } ,
+      { VMC_ErrorReadOnly         , "Segment is read only" } ,
+      { VMC_ErrorRootElemVerify   , "Root element verification error" } ,
+      { VMC_ErrorRootVerify       , "Root verification error" } ,
+      { VMC_FormatFrameHead       , "Frame %4d  %-30s  page %6d  pins %3d  %s  type %d" } ,
+      { VMC_FormatIgnorable       , "ignorable" } ,
+      { VMC_FormatIsDirty         , "dirty" } ,
+      { VMC_FormatNotDirty        , "clean" } ,
+      { VMC_FormatPinElem         , "%s(%d):%d  " } ,
+      { VMC_FormatPinEmpty        , "    No pinned frames" } ,
+      { VMC_FormatPinList         , "Pinned frames" } ,
+      { VMC_FormatStat2Q          , "   2Q: A1in frames %d of %d, ghost entries %d, ghost hits %d" } ,
+      { VMC_FormatStatAccess      , "  Accesses %d  replaces %d  hits %d  hit rate %.2f%%" } ,
+      { VMC_FormatStatArena       , "   Frame arena: buffers %d, stride %d, mapped %d KiB, %s pages%s" } ,
+      { VMC_FormatStatChecksum    , "   Checksums: pages %d, mismatches %d, unverified %d" } ,
+      { VMC_FormatStatCleaner     , "   Tail cleaner: scans %d, cleanings %d, pages written %d, failures %d" } ,
+      { VMC_FormatStatDirectIo    , "   Direct I/O: segments %d, pages read %d, written %d, fallbacks %d" } ,
+      { VMC_FormatStatFlush       , "   Flush: pages written %d in %d runs" } ,
+      { VMC_FormatStatFlusher     , "   Flusher: passes %d, flushes %d, pages written %d, failures %d" } ,
+      { VMC_FormatStatLog         , "   Redo log: records %d, commits %d, syncs %d, checkpoints %d, KiB %d" } ,
+      { VMC_FormatStatLookaside   , "   Lookaside: searches %d, hits %d, hit rate %5.2f%%" } ,
+      { VMC_FormatStatMapped      , "   Mapped segments: %d, pages mapped %d" } ,
+      { VMC_FormatStatPageIn      , "   Page in: threads %d, reads %d, max in flight %d" } ,
+      { VMC_FormatStatPageTable   , "   Page table: slots %d, entries %d, probe length max %d mean %5.2f, direct maps %d" } ,
+      { VMC_FormatStatPins        , "  Page size %d  frames %d  used %d  pinned %d  max pinned %d" } ,
+      { VMC_FormatStatPool        , "   Frame pool: frames %d, min %d, max %d, grown %d, released %d" } ,
+      { VMC_FormatStatReadAhead   , "   Read ahead: max window %d, pages read %d, hits %d, wasted %d" } ,
+      { VMC_FormatStatTier        , "   Compressed tier: KiB %d, pages %d, hits %d, misses %d, stored %d, dropped %d, ratio %.2f" } ,
+      { VMC_FormatStatTitle       , "Virtual memory statistics" } ,
+      { VMC_FormatStatTotals      , "  Pages read %d  written %d  added %d" } ,
+      { VMC_FormatStatWriteBehind , "   Write behind: pages scheduled %d" } ,
+      { VMC_InsufficientFrames    , "Insufficient page frames" } ,
+      { VMC_NoFreeFrame           , "No free page frame" } ,
+      { VMC_NullSegment           , "<null segment>" } ,
+      { VMC_TooManyPins           , "Too many pins" }
+   }  ;
+
+   const char * STR_GetStringAddress( int idString )
+   {
+      for ( size_t inx = 0 ; inx < sizeof( vtString ) / sizeof( vtString[ 0 ] ) ; inx++ )
+      {
+         if ( vtString[ inx ].idString == idString )
+         {
+            return vtString[ inx ].pText ;
+         } /* if */
+      } /* for */
+      fprintf( stderr , "Missing string %d\n" , idString ) ;
+      abort( ) ;
+   }
+
+   STR_String :: STR_String( int idString )
+               : value( STR_GetStringAddress( idString ))
+   {
+   }
+
+   void STR_ConvertToPrintable( int length , const char * pString ,
+                                int dimBuffer , char * pBuffer ,
+                                bool isQuoted )
+   {
+      int size = length < dimBuffer - 1 ? length : dimBuffer - 1 ;
+      for ( int inx = 0 ; inx < size ; inx++ )
+      {
+         pBuffer[ inx ] = ( pString[ inx ] >= ' ' && pString[ inx ] < 127 ) ?
+                          pString[ inx ] : '.' ;
+      } /* for */
+      pBuffer[ size ] = 0 ;
+   }
+
+   void LOG_Logger :: Log( const char * pText , bool isNewLine )
+   {
+      FAK_LogText += pText ;
+      if ( isNewLine )
+      {
+         FAK_LogText += "\n" ;
+      } /* if */
+   }
+
+   void LOG_Logger :: LogDataSpace( int inxFirst , int inxLimit ,
+                                    const void * pData , int BytesPerLine )
+   {
+      char buffer[ 16 ] ;
+      snprintf( buffer , sizeof( buffer ) , "<%d bytes>" , inxLimit - inxFirst ) ;
+      Log( buffer ) ;
+   }
+
+   LOG_Logger * GLB_Global :: GetEventLogger( )
+   {
+      return &theLogger ;
+   }
+
+   GLB_Global * GLB_GetGlobal( )
+   {
+      return &theGlobal ;
+   }
+
+   void EXC_LogFn( MSG_Message * pMsg , int idCode )
+   {
+      FAK_NumLoggedErrors ++ ;
+      FAK_LastLoggedCode = idCode ;
+   }
+
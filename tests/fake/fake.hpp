@@ -0,0 +1,35 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: counters observed by the tests and the test assertion
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _FAKE_
+#define _FAKE_
+
+   #include  <stdio.h>
+   #include  <stdlib.h>
+   #include  <string>
+
+// Verification failures passed to EXC_LOG
+
+   extern int FAK_NumLoggedErrors ;
+   extern int FAK_LastLoggedCode ;
+
+// Overlapping SEG calls counted by segment roots already destroyed
+
+   extern int FAK_NumOverlaps ;
+
+// Text written to the event logger
+
+   extern std::string FAK_LogText ;
+
+   #define  TST_ASSERT( Condition )                                 \
+      if ( !( Condition ))                                          \
+      {                                                             \
+         fprintf( stderr , "%s(%d): failed: %s\n" ,                 \
+                  __FILE__ , __LINE__ , #Condition ) ;              \
+         exit( 1 ) ;                                                \
+      } /* if */
+
+#endif
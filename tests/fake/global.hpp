@@ -0,0 +1,26 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: global objects and string table access
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _GLOBAL_
+#define _GLOBAL_
+
+   #include "logger.hpp"
+
+   class GLB_Global
+   {
+      public:
+         LOG_Logger * GetEventLogger( ) ;
+   }  ;
+
+   GLB_Global * GLB_GetGlobal( ) ;
+
+   const char * STR_GetStringAddress( int idString ) ;
+
+   void STR_ConvertToPrintable( int length , const char * pString ,
+                                int dimBuffer , char * pBuffer ,
+                                bool isQuoted ) ;
+
+#endif
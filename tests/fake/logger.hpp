@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: event logger, writes to stdout when verbose
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _LOGGER_
+#define _LOGGER_
+
+   class LOG_Logger
+   {
+      public:
+         void Log( const char * pText , bool isNewLine = true ) ;
+         void LogDataSpace( int inxFirst , int inxLimit ,
+                            const void * pData , int idType ) ;
+   }  ;
+
+#endif
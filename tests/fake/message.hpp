@@ -0,0 +1,27 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: MSG messages, keep their id only
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MESSAGE_
+#define _MESSAGE_
+
+   class MSG_Item
+   {
+      public:
+         virtual ~MSG_Item( ) { }
+   }  ;
+
+   class MSG_Message
+   {
+      public:
+         MSG_Message( int idMsgParm ) : idMsg( idMsgParm ) { }
+         ~MSG_Message( ) { }
+         void AddItem( int inxItem , MSG_Item * pItem ) { delete pItem ; }
+         int GetIdMsg( ) { return idMsg ; }
+      private:
+         int idMsg ;
+   }  ;
+
+#endif
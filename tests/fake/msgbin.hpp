@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: MSG integer items
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _MSGBIN_
+#define _MSGBIN_
+
+   #include "message.hpp"
+
+   class MSG_ItemInteger : public MSG_Item
+   {
+      public:
+         MSG_ItemInteger( long long value ) { }
+   }  ;
+
+#endif
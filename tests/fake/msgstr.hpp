@@ -0,0 +1 @@
+// Test fake: MSG string items, unused by the virtual memory module
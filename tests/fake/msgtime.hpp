@@ -0,0 +1 @@
+// Test fake: MSG time items, unused by the virtual memory module
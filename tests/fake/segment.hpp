@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: SEG segments
+//    Segments are vectors of TAL_PageSize pages kept in memory. A segment
+//    whose name starts with '/' is also written through to that file,
+//    page i at byte fileOffset + i * TAL_PageSize, hence the mapped and
+//    direct I/O modes can be exercised.
+//    Page j of segment s is created filled with GetInitialByte( s , j , k ).
+//    Like the real module, the fake is not thread safe. Every call
+//    counts as an overlap if another call is in progress, a test fails
+//    if any overlap is counted.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SEGMENT_
+#define _SEGMENT_
+
+   #include <map>
+   #include <vector>
+   #include <string>
+   #include <atomic>
+
+   #include "talisman_constants.inc"
+   #include "str_string.hpp"
+
+   class SEG_Segment
+   {
+      public:
+         void IncreaseNumOpenPages( ) ;
+         void DecreaseNumOpenPages( ) ;
+
+      public:
+         std::string name ;
+         TAL_tpOpeningMode mode ;
+         std::vector< std::vector< char > > vtPage ;
+         long fileOffset ;
+         int numOpenPages ;
+         int openPageCounter ;
+         bool isReadFailing ;
+   }  ;
+
+   class SEG_SegmentRoot
+   {
+      public:
+         static void CreateRoot( ) ;
+         static void DestroyRoot( ) ;
+         static SEG_SegmentRoot * GetRoot( ) ;
+
+         void ReadPage( int idSeg , int idPag , void * pValue ) ;
+         void WritePage( int idSeg , int idPag , void * pValue ) ;
+         void AddPage( int idSeg , void * pValue ) ;
+         void CloseSegment( int idSeg ) ;
+         int GetNextIdSegment( int idSeg ) ;
+         SEG_Segment * GetSegment( int idSeg ) ;
+         STR_String * GetSegmentFileName( int idSeg ) ;
+         STR_String * GetSegmentFullName( int idSeg ) ;
+         int GetSegmentNumPages( int idSeg ) ;
+         TAL_tpOpeningMode GetSegmentOpeningMode( int idSeg ) ;
+         bool VerifyIdSeg( int idSeg ) ;
+
+         int GetTotalPagesRead( ) ;
+         int GetTotalPagesWritten( ) ;
+         int GetTotalPagesAdded( ) ;
+
+         void StartOpenPageCounter( int idSeg ) ;
+         void CountOpenPage( int idSeg ) ;
+         int GetOpenPageCounter( int idSeg ) ;
+         void StartAllCounters( ) ;
+         int VerifyOpenPageCounters( TAL_tpVerifyMode verifyMode ) ;
+         void ResetOpenPages( ) ;
+
+      // Test only operations
+
+         int OpenSegment( const char * name , int numPages ,
+                          TAL_tpOpeningMode mode = TAL_OpeningModeWrite ,
+                          long fileOffset = 0 ) ;
+         static char GetInitialByte( int idSeg , int idPag , int inxByte ) ;
+         char * GetPageBytes( int idSeg , int idPag ) ;
+         void SetReadFailing( int idSeg , bool isFailing ) ;
+         void SetTransferDelay( int delayMicroseconds ) ;
+         int GetNumOverlaps( ) ;
+
+      public:
+         std::atomic< int > numInCall ;
+         std::atomic< int > numOverlaps ;
+         int transferDelay ;
+         int totalRead ;
+         int totalWritten ;
+         int totalAdded ;
+         std::map< int , SEG_Segment * > mapSegment ;
+   }  ;
+
+#endif
@@ -0,0 +1,18 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: SEG message items
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _SEGMSG_
+#define _SEGMSG_
+
+   #include "message.hpp"
+
+   class SEG_ItemSegmentFullName : public MSG_Item
+   {
+      public:
+         SEG_ItemSegmentFullName( int idSeg ) { }
+   }  ;
+
+#endif
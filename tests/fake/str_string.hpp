@@ -0,0 +1,23 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test fake: STR strings
+//
+////////////////////////////////////////////////////////////////////////////
+
+#ifndef _STR_STRING_
+#define _STR_STRING_
+
+   #include <string>
+
+   class STR_String
+   {
+      public:
+         STR_String( int idString ) ;
+         STR_String( const char * pString ) : value( pString ) { }
+         int GetLength( ) { return static_cast< int >( value.size( )) ; }
+         const char * GetString( ) { return value.c_str( ) ; }
+      private:
+         std::string value ;
+   }  ;
+
+#endif
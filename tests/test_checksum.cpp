@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMS  Page checksums
+//
+//  The checksums of a segment file are saved in its checksum file when
+//  the segment is removed, and verify the pages read afterwards. A page
+//  corrupted behind the segment module is a mismatch, while a segment
+//  file changed since the checksums were saved makes them ignored. Pages
+//  read without a checksum are counted as unverified.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <sys/stat.h>
+   #include  <fcntl.h>
+   #include  <unistd.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 8 ;
+   static const int NUM_PAGES  = 32 ;
+   static const int ID_CORRUPT = 3 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void ReadPages( int idSeg )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      for ( int idPag = 0 ; idPag < NUM_PAGES ; idPag++ )
+      {
+         pRoot->GetPageFrame( idSeg , idPag ) ;
+      } /* for */
+   }
+
+   // Overwrites a byte of a page in the file, with the modification time
+   // moved by deltaSeconds
+
+   static void ChangeFile( const std::string & fileName , int idPag ,
+                           time_t deltaSeconds )
+   {
+      int hFile = open( fileName.c_str( ) , O_RDWR ) ;
+      TST_ASSERT( hFile >= 0 ) ;
+
+      struct stat fileStatus ;
+      TST_ASSERT( fstat( hFile , &fileStatus ) == 0 ) ;
+
+      char value = '#' ;
+      TST_ASSERT( pwrite( hFile , &value , 1 , ( off_t ) idPag * TAL_PageSize + 10 ) == 1 ) ;
+
+      struct timespec vtTime[ 2 ] ;
+      vtTime[ 0 ] = fileStatus.st_atim ;
+      vtTime[ 1 ] = fileStatus.st_mtim ;
+      vtTime[ 1 ].tv_sec += deltaSeconds ;
+      TST_ASSERT( futimens( hFile , vtTime ) == 0 ) ;
+      close( hFile ) ;
+   }
+
+   static bool IsLogged( const char * pText )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+      return FAK_LogText.find( pText ) != std::string::npos ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      char directory[ 1024 ] ;
+      TST_ASSERT( getcwd( directory , sizeof( directory )) != NULL ) ;
+      std::string fileName     = std::string( directory ) + "/test_checksum.seg" ;
+      std::string checksumName = fileName + ".crc" ;
+      unlink( checksumName.c_str( )) ;
+
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( fileName.c_str( ) , NUM_PAGES ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+
+   // Pages read before any checksum is known are unverified
+
+      pRoot->SetChecksumMode( VMC_CHECKSUM_COUNT ) ;
+      ReadPages( idSeg ) ;
+      TST_ASSERT( IsLogged( "Checksums: pages 32, mismatches 0, unverified 32" )) ;
+      pRoot->RemoveSegment( idSeg ) ;
+
+      struct stat checksumStatus ;
+      TST_ASSERT( stat( checksumName.c_str( ) , &checksumStatus ) == 0 ) ;
+
+   // A page corrupted behind the segment module, leaving the file as it
+   // was, is a mismatch
+
+      ChangeFile( fileName , ID_CORRUPT , 0 ) ;
+      ReadPages( idSeg ) ;
+      TST_ASSERT( IsLogged( "Checksums: pages 64, mismatches 1, unverified 32" )) ;
+      pRoot->RemoveSegment( idSeg ) ;
+
+   // Checksums saved before the segment file changed are ignored
+
+      ChangeFile( fileName , ID_CORRUPT + 1 , -1 ) ;
+      ReadPages( idSeg ) ;
+      TST_ASSERT( IsLogged( "Checksums: pages 96, mismatches 1, unverified 64" )) ;
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+
+      unlink( fileName.c_str( )) ;
+      unlink( checksumName.c_str( )) ;
+
+      TST_ASSERT( FAK_NumOverlaps == 0 ) ;
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_checksum: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,115 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMZ  Compressed tier
+//
+//  Clean victims are kept compressed and serve later misses. A page
+//  changed after it was stored must never be served from the tier, a
+//  page that does not compress must round trip, and a full tier must
+//  drop pages without losing values.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+   #include  <stdlib.h>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 8 ;
+   static const int NUM_PAGES  = 64 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void ReadPages( int idSeg , int idFirst , int idLimit )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      for ( int idPag = idFirst ; idPag < idLimit ; idPag++ )
+      {
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         for ( int inxByte = 0 ; inxByte < TAL_PageSize ; inxByte += 61 )
+         {
+            TST_ASSERT( pValue[ inxByte ] ==
+                        SEG_SegmentRoot::GetInitialByte( idSeg , idPag , inxByte )) ;
+         } /* for */
+      } /* for */
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( "tier" , NUM_PAGES ) ;
+
+      int numHits ;
+      int numMisses ;
+      int numStored ;
+      int numDropped ;
+
+   // Misses of clean victims are served by the tier
+
+      pRoot->SetCompressedTier( 1024 ) ;
+      ReadPages( idSeg , 0 , NUM_PAGES ) ;
+
+      int numReads = pSegRoot->GetTotalPagesRead( ) ;
+      ReadPages( idSeg , 0 , NUM_PAGES - NUM_FRAMES ) ;
+
+      pRoot->GetCompressedTierCounters( &numHits , &numMisses , &numStored , &numDropped ) ;
+      TST_ASSERT( numHits == NUM_PAGES - NUM_FRAMES ) ;
+      TST_ASSERT( numStored >= NUM_PAGES - NUM_FRAMES ) ;
+      TST_ASSERT( numDropped == 0 ) ;
+      TST_ASSERT( pSegRoot->GetTotalPagesRead( ) == numReads ) ;
+
+   // A changed page is read back changed, never from its stored copy
+
+      char value = 'Z' ;
+      pRoot->GetPageFrame( idSeg , 2 )->SetPageData( 10 , 1 , &value ) ;
+      ReadPages( idSeg , 20 , 20 + 2 * NUM_FRAMES ) ;
+      TST_ASSERT( !pRoot->IsPageInMemory( idSeg , 2 )) ;
+      TST_ASSERT( pRoot->GetPageFrame( idSeg , 2 )->GetPageValue( )[ 10 ] == 'Z' ) ;
+      TST_ASSERT( pSegRoot->GetPageBytes( idSeg , 2 )[ 10 ] == 'Z' ) ;
+
+   // A page that does not compress round trips
+
+      char vtRandom[ TAL_PageSize ] ;
+      srand( 3 ) ;
+      for ( int inxByte = 0 ; inxByte < TAL_PageSize ; inxByte++ )
+      {
+         vtRandom[ inxByte ] = static_cast< char >( rand( )) ;
+      } /* for */
+      pRoot->GetPageFrame( idSeg , 5 )->SetPageData( 0 , TAL_PageSize , vtRandom ) ;
+      pRoot->WriteAllPageFrames( ) ;
+      ReadPages( idSeg , 30 , 30 + 2 * NUM_FRAMES ) ;
+      TST_ASSERT( memcmp( pRoot->GetPageFrame( idSeg , 5 )->GetPageValue( ) ,
+                          vtRandom , TAL_PageSize ) == 0 ) ;
+
+   // A full tier drops pages, their values come from the segment
+
+      pRoot->SetCompressedTier( 1 ) ;
+      ReadPages( idSeg , 40 , NUM_PAGES ) ;
+      ReadPages( idSeg , 40 , NUM_PAGES ) ;
+      pRoot->GetCompressedTierCounters( &numHits , &numMisses , &numStored , &numDropped ) ;
+      TST_ASSERT( numDropped > 0 ) ;
+      TST_ASSERT( numMisses > 0 ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( FAK_LogText.find( "Compressed tier: KiB" ) != std::string::npos ) ;
+
+      pRoot->SetCompressedTier( 0 ) ;
+      pRoot->GetCompressedTierCounters( &numHits , &numMisses , &numStored , &numDropped ) ;
+      TST_ASSERT( numHits + numMisses + numStored + numDropped == 0 ) ;
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_compressed_tier: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMR  Dirty frame set
+//
+//  Writing all page frames of a large pool must write exactly the few
+//  dirty ones, in runs of adjacent pages. A page of a segment opened for
+//  reading must refuse changes, ignorable ones excepted. Writing with a
+//  sync must sync the buffered segments written.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <unistd.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "exceptn.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 4096 ;
+   static const int NUM_PAGES  = 4096 ;
+   static const int NUM_DIRTY  = 5 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static int GetDirtyPage( int inxDirty )
+   {
+      return 17 + inxDirty * 701 ;
+   }
+
+   static bool IsLogged( const char * pText )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+      return FAK_LogText.find( pText ) != std::string::npos ;
+   }
+
+   // A buffered segment written is synced by its file name, hence a sync
+   // fails once the file is removed
+
+   static void TestSync( )
+   {
+      char directory[ 1024 ] ;
+      TST_ASSERT( getcwd( directory , sizeof( directory )) != NULL ) ;
+      std::string segmentName = std::string( directory ) + "/test_dirty_set.seg" ;
+
+      VMC_VirtualMemoryRoot::CreateRoot( 16 , 16 ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( segmentName.c_str( ) , 16 ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+
+      char value = '$' ;
+      pRoot->GetPageFrame( idSeg , 3 )->SetPageData( 3 , 1 , &value ) ;
+      pRoot->WriteAllPageFrames( true ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+      TST_ASSERT( pSegRoot->GetPageBytes( idSeg , 3 )[ 3 ] == '$' ) ;
+
+      pRoot->GetPageFrame( idSeg , 4 )->SetPageData( 3 , 1 , &value ) ;
+      pRoot->WriteAllPageFrames( ) ;
+      unlink( segmentName.c_str( )) ;
+
+      pRoot->WriteAllPageFrames( ) ;
+
+      bool isSyncFailed = false ;
+      try
+      {
+         pRoot->WriteAllPageFrames( true ) ;
+      }
+      catch ( EXC_Exception * pExc )
+      {
+         isSyncFailed = true ;
+         delete pExc ;
+      } /* end catch */
+
+      TST_ASSERT( isSyncFailed ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( "dirty" , NUM_PAGES ) ;
+
+      for ( int idPag = 0 ; idPag < NUM_PAGES ; idPag++ )
+      {
+         pRoot->GetPageFrame( idSeg , idPag ) ;
+      } /* for */
+
+   // Only the dirty frames are written
+
+      for ( int inxDirty = 0 ; inxDirty < NUM_DIRTY ; inxDirty++ )
+      {
+         char value = '#' ;
+         pRoot->GetPageFrame( idSeg , GetDirtyPage( inxDirty ))->SetPageData( 3 , 1 , &value ) ;
+      } /* for */
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == NUM_DIRTY ) ;
+
+      int numWritten = pSegRoot->GetTotalPagesWritten( ) ;
+      pRoot->WriteAllPageFrames( ) ;
+
+      TST_ASSERT( pSegRoot->GetTotalPagesWritten( ) - numWritten == NUM_DIRTY ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+      TST_ASSERT( IsLogged( "Flush: pages written 5 in 5 runs" )) ;
+
+      for ( int inxDirty = 0 ; inxDirty < NUM_DIRTY ; inxDirty++ )
+      {
+         TST_ASSERT( pSegRoot->GetPageBytes( idSeg , GetDirtyPage( inxDirty ))[ 3 ] == '#' ) ;
+      } /* for */
+
+   // Writing again finds nothing to write
+
+      pRoot->WriteAllPageFrames( ) ;
+      TST_ASSERT( pSegRoot->GetTotalPagesWritten( ) - numWritten == NUM_DIRTY ) ;
+
+   // A segment opened for reading refuses changes
+
+      pRoot->RemoveSegment( idSeg ) ;
+      int idReadSeg = pSegRoot->OpenSegment( "readonly" , 8 , TAL_OpeningModeRead ) ;
+      VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idReadSeg , 2 ) ;
+
+      char value = '#' ;
+      pPageFrame->SetPageData( 3 , 1 , &value , TAL_IGNORABLE_CHANGE ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+
+      bool isRefused = false ;
+      try
+      {
+         pPageFrame->SetPageData( 3 , 1 , &value ) ;
+      }
+      catch ( EXC_Exception * pExc )
+      {
+         isRefused = true ;
+         delete pExc ;
+      } /* end catch */
+
+      TST_ASSERT( isRefused ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+
+      TestSync( ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_dirty_set: passed\n" ) ;
+      return 0 ;
+   }
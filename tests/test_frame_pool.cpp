@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMR  Frame pool
+//
+//  A pool started below its maximum must grow when a page evicted
+//  recently misses again, and must release clean frames that are not
+//  pinned down to its minimum. Pinned and dirty frames keep their pages.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int MIN_FRAMES = 8 ;
+   static const int MAX_FRAMES = 16 ;
+   static const int NUM_PAGES  = 64 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void ReadPages( int idSeg , int idFirst , int idLimit )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      for ( int idPag = idFirst ; idPag < idLimit ; idPag++ )
+      {
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         TST_ASSERT( pValue[ 5 ] == SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 5 )) ;
+      } /* for */
+   }
+
+   static bool IsLogged( const char * pText )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+      return FAK_LogText.find( pText ) != std::string::npos ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( MIN_FRAMES , MAX_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "pool" , NUM_PAGES ) ;
+
+      TST_ASSERT( IsLogged( "Frame pool: frames 8, min 8, max 16, grown 0, released 0" )) ;
+
+   // Pages evicted by a full pool grow it when they miss again
+
+      ReadPages( idSeg , 0 , MIN_FRAMES ) ;
+      ReadPages( idSeg , MIN_FRAMES , 2 * MIN_FRAMES ) ;
+      TST_ASSERT( !pRoot->IsPageInMemory( idSeg , 0 )) ;
+      TST_ASSERT( IsLogged( "Frame pool: frames 8, min 8, max 16, grown 0, released 0" )) ;
+
+      ReadPages( idSeg , 0 , MIN_FRAMES ) ;
+      TST_ASSERT( IsLogged( "Frame pool: frames 16, min 8, max 16, grown 8, released 0" )) ;
+
+      for ( int idPag = 0 ; idPag < 2 * MIN_FRAMES ; idPag++ )
+      {
+         TST_ASSERT( pRoot->IsPageInMemory( idSeg , idPag )) ;
+      } /* for */
+
+   // The pool never grows past its maximum
+
+      ReadPages( idSeg , 2 * MIN_FRAMES , NUM_PAGES ) ;
+      ReadPages( idSeg , 0 , NUM_PAGES ) ;
+      TST_ASSERT( pRoot->GetNumPageFrames( ) == MAX_FRAMES ) ;
+
+   // Release clean frames, keeping a pinned and a dirty one
+
+      VMC_PageFrame * pPinned = pRoot->GetPageFrame( idSeg , 1 ) ;
+      pPinned->PinFrame( ) ;
+
+      char value = '#' ;
+      pRoot->GetPageFrame( idSeg , 2 )->SetPageData( 7 , 1 , &value ) ;
+
+      TST_ASSERT( pRoot->ReleaseFrames( MAX_FRAMES ) == MAX_FRAMES - MIN_FRAMES ) ;
+      TST_ASSERT( IsLogged( "Frame pool: frames 8, min 8, max 16, grown 8, released 8" )) ;
+      TST_ASSERT( pRoot->ReleaseFrames( 1 ) == 0 ) ;
+
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 1 )) ;
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 2 )) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 1 ) ;
+      TST_ASSERT( pRoot->GetPageFrame( idSeg , 2 )->GetPageValue( )[ 7 ] == '#' ) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+      pPinned->UnpinFrame( ) ;
+
+   // Released frames are reused when the pool grows again
+
+      ReadPages( idSeg , NUM_PAGES - 2 * MIN_FRAMES , NUM_PAGES ) ;
+      ReadPages( idSeg , NUM_PAGES - 2 * MIN_FRAMES , NUM_PAGES - MIN_FRAMES ) ;
+      TST_ASSERT( IsLogged( "Frame pool: frames 16, min 8, max 16, grown 16, released 8" )) ;
+      TST_ASSERT( pRoot->GetPageFrame( idSeg , 2 )->GetPageValue( )[ 7 ] == '#' ) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_frame_pool: passed\n" ) ;
+      return 0 ;
+   }
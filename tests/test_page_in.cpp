@@ -0,0 +1,175 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMI  Page in threads
+//
+//  Batches of pages are read asynchronously by a pool of threads, from
+//  a segment kept in memory and from a segment file in direct I/O mode.
+//  Every page must arrive with its value, a failed read must be
+//  reported by the wait, and no two calls may be in the segment module
+//  at once. A segment file with a header is neither mapped nor set to
+//  direct I/O, its pages are read through the segment module.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <unistd.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "exceptn.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES  = 32 ;
+   static const int NUM_PAGES   = 256 ;
+   static const int NUM_BATCH   = 8 ;
+   static const int NUM_THREADS = 4 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void ReadBatches( int idSeg )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+
+      srand( 11 ) ;
+      for ( int inxRound = 0 ; inxRound < 64 ; inxRound++ )
+      {
+         int vtIdPag[ NUM_BATCH ] ;
+         for ( int inxBatch = 0 ; inxBatch < NUM_BATCH ; inxBatch++ )
+         {
+            vtIdPag[ inxBatch ] = rand( ) % NUM_PAGES ;
+            pRoot->GetPageFrameAsync( idSeg , vtIdPag[ inxBatch ] ) ;
+         } /* for */
+
+         for ( int inxBatch = 0 ; inxBatch < NUM_BATCH ; inxBatch++ )
+         {
+            int idPag = vtIdPag[ inxBatch ] ;
+            VMC_PageFrame * pPageFrame = pRoot->WaitPageFrame( idSeg , idPag ) ;
+            for ( int inxByte = 0 ; inxByte < TAL_PageSize ; inxByte += 97 )
+            {
+               TST_ASSERT( pPageFrame->GetPageValue( )[ inxByte ] ==
+                           SEG_SegmentRoot::GetInitialByte( idSeg , idPag , inxByte )) ;
+            } /* for */
+            pPageFrame->UnpinFrame( ) ;
+         } /* for */
+      } /* for */
+   }
+
+   static void TestPageIn( const char * pName , bool isDirect )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( pName , NUM_PAGES ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+      pSegRoot->SetTransferDelay( 50 ) ;
+
+      if ( isDirect )
+      {
+         TST_ASSERT( pRoot->SetDirectIo( idSeg , true )) ;
+      } /* if */
+
+      pRoot->StartPageInThreads( NUM_THREADS ) ;
+      ReadBatches( idSeg ) ;
+
+   // A failed read is reported by the wait, the page is read again by
+   // the next access
+
+      int idPag = NUM_PAGES - 1 ;
+      while ( pRoot->IsPageInMemory( idSeg , idPag ))
+      {
+         idPag -- ;
+      } /* while */
+
+      pSegRoot->SetReadFailing( idSeg , true ) ;
+      if ( isDirect )
+      {
+         pRoot->SetDirectIo( idSeg , false ) ;
+      } /* if */
+
+      bool isFailed = false ;
+      pRoot->GetPageFrameAsync( idSeg , idPag ) ;
+      try
+      {
+         pRoot->WaitPageFrame( idSeg , idPag ) ;
+      }
+      catch ( EXC_Exception * pExc )
+      {
+         isFailed = true ;
+         delete pExc ;
+      } /* end catch */
+
+      TST_ASSERT( isFailed ) ;
+      pSegRoot->SetReadFailing( idSeg , false ) ;
+
+      VMC_PageFrame * pPageFrame = pRoot->WaitPageFrame( idSeg , idPag ) ;
+      TST_ASSERT( pPageFrame->GetPageValue( )[ 0 ] ==
+                  SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 0 )) ;
+      pPageFrame->UnpinFrame( ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( FAK_LogText.find( "Page in: threads 4" ) != std::string::npos ) ;
+
+      pRoot->StopPageInThreads( ) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      TST_ASSERT( pRoot->VerifyOpenPages( TAL_VerifyLog ) == 0 ) ;
+      TST_ASSERT( pRoot->GetNumPinnedFrames( ) == 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   static void TestFileLayout( const char * pName , long fileOffset )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( pName , NUM_PAGES ,
+                TAL_OpeningModeWrite , fileOffset ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+
+      bool isPlain = ( fileOffset == 0 ) ;
+      TST_ASSERT( pRoot->SetDirectIo( idSeg , true ) == isPlain ) ;
+      TST_ASSERT( !pRoot->SetDirectIo( idSeg , false )) ;
+      TST_ASSERT( pRoot->MapSegment( idSeg ) == isPlain ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( ( FAK_LogText.find( "Mapped segments: 1" ) != std::string::npos ) ==
+                  isPlain ) ;
+
+      for ( int idPag = 0 ; idPag < NUM_PAGES ; idPag += NUM_PAGES / 8 )
+      {
+         VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idSeg , idPag ) ;
+         TST_ASSERT( pPageFrame->GetPageValue( )[ 0 ] ==
+                     SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 0 )) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      char directory[ 1024 ] ;
+      TST_ASSERT( getcwd( directory , sizeof( directory )) != NULL ) ;
+      std::string fileName = std::string( directory ) + "/test_page_in.seg" ;
+
+      TestPageIn( "pagein" , false ) ;
+      TestPageIn( fileName.c_str( ) , true ) ;
+      unlink( fileName.c_str( )) ;
+
+      TestFileLayout( fileName.c_str( ) , 0 ) ;
+      unlink( fileName.c_str( )) ;
+      TestFileLayout( fileName.c_str( ) , TAL_PageSize ) ;
+      unlink( fileName.c_str( )) ;
+
+      TST_ASSERT( FAK_NumOverlaps == 0 ) ;
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_page_in: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMR  Virtual page sizes
+//
+//  A virtual page spans consecutive segment pages: it must be read from
+//  them, and written back to them, at every page size. An overrun of
+//  the page values at either end of the frame arena must be found
+//  whatever their size.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <string.h>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES    = 8 ;
+   static const int SEGMENT_PAGES = 1024 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void TestPageSize( int numSegmentPages )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , VMC_REPLACE_LRU ,
+                                         VMC_ARENA_BASE_PAGES ,
+                                         numSegmentPages * TAL_PageSize ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( "pagesize" , SEGMENT_PAGES ) ;
+
+      TST_ASSERT( pRoot->GetPageSize( ) == numSegmentPages * TAL_PageSize ) ;
+
+      int numPages = SEGMENT_PAGES / numSegmentPages ;
+      for ( int idPag = 0 ; idPag < numPages ; idPag++ )
+      {
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         for ( int inxPart = 0 ; inxPart < numSegmentPages ; inxPart++ )
+         {
+            int idSegmentPage = idPag * numSegmentPages + inxPart ;
+            TST_ASSERT( pValue[ inxPart * TAL_PageSize + 5 ] ==
+                        SEG_SegmentRoot::GetInitialByte( idSeg , idSegmentPage , 5 )) ;
+         } /* for */
+      } /* for */
+
+   // Change the last byte of every segment page of one virtual page
+
+      VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idSeg , 1 ) ;
+      for ( int inxPart = 0 ; inxPart < numSegmentPages ; inxPart++ )
+      {
+         char value = static_cast< char >( 'a' + inxPart % 26 ) ;
+         pPageFrame->SetPageData( ( inxPart + 1 ) * TAL_PageSize - 1 , 1 , &value ) ;
+      } /* for */
+      pRoot->WriteAllPageFrames( ) ;
+
+      for ( int inxPart = 0 ; inxPart < numSegmentPages ; inxPart++ )
+      {
+         const char * pBytes = pSegRoot->GetPageBytes( idSeg , numSegmentPages + inxPart ) ;
+         TST_ASSERT( pBytes[ TAL_PageSize - 1 ] == 'a' + inxPart % 26 ) ;
+         TST_ASSERT( pBytes[ 0 ] ==
+                     SEG_SegmentRoot::GetInitialByte( idSeg , numSegmentPages + inxPart , 0 )) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+   // A write just before the first or just past the last page value of
+   // the arena is found by the frame verification
+
+   #ifndef VMC_RELEASE
+      for ( int idPag = 0 ; idPag < numPages ; idPag++ )
+      {
+         pPageFrame = pRoot->GetPageFrame( idSeg , idPag ) ;
+         char * pOverrun = NULL ;
+         int idCode = 0 ;
+
+         if ( pPageFrame->GetInxPageFrameElem( ) == 0 )
+         {
+            pOverrun = pPageFrame->GetPageValue( ) - 1 ;
+            idCode   = 50 ;
+         } else if ( pPageFrame->GetInxPageFrameElem( ) == NUM_FRAMES - 1 )
+         {
+            pOverrun = pPageFrame->GetPageValue( ) + pRoot->GetPageSize( ) ;
+            idCode   = 51 ;
+         } /* if */
+
+         if ( pOverrun != NULL )
+         {
+            char saved = *pOverrun ;
+            *pOverrun = 'X' ;
+            TST_ASSERT( pPageFrame->VerifyPageFrame( TAL_VerifyLog ) == 1 ) ;
+            TST_ASSERT( FAK_LastLoggedCode == idCode ) ;
+            *pOverrun = saved ;
+            FAK_NumLoggedErrors = 0 ;
+         } /* if */
+      } /* for */
+   #endif
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      for ( int numSegmentPages = 1 ; numSegmentPages <= 64 ; numSegmentPages *= 2 )
+      {
+         TestPageSize( numSegmentPages ) ;
+      } /* for */
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_page_size: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMR  Page table and direct page maps
+//
+//  The pages of a segment small enough are registered in its direct
+//  page map, those of larger segments in the page table. A map growing
+//  past its limit returns the pages of its segment to the page table.
+//  Removing a segment must free exactly its frames whichever way its
+//  pages are registered. Removing entries from probe chains that wrap
+//  past the end of the page table, and rehashing the table when the
+//  pool grows, must keep every resident page reachable. A page evicted
+//  must never be found through a stale lookaside entry once its frame
+//  holds another page.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 8 ;
+
+// Largest direct page map of a root of NUM_FRAMES frames
+
+   static const int MAX_MAP_PAGES = 1024 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void ReadPages( int idSeg , int idFirst , int idLimit )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      for ( int idPag = idFirst ; idPag < idLimit ; idPag++ )
+      {
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         TST_ASSERT( pValue[ 11 ] == SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 11 )) ;
+      } /* for */
+   }
+
+   // Home slot of a page in a page table of numSlots slots, as computed
+   // by the root
+
+   static int ComputeHomeSlot( int idSeg , int idPag , int numSlots )
+   {
+      unsigned long long key = ( static_cast< unsigned long long >( idSeg ) << 32 )
+                             | static_cast< unsigned int >( idPag ) ;
+
+      key ^= key >> 33 ;
+      key *= 0xff51afd7ed558ccdULL ;
+      key ^= key >> 33 ;
+      key *= 0xc4ceb9fe1a85ec53ULL ;
+      key ^= key >> 33 ;
+
+      return static_cast< int >( key & ( numSlots - 1 )) ;
+   }
+
+   // Stores in vtIdPag the first numPages pages whose home slot is in
+   // [ inxFirstSlot , inxLastSlot ]
+
+   static void SelectPages( int idSeg , int inxFirstSlot , int inxLastSlot , int numSlots ,
+                            int numPages , int * vtIdPag )
+   {
+      int numSelected = 0 ;
+      for ( int idPag = 0 ; numPages > 0 ; idPag++ )
+      {
+         int inxHome = ComputeHomeSlot( idSeg , idPag , numSlots ) ;
+         if ( ( inxHome >= inxFirstSlot ) && ( inxHome <= inxLastSlot ))
+         {
+            vtIdPag[ numSelected ++ ] = idPag ;
+            numPages -- ;
+         } /* if */
+      } /* for */
+   }
+
+   static void GetTableCounters( int * pNumUsed , int * pNumEntries , int * pNumDirectMaps ,
+                                 int * pNumSlots = NULL , int * pMaxProbe = NULL )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+
+      size_t inxLine = FAK_LogText.find( "Page size" ) ;
+      TST_ASSERT( inxLine != std::string::npos ) ;
+      int pageSize , numFrames ;
+      TST_ASSERT( sscanf( FAK_LogText.c_str( ) + inxLine , "Page size %d  frames %d  used %d" ,
+                          &pageSize , &numFrames , pNumUsed ) == 3 ) ;
+
+      inxLine = FAK_LogText.find( "Page table:" ) ;
+      TST_ASSERT( inxLine != std::string::npos ) ;
+      int numSlots , maxProbe ;
+      double meanProbe ;
+      TST_ASSERT( sscanf( FAK_LogText.c_str( ) + inxLine ,
+                          "Page table: slots %d, entries %d, probe length max %d mean %lf, direct maps %d" ,
+                          &numSlots , pNumEntries , &maxProbe , &meanProbe , pNumDirectMaps ) == 5 ) ;
+
+      if ( pNumSlots != NULL )
+      {
+         *pNumSlots = numSlots ;
+      } /* if */
+      if ( pMaxProbe != NULL )
+      {
+         *pMaxProbe = maxProbe ;
+      } /* if */
+   }
+
+   static int GetLookasideHits( )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+
+      size_t inxLine = FAK_LogText.find( "Lookaside:" ) ;
+      TST_ASSERT( inxLine != std::string::npos ) ;
+      int numSearches , numHits ;
+      TST_ASSERT( sscanf( FAK_LogText.c_str( ) + inxLine , "Lookaside: searches %d, hits %d" ,
+                          &numSearches , &numHits ) == 2 ) ;
+      return numHits ;
+   }
+
+   static void CheckCounters( int numUsed , int numEntries , int numDirectMaps )
+   {
+      int numUsedFound , numEntriesFound , numDirectMapsFound ;
+      GetTableCounters( &numUsedFound , &numEntriesFound , &numDirectMapsFound ) ;
+      TST_ASSERT( numUsedFound == numUsed ) ;
+      TST_ASSERT( numEntriesFound == numEntries ) ;
+      TST_ASSERT( numDirectMapsFound == numDirectMaps ) ;
+      TST_ASSERT( VMC_VirtualMemoryRoot::GetRoot( )->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+   }
+
+   // A dense segment uses its direct page map, a segment larger than
+   // the largest map uses the page table
+
+   static void TestSegmentSizes( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+
+      int idDense = pSegRoot->OpenSegment( "dense" , 200 ) ;
+      ReadPages( idDense , 0 , 200 ) ;
+      ReadPages( idDense , 190 , 200 ) ;
+      CheckCounters( NUM_FRAMES , 0 , 1 ) ;
+
+      int idLarge = pSegRoot->OpenSegment( "large" , 2 * MAX_MAP_PAGES ) ;
+      ReadPages( idLarge , MAX_MAP_PAGES , MAX_MAP_PAGES + NUM_FRAMES / 2 ) ;
+      ReadPages( idLarge , 2 * MAX_MAP_PAGES - NUM_FRAMES / 2 , 2 * MAX_MAP_PAGES ) ;
+      CheckCounters( NUM_FRAMES , NUM_FRAMES , 1 ) ;
+
+      for ( int idPag = 2 * MAX_MAP_PAGES - NUM_FRAMES / 2 ; idPag < 2 * MAX_MAP_PAGES ; idPag++ )
+      {
+         TST_ASSERT( pRoot->IsPageInMemory( idLarge , idPag )) ;
+      } /* for */
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   // Pages added past the largest map return the pages of the segment
+   // to the page table
+
+   static void TestMapOverflow( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+
+      int numPages = MAX_MAP_PAGES - NUM_FRAMES ;
+      int idSeg = pSegRoot->OpenSegment( "growing" , numPages ) ;
+      ReadPages( idSeg , numPages - NUM_FRAMES , numPages ) ;
+      CheckCounters( NUM_FRAMES , 0 , 1 ) ;
+
+   // Pages up to the limit keep the map
+
+      while ( numPages < MAX_MAP_PAGES )
+      {
+         TST_ASSERT( pRoot->AddNewPage( idSeg )->GetIdPag( ) == numPages ) ;
+         numPages ++ ;
+      } /* while */
+      CheckCounters( NUM_FRAMES , 0 , 1 ) ;
+
+   // The first page past the limit moves every page to the page table
+
+      TST_ASSERT( pRoot->AddNewPage( idSeg )->GetIdPag( ) == MAX_MAP_PAGES ) ;
+      numPages ++ ;
+      CheckCounters( NUM_FRAMES , NUM_FRAMES , 0 ) ;
+      TST_ASSERT( pSegRoot->GetSegmentNumPages( idSeg ) == numPages ) ;
+
+      for ( int idPag = numPages - NUM_FRAMES ; idPag < numPages ; idPag++ )
+      {
+         TST_ASSERT( pRoot->IsPageInMemory( idSeg , idPag )) ;
+      } /* for */
+
+      ReadPages( idSeg , 0 , 2 * NUM_FRAMES ) ;
+      CheckCounters( NUM_FRAMES , NUM_FRAMES , 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   // Removing a segment frees its frames and keeps those of another one
+
+   static void TestRemoveSegment( bool isDirect )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      pRoot->SetDirectPageMaps( isDirect ) ;
+
+      int idRemoved = pSegRoot->OpenSegment( "removed" , 100 ) ;
+      int idKept    = pSegRoot->OpenSegment( "kept" , 100 ) ;
+
+      ReadPages( idRemoved , 0 , NUM_FRAMES / 2 ) ;
+      ReadPages( idKept , 0 , NUM_FRAMES / 2 ) ;
+      CheckCounters( NUM_FRAMES , isDirect ? 0 : NUM_FRAMES , isDirect ? 2 : 0 ) ;
+
+      pRoot->RemoveSegment( idRemoved ) ;
+      CheckCounters( NUM_FRAMES / 2 , isDirect ? 0 : NUM_FRAMES / 2 , isDirect ? 1 : 0 ) ;
+
+      for ( int idPag = 0 ; idPag < NUM_FRAMES / 2 ; idPag++ )
+      {
+         TST_ASSERT( pRoot->IsPageInMemory( idKept , idPag )) ;
+      } /* for */
+      CheckCounters( NUM_FRAMES / 2 , isDirect ? 0 : NUM_FRAMES / 2 , isDirect ? 1 : 0 ) ;
+
+   // Turning the maps off moves the pages of the kept segment to the
+   // page table
+
+      pRoot->SetDirectPageMaps( false ) ;
+      CheckCounters( NUM_FRAMES / 2 , NUM_FRAMES / 2 , 0 ) ;
+      ReadPages( idKept , 0 , NUM_FRAMES / 2 ) ;
+
+      pRoot->RemoveSegment( idKept ) ;
+      CheckCounters( 0 , 0 , 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   // Entries are removed from probe chains wrapping past the last slot
+   // while the pages of the chains are evicted one by one. The pool is
+   // full, hence IsPageInMemory finds pages without loading them.
+
+   static void TestProbeChains( )
+   {
+      const int numSlots = 2 * NUM_FRAMES ;
+      const int numPages = 20 ;
+
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , 2 * NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      pRoot->SetDirectPageMaps( false ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "chains" , 1 << 16 ) ;
+
+   // Pages homed at the last three slots wrap into the first ones,
+   // where pages homed at the first two slots collide with them
+
+      int vtHighIdPag[ 12 ] ;
+      int vtLowIdPag[ 8 ] ;
+      SelectPages( idSeg , numSlots - 3 , numSlots - 1 , numSlots , 12 , vtHighIdPag ) ;
+      SelectPages( idSeg , 0 , 1 , numSlots , 8 , vtLowIdPag ) ;
+
+      int vtIdPag[ numPages ] ;
+      int numSelected = 0 ;
+      for ( int inxHalf = 0 ; inxHalf < 2 ; inxHalf++ )
+      {
+         for ( int inxHigh = 0 ; inxHigh < 6 ; inxHigh++ )
+         {
+            vtIdPag[ numSelected ++ ] = vtHighIdPag[ 6 * inxHalf + inxHigh ] ;
+         } /* for */
+         for ( int inxLow = 0 ; inxLow < 4 ; inxLow++ )
+         {
+            vtIdPag[ numSelected ++ ] = vtLowIdPag[ 4 * inxHalf + inxLow ] ;
+         } /* for */
+      } /* for */
+      TST_ASSERT( numSelected == numPages ) ;
+
+      for ( int inxPage = 0 ; inxPage < numPages ; inxPage++ )
+      {
+         ReadPages( idSeg , vtIdPag[ inxPage ] , vtIdPag[ inxPage ] + 1 ) ;
+         if ( inxPage < NUM_FRAMES - 1 )
+         {
+            continue ;
+         } /* if */
+
+         int numUsed , numEntries , numDirectMaps , numSlotsFound , maxProbe ;
+         GetTableCounters( &numUsed , &numEntries , &numDirectMaps , &numSlotsFound , &maxProbe ) ;
+         TST_ASSERT( numSlotsFound == numSlots ) ;
+         TST_ASSERT( numEntries == NUM_FRAMES ) ;
+         TST_ASSERT( maxProbe >= 4 ) ;
+         TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+         for ( int inxResident = inxPage - NUM_FRAMES + 1 ; inxResident <= inxPage ; inxResident++ )
+         {
+            TST_ASSERT( pRoot->IsPageInMemory( idSeg , vtIdPag[ inxResident ] )) ;
+         } /* for */
+      } /* for */
+
+   // A page evicted last misses again, the pool grows and the page
+   // table is rehashed into twice as many slots
+
+      int idEvicted = vtIdPag[ numPages - NUM_FRAMES - 1 ] ;
+      TST_ASSERT( !pRoot->IsPageInMemory( idSeg , idEvicted )) ;
+      ReadPages( idSeg , idEvicted , idEvicted + 1 ) ;
+
+      int numUsed , numEntries , numDirectMaps , numSlotsFound ;
+      GetTableCounters( &numUsed , &numEntries , &numDirectMaps , &numSlotsFound ) ;
+      TST_ASSERT( numSlotsFound == 2 * numSlots ) ;
+      TST_ASSERT( ( numUsed == NUM_FRAMES + 1 ) && ( numEntries == NUM_FRAMES + 1 )) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+      for ( int inxResident = numPages - NUM_FRAMES ; inxResident < numPages ; inxResident++ )
+      {
+         TST_ASSERT( pRoot->IsPageInMemory( idSeg , vtIdPag[ inxResident ] )) ;
+      } /* for */
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , idEvicted )) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   // Pages 0 and LOOKASIDE_SIZE share a lookaside entry. Each is found
+   // through the entry, then evicted and its frame reused by another
+   // page before it is accessed again.
+
+   static void TestLookaside( bool isDirect )
+   {
+      const int idAliased = 64 ;
+
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      pRoot->SetDirectPageMaps( isDirect ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "lookaside" , 200 ) ;
+
+      for ( int idFirst = 0 ; idFirst <= idAliased ; idFirst += idAliased )
+      {
+         ReadPages( idSeg , idFirst , idFirst + 1 ) ;
+         ReadPages( idSeg , idFirst , idFirst + 1 ) ;
+         int numHits = GetLookasideHits( ) ;
+         ReadPages( idSeg , idFirst , idFirst + 1 ) ;
+         TST_ASSERT( GetLookasideHits( ) == numHits + 1 ) ;
+
+      // The frame of the page is the first evicted, by the last page read
+
+         VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idSeg , idFirst ) ;
+         ReadPages( idSeg , 100 + idFirst , 100 + idFirst + NUM_FRAMES ) ;
+         TST_ASSERT( pPageFrame->GetIdPag( ) == 100 + idFirst + NUM_FRAMES - 1 ) ;
+
+         TST_ASSERT( !pRoot->IsPageInMemory( idSeg , 0 )) ;
+         TST_ASSERT( !pRoot->IsPageInMemory( idSeg , idAliased )) ;
+
+         VMC_PageFrame * pReadFrame = pRoot->GetPageFrame( idSeg , idFirst ) ;
+         TST_ASSERT( pReadFrame->GetIdPag( ) == idFirst ) ;
+         TST_ASSERT( pReadFrame->GetPageValue( )[ 11 ] ==
+                     SEG_SegmentRoot::GetInitialByte( idSeg , idFirst , 11 )) ;
+         TST_ASSERT( pPageFrame->GetIdPag( ) != idFirst ) ;
+         TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+         ReadPages( idSeg , 100 + idFirst , 100 + idFirst + NUM_FRAMES ) ;
+      } /* for */
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      TestSegmentSizes( ) ;
+      TestMapOverflow( ) ;
+      TestRemoveSegment( true ) ;
+      TestRemoveSegment( false ) ;
+      TestProbeChains( ) ;
+      TestLookaside( true ) ;
+      TestLookaside( false ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_page_table: passed\n" ) ;
+      return 0 ;
+   }
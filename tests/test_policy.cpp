@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMP  Replacement policies
+//
+//  Every policy must return the right page values, never evict a pinned
+//  frame, and keep the virtual memory verifiable. 2Q must keep a hot set
+//  across a scan that flushes it out of LRU and clock.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 16 ;
+   static const int NUM_PAGES  = 256 ;
+   static const int NUM_HOT    = 4 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static bool IsPageRight( VMC_PageFrame * pPageFrame , int idSeg , int idPag )
+   {
+      const char * pValue = pPageFrame->GetPageValue( ) ;
+      for ( int inxByte = 0 ; inxByte < TAL_PageSize ; inxByte++ )
+      {
+         if ( pValue[ inxByte ] != SEG_SegmentRoot::GetInitialByte( idSeg , idPag , inxByte ))
+         {
+            return false ;
+         } /* if */
+      } /* for */
+      return true ;
+   }
+
+   static int CountHotPagesKept( VMC_tpReplacementPolicy policy )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , policy ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "policy" , NUM_PAGES ) ;
+
+   // Warm the hot set: reference it, push it out through a filler of one
+   // memory full of pages, and reference it again
+
+      for ( int idPag = 0 ; idPag < NUM_HOT ; idPag++ )
+      {
+         TST_ASSERT( IsPageRight( pRoot->GetPageFrame( idSeg , idPag ) , idSeg , idPag )) ;
+      } /* for */
+      for ( int idPag = NUM_HOT ; idPag < NUM_HOT + NUM_FRAMES ; idPag++ )
+      {
+         TST_ASSERT( IsPageRight( pRoot->GetPageFrame( idSeg , idPag ) , idSeg , idPag )) ;
+      } /* for */
+      for ( int idPag = 0 ; idPag < NUM_HOT ; idPag++ )
+      {
+         TST_ASSERT( IsPageRight( pRoot->GetPageFrame( idSeg , idPag ) , idSeg , idPag )) ;
+      } /* for */
+
+   // Pin one page, then scan a segment much larger than memory
+
+      VMC_PageFrame * pPinned = pRoot->GetPageFrame( idSeg , NUM_PAGES - 1 ) ;
+      pPinned->PinFrame( ) ;
+
+      for ( int idPag = NUM_HOT + NUM_FRAMES ; idPag < NUM_PAGES - 1 ; idPag++ )
+      {
+         TST_ASSERT( IsPageRight( pRoot->GetPageFrame( idSeg , idPag ) , idSeg , idPag )) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , NUM_PAGES - 1 )) ;
+      TST_ASSERT( IsPageRight( pPinned , idSeg , NUM_PAGES - 1 )) ;
+      pPinned->UnpinFrame( ) ;
+
+      int numKept = 0 ;
+      for ( int idPag = 0 ; idPag < NUM_HOT ; idPag++ )
+      {
+         if ( pRoot->IsPageInMemory( idSeg , idPag ))
+         {
+            numKept ++ ;
+         } /* if */
+      } /* for */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      TST_ASSERT( pRoot->VerifyOpenPages( TAL_VerifyLog ) == 0 ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( ( FAK_LogText.find( "2Q: A1in frames" ) != std::string::npos ) ==
+                  ( policy == VMC_REPLACE_2Q )) ;
+      TST_ASSERT( FAK_LogText.find( "Page table: slots" ) != std::string::npos ) ;
+      TST_ASSERT( FAK_LogText.find( "Lookaside: searches" ) != std::string::npos ) ;
+      TST_ASSERT( FAK_LogText.find( "Frame arena: buffers" ) != std::string::npos ) ;
+      TST_ASSERT( FAK_LogText.find( "Frame pool: frames" ) != std::string::npos ) ;
+
+   // Removing the segment empties a pinned frame, which then no longer
+   // counts as pinned
+
+      pRoot->GetPageFrame( idSeg , 0 )->PinFrame( ) ;
+      pRoot->RemoveSegment( idSeg ) ;
+      TST_ASSERT( pRoot->GetNumPinnedFrames( ) == 0 ) ;
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+      return numKept ;
+   }
+
+   // The clock hand sweeps the frames in order: a page referenced again
+   // before the first sweep is not moved, unlike in LRU, and is the
+   // first victim once the sweep has reset every reference bit
+
+   static void TestClockHand( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , VMC_REPLACE_CLOCK ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "clock" , NUM_PAGES ) ;
+
+      for ( int idPag = 0 ; idPag < NUM_FRAMES ; idPag++ )
+      {
+         pRoot->GetPageFrame( idSeg , idPag ) ;
+      } /* for */
+      pRoot->GetPageFrame( idSeg , 0 ) ;
+
+      pRoot->GetPageFrame( idSeg , NUM_FRAMES ) ;
+      TST_ASSERT( !pRoot->IsPageInMemory( idSeg , 0 )) ;
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 1 )) ;
+
+   // Pages referenced since the sweep get their second chance
+
+      pRoot->GetPageFrame( idSeg , 1 ) ;
+      pRoot->GetPageFrame( idSeg , NUM_FRAMES + 1 ) ;
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 1 )) ;
+      TST_ASSERT( !pRoot->IsPageInMemory( idSeg , 2 )) ;
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      TST_ASSERT( CountHotPagesKept( VMC_REPLACE_LRU ) == 0 ) ;
+      TST_ASSERT( CountHotPagesKept( VMC_REPLACE_CLOCK ) == 0 ) ;
+      TestClockHand( ) ;
+      TST_ASSERT( CountHotPagesKept( VMC_REPLACE_2Q ) == NUM_HOT ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_policy: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMR  Read ahead
+//
+//  Sequential and strided accesses must be read ahead, the window must
+//  grow while the pages read ahead are used. Pages read ahead enter LRU
+//  at its tail, hence they are evicted before the pages accessed, and
+//  count as wasted if they are evicted unused.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <stdio.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES     = 256 ;
+   static const int NUM_PAGES      = 1024 ;
+   static const int MAX_READ_AHEAD = 16 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void GetReadAheadCounters( int * pNumRead , int * pNumHits , int * pNumWasted )
+   {
+      FAK_LogText.clear( ) ;
+      VMC_VirtualMemoryRoot::GetRoot( )->DisplayStatistics( ) ;
+
+      size_t inxLine = FAK_LogText.find( "Read ahead:" ) ;
+      TST_ASSERT( inxLine != std::string::npos ) ;
+
+      int maxWindow = 0 ;
+      TST_ASSERT( sscanf( FAK_LogText.c_str( ) + inxLine ,
+                          "Read ahead: max window %d, pages read %d, hits %d, wasted %d" ,
+                          &maxWindow , pNumRead , pNumHits , pNumWasted ) == 4 ) ;
+      TST_ASSERT( maxWindow == MAX_READ_AHEAD ) ;
+   }
+
+   // Reads from page 0 at the stride. The pages read ahead and not yet
+   // accessed, the window, must start at its minimum and grow to the
+   // largest allowed. Every other page read is a page accessed.
+
+   static void TestStride( int stride , int numAccesses )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( "readahead" , NUM_PAGES ) ;
+      pRoot->SetReadAhead( MAX_READ_AHEAD ) ;
+
+      int numFirstAhead = 0 ;
+      int numLastAhead  = 0 ;
+      int numLastHits   = 0 ;
+
+      for ( int inxAccess = 0 ; inxAccess < numAccesses ; inxAccess++ )
+      {
+         int idPag = inxAccess * stride ;
+         const char * pValue = pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         TST_ASSERT( pValue[ 9 ] == SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 9 )) ;
+
+         int numRead , numHits , numWasted ;
+         GetReadAheadCounters( &numRead , &numHits , &numWasted ) ;
+         TST_ASSERT( numWasted == 0 ) ;
+         TST_ASSERT( numHits >= numLastHits ) ;
+         TST_ASSERT( pSegRoot->GetTotalPagesRead( ) == inxAccess + 1 - numHits + numRead ) ;
+
+         int numAhead = numRead - numHits ;
+         TST_ASSERT( numAhead >= numLastAhead ) ;
+         if ( numFirstAhead == 0 )
+         {
+            numFirstAhead = numAhead ;
+         } /* if */
+
+         numLastAhead = numAhead ;
+         numLastHits  = numHits ;
+      } /* for */
+
+      TST_ASSERT( numFirstAhead == 2 ) ;
+      TST_ASSERT( numLastAhead == MAX_READ_AHEAD ) ;
+      TST_ASSERT( numLastHits >= numAccesses - 3 ) ;
+
+   // The pages between the strides have not been read
+
+      if ( stride > 1 )
+      {
+         TST_ASSERT( pSegRoot->GetTotalPagesRead( ) == numAccesses + MAX_READ_AHEAD ) ;
+      } /* if */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   // Pages read ahead and never used are evicted before older pages
+   // that were accessed
+
+   static void TestColdEntry( )
+   {
+      const int numFrames = 16 ;
+
+      VMC_VirtualMemoryRoot::CreateRoot( numFrames , numFrames ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment( "coldentry" , NUM_PAGES ) ;
+
+      pRoot->GetPageFrame( idSeg , 500 ) ;
+
+   // Pages 0 and 1 are two accesses at stride 1, pages 2 and 3 are read
+   // ahead
+
+      pRoot->SetReadAhead( MAX_READ_AHEAD ) ;
+      pRoot->GetPageFrame( idSeg , 0 ) ;
+      pRoot->GetPageFrame( idSeg , 1 ) ;
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 2 )) ;
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 3 )) ;
+
+   // Fill the free frames at growing strides, which are not read ahead.
+   // The next two misses evict the pages read ahead, not the older page
+   // accessed.
+
+      int numFree = numFrames - 5 ;
+      int numMisses = 0 ;
+      while ( pRoot->IsPageInMemory( idSeg , 500 )
+           && ( pRoot->IsPageInMemory( idSeg , 2 )
+             || pRoot->IsPageInMemory( idSeg , 3 )))
+      {
+         pRoot->GetPageFrame( idSeg , 600 + numMisses * ( numMisses + 1 )) ;
+         numMisses ++ ;
+      } /* while */
+
+      TST_ASSERT( pRoot->IsPageInMemory( idSeg , 500 )) ;
+      TST_ASSERT( numMisses == numFree + 2 ) ;
+
+      int numRead , numHits , numWasted ;
+      GetReadAheadCounters( &numRead , &numHits , &numWasted ) ;
+      TST_ASSERT( ( numRead == 2 ) && ( numHits == 0 ) && ( numWasted == 2 )) ;
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      TestStride( 1 , 200 ) ;
+      TestStride( 3 , 100 ) ;
+      TestColdEntry( ) ;
+
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_read_ahead: passed\n" ) ;
+      return 0 ;
+   }
@@ -0,0 +1,221 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VML  Redo log
+//
+//  A child process logs and commits changes and exits without writing
+//  its pages. Opening the log must redo the changes, write the pages and
+//  empty the log. A record that cannot be redone must leave the log as
+//  it is, and a checkpoint that cannot sync a segment written must keep
+//  the log.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <sys/stat.h>
+   #include  <sys/wait.h>
+   #include  <unistd.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "exceptn.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES = 16 ;
+   static const int NUM_PAGES  = 64 ;
+   static const int NUM_CHANGES = 8 ;
+
+   static std::string segmentName ;
+   static std::string logName ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static char GetChangedByte( int inxChange )
+   {
+      return static_cast< char >( 'a' + inxChange ) ;
+   }
+
+   static int GetChangedPage( int inxChange )
+   {
+      return ( inxChange * 5 ) % NUM_PAGES ;
+   }
+
+   static long long GetFileSize( const std::string & fileName )
+   {
+      struct stat fileStat ;
+      TST_ASSERT( stat( fileName.c_str( ) , &fileStat ) == 0 ) ;
+      return fileStat.st_size ;
+   }
+
+   static int OpenRoot( )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      int idSeg = SEG_SegmentRoot::GetRoot( )->OpenSegment(
+                segmentName.c_str( ) , NUM_PAGES ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+      return idSeg ;
+   }
+
+   static void CheckChanges( int idSeg , bool isInFile )
+   {
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      for ( int inxChange = 0 ; inxChange < NUM_CHANGES ; inxChange++ )
+      {
+         int idPag = GetChangedPage( inxChange ) ;
+         char * pValue = isInFile ?
+                   SEG_SegmentRoot::GetRoot( )->GetPageBytes( idSeg , idPag ) :
+                   pRoot->GetPageFrame( idSeg , idPag )->GetPageValue( ) ;
+         TST_ASSERT( pValue[ 100 ] == GetChangedByte( inxChange )) ;
+         TST_ASSERT( pValue[ 101 ] ==
+                     SEG_SegmentRoot::GetInitialByte( idSeg , idPag , 101 )) ;
+      } /* for */
+   }
+
+   // Logs the changes and exits as a crash would, without writing pages
+
+   static void CrashAfterCommit( )
+   {
+      pid_t idChild = fork( ) ;
+      TST_ASSERT( idChild >= 0 ) ;
+
+      if ( idChild == 0 )
+      {
+         unlink( logName.c_str( )) ;
+         int idSeg = OpenRoot( ) ;
+         VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+         TST_ASSERT( pRoot->OpenLog( logName.c_str( ) , 0 ) == 0 ) ;
+
+         for ( int inxChange = 0 ; inxChange < NUM_CHANGES ; inxChange++ )
+         {
+            char value = GetChangedByte( inxChange ) ;
+            pRoot->GetPageFrame( idSeg , GetChangedPage( inxChange ))->
+                      SetPageData( 100 , 1 , &value ) ;
+         } /* for */
+
+         TST_ASSERT( pRoot->CommitLog( true )) ;
+         _exit( 0 ) ;
+      } /* if */
+
+      int status = 0 ;
+      TST_ASSERT( waitpid( idChild , &status , 0 ) == idChild ) ;
+      TST_ASSERT( WIFEXITED( status ) && ( WEXITSTATUS( status ) == 0 )) ;
+      TST_ASSERT( GetFileSize( logName ) > 0 ) ;
+   }
+
+   static void TestReplay( )
+   {
+      CrashAfterCommit( ) ;
+
+      int idSeg = OpenRoot( ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+
+      TST_ASSERT( pRoot->OpenLog( logName.c_str( ) , 0 ) == NUM_CHANGES ) ;
+      TST_ASSERT( GetFileSize( logName ) == 0 ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+      CheckChanges( idSeg , true ) ;
+
+      pRoot->CloseLog( ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   static void TestReplayFailure( )
+   {
+      CrashAfterCommit( ) ;
+      long long sizeLog = GetFileSize( logName ) ;
+
+      int idSeg = OpenRoot( ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot::GetRoot( )->SetReadFailing( idSeg , true ) ;
+
+      bool isFailed = false ;
+      try
+      {
+         pRoot->OpenLog( logName.c_str( ) , 0 ) ;
+      }
+      catch ( EXC_Exception * pExc )
+      {
+         isFailed = true ;
+         delete pExc ;
+      } /* end catch */
+
+      TST_ASSERT( isFailed ) ;
+      TST_ASSERT( GetFileSize( logName ) == sizeLog ) ;
+
+      int numRecords , numCommits , numSyncs , numCheckpoints ;
+      pRoot->GetLogCounters( &numRecords , &numCommits , &numSyncs ,
+                             &numCheckpoints ) ;
+      TST_ASSERT( numRecords == 0 ) ;
+
+   // The records are still there once the pages can be read
+
+      SEG_SegmentRoot::GetRoot( )->SetReadFailing( idSeg , false ) ;
+      TST_ASSERT( pRoot->OpenLog( logName.c_str( ) , 0 ) == NUM_CHANGES ) ;
+      TST_ASSERT( GetFileSize( logName ) == 0 ) ;
+      CheckChanges( idSeg , true ) ;
+
+      pRoot->CloseLog( ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   static void TestCheckpoint( )
+   {
+      unlink( logName.c_str( )) ;
+      int idSeg = OpenRoot( ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      TST_ASSERT( pRoot->OpenLog( logName.c_str( ) , 0 ) == 0 ) ;
+
+      for ( int inxChange = 0 ; inxChange < NUM_CHANGES ; inxChange++ )
+      {
+         char value = GetChangedByte( inxChange ) ;
+         pRoot->GetPageFrame( idSeg , GetChangedPage( inxChange ))->
+                   SetPageData( 100 , 1 , &value ) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->CommitLog( true )) ;
+      pRoot->WriteAllPageFrames( ) ;
+      long long sizeLog = GetFileSize( logName ) ;
+      TST_ASSERT( sizeLog > 0 ) ;
+
+   // A segment written that cannot be reopened is not synced, the log
+   // is kept
+
+      std::string movedName = segmentName + ".moved" ;
+      TST_ASSERT( rename( segmentName.c_str( ) , movedName.c_str( )) == 0 ) ;
+      TST_ASSERT( !pRoot->CheckpointLog( )) ;
+      TST_ASSERT( GetFileSize( logName ) == sizeLog ) ;
+
+      TST_ASSERT( rename( movedName.c_str( ) , segmentName.c_str( )) == 0 ) ;
+      TST_ASSERT( pRoot->CheckpointLog( )) ;
+      TST_ASSERT( GetFileSize( logName ) == 0 ) ;
+      CheckChanges( idSeg , true ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( FAK_LogText.find( "Redo log: records" ) != std::string::npos ) ;
+
+      pRoot->CloseLog( ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      char directory[ 1024 ] ;
+      TST_ASSERT( getcwd( directory , sizeof( directory )) != NULL ) ;
+      segmentName = std::string( directory ) + "/test_redo_log.seg" ;
+      logName     = std::string( directory ) + "/test_redo_log.log" ;
+
+      TestReplay( ) ;
+      TestReplayFailure( ) ;
+      TestCheckpoint( ) ;
+
+      unlink( segmentName.c_str( )) ;
+      unlink( logName.c_str( )) ;
+
+      TST_ASSERT( FAK_NumOverlaps == 0 ) ;
+      printf( "test_redo_log: passed\n" ) ;
+      return 0 ;
+   }
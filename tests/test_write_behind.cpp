@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////
+//
+//  Test module: VMW  Write behind, tail cleaner and dirty flusher
+//
+//  Random reads and changes run while the background threads write
+//  dirty frames. Every read must see the last change, every change must
+//  reach the segment, and no two calls may be in the segment module at
+//  once. Adjacent dirty pages of a segment in direct I/O mode must reach
+//  its file in one vectored write.
+//
+////////////////////////////////////////////////////////////////////////////
+
+   #include  <unistd.h>
+   #include  <string>
+
+   #include "VRTMEM.hpp"
+   #include "fake.hpp"
+
+   static const int NUM_FRAMES     = 16 ;
+   static const int NUM_PAGES      = 128 ;
+   static const int NUM_ACCESSES   = 10000 ;
+   static const int INX_CHANGED    = 8 ;
+
+//==========================================================================
+//----- Encapsulated functions -----
+//==========================================================================
+
+   static void RunAccesses( VMC_tpEvictionMode evictionMode , bool isCleaning )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES , VMC_REPLACE_CLOCK ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( "writebehind" , NUM_PAGES ) ;
+      pSegRoot->SetTransferDelay( 10 ) ;
+
+      pRoot->SetEvictionMode( evictionMode ) ;
+      if ( isCleaning )
+      {
+         pRoot->StartTailCleaner( NUM_FRAMES / 2 , 2 , 6 ) ;
+         pRoot->StartDirtyFlusher( 25 , 10 , 0 ) ;
+      } /* if */
+
+      char vtExpected[ NUM_PAGES ] ;
+      for ( int idPag = 0 ; idPag < NUM_PAGES ; idPag++ )
+      {
+         vtExpected[ idPag ] = SEG_SegmentRoot::GetInitialByte( idSeg , idPag , INX_CHANGED ) ;
+      } /* for */
+
+      srand( 5 ) ;
+      for ( int inxAccess = 0 ; inxAccess < NUM_ACCESSES ; inxAccess++ )
+      {
+         int idPag = rand( ) % NUM_PAGES ;
+         VMC_PageFrame * pPageFrame = pRoot->GetPageFrame( idSeg , idPag ) ;
+         TST_ASSERT( pPageFrame->GetPageValue( )[ INX_CHANGED ] == vtExpected[ idPag ] ) ;
+
+         if ( rand( ) % 3 == 0 )
+         {
+            vtExpected[ idPag ] = static_cast< char >( inxAccess ) ;
+            pPageFrame->SetPageData( INX_CHANGED , 1 , &vtExpected[ idPag ] ) ;
+         } /* if */
+      } /* for */
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( ( FAK_LogText.find( "Write behind: pages scheduled" ) != std::string::npos ) ==
+                  ( evictionMode == VMC_EVICT_CLEAN_FIRST )) ;
+      TST_ASSERT( ( FAK_LogText.find( "Tail cleaner: scans" ) != std::string::npos ) ==
+                  isCleaning ) ;
+      TST_ASSERT( ( FAK_LogText.find( "Flusher: passes" ) != std::string::npos ) ==
+                  isCleaning ) ;
+
+      pRoot->WriteAllPageFrames( ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+      pRoot->StopTailCleaner( ) ;
+      pRoot->StopDirtyFlusher( ) ;
+      pRoot->SetEvictionMode( VMC_EVICT_SYNCHRONOUS ) ;
+
+      for ( int idPag = 0 ; idPag < NUM_PAGES ; idPag++ )
+      {
+         TST_ASSERT( pSegRoot->GetPageBytes( idSeg , idPag )[ INX_CHANGED ] == vtExpected[ idPag ] ) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      TST_ASSERT( pRoot->VerifyOpenPages( TAL_VerifyLog ) == 0 ) ;
+
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+   static void WriteDirectRuns( const char * pName )
+   {
+      VMC_VirtualMemoryRoot::CreateRoot( NUM_FRAMES , NUM_FRAMES ) ;
+      VMC_VirtualMemoryRoot * pRoot = VMC_VirtualMemoryRoot::GetRoot( ) ;
+      SEG_SegmentRoot * pSegRoot = SEG_SegmentRoot::GetRoot( ) ;
+      int idSeg = pSegRoot->OpenSegment( pName , NUM_PAGES ) ;
+      TST_ASSERT( idSeg != TAL_NullIdSeg ) ;
+      TST_ASSERT( pRoot->SetDirectIo( idSeg , true )) ;
+
+   // Two runs of adjacent pages, one page apart
+
+      for ( int idPag = 0 ; idPag < NUM_FRAMES ; idPag++ )
+      {
+         if ( idPag != NUM_FRAMES / 2 )
+         {
+            char value = static_cast< char >( 'a' + idPag ) ;
+            pRoot->GetPageFrame( idSeg , idPag )->SetPageData( INX_CHANGED , 1 , &value ) ;
+         } /* if */
+      } /* for */
+
+      pRoot->WriteAllPageFrames( ) ;
+      TST_ASSERT( pRoot->GetNumDirtyFrames( ) == 0 ) ;
+
+      FAK_LogText.clear( ) ;
+      pRoot->DisplayStatistics( ) ;
+      TST_ASSERT( FAK_LogText.find( "pages written 15 in 2 runs" )
+                  != std::string::npos ) ;
+      TST_ASSERT( FAK_LogText.find( "written 15, fallbacks 0" )
+                  != std::string::npos ) ;
+
+      TST_ASSERT( !pRoot->SetDirectIo( idSeg , false )) ;
+      for ( int idPag = 0 ; idPag < NUM_FRAMES ; idPag++ )
+      {
+         char expected = ( idPag == NUM_FRAMES / 2 ) ?
+                   SEG_SegmentRoot::GetInitialByte( idSeg , idPag , INX_CHANGED ) :
+                   static_cast< char >( 'a' + idPag ) ;
+         TST_ASSERT( pSegRoot->GetPageBytes( idSeg , idPag )[ INX_CHANGED ] == expected ) ;
+      } /* for */
+
+      TST_ASSERT( pRoot->VerifyVirtualMemory( TAL_VerifyLog ) == 0 ) ;
+      VMC_VirtualMemoryRoot::DestroyRoot( ) ;
+   }
+
+//==========================================================================
+//----- Test driver -----
+//==========================================================================
+
+   int main( )
+   {
+      RunAccesses( VMC_EVICT_SYNCHRONOUS , false ) ;
+      RunAccesses( VMC_EVICT_CLEAN_FIRST , false ) ;
+      RunAccesses( VMC_EVICT_SYNCHRONOUS , true ) ;
+      RunAccesses( VMC_EVICT_CLEAN_FIRST , true ) ;
+
+      char directory[ 1024 ] ;
+      TST_ASSERT( getcwd( directory , sizeof( directory )) != NULL ) ;
+      std::string fileName = std::string( directory ) + "/test_write_behind.seg" ;
+      WriteDirectRuns( fileName.c_str( )) ;
+      unlink( fileName.c_str( )) ;
+
+      TST_ASSERT( FAK_NumOverlaps == 0 ) ;
+      TST_ASSERT( FAK_NumLoggedErrors == 0 ) ;
+      printf( "test_write_behind: passed\n" ) ;
+      return 0 ;
+   }